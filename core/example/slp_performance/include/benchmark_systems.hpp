@@ -0,0 +1,144 @@
+#pragma once
+
+#include <bertini2/system.hpp>
+#include <bertini2/io/parsing/system_parsers.hpp>
+
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <string>
+
+template<typename NumType> using Vec = Eigen::Matrix<NumType, Eigen::Dynamic, 1>;
+using dbl = bertini::dbl;
+using mpfr_complex = bertini::mpfr_complex;
+
+namespace demo{
+
+	/**
+	 A square system of random polynomials, each with `num_terms` terms of degree at most `degree`.  The same arguments always give the same system.
+	 */
+	inline bertini::System RandomPolynomialSystem(unsigned num_variables, unsigned degree, unsigned num_terms, unsigned seed = 42)
+	{
+		std::mt19937 generator(seed);
+		std::uniform_int_distribution<unsigned> which_variable(0, num_variables-1);
+		std::uniform_int_distribution<unsigned> how_many_factors(0, degree);
+		std::uniform_real_distribution<double> coefficient(-2, 2);
+
+		std::stringstream input;
+		input.precision(17);
+
+		input << "variable_group ";
+		for (unsigned ii = 0; ii < num_variables; ++ii)
+			input << (ii ? "," : "") << "x" << ii;
+		input << ";\nfunction ";
+		for (unsigned ii = 0; ii < num_variables; ++ii)
+			input << (ii ? "," : "") << "f" << ii;
+		input << ";\n";
+
+		for (unsigned ii = 0; ii < num_variables; ++ii)
+		{
+			input << "f" << ii << " = ";
+			for (unsigned jj = 0; jj < num_terms; ++jj)
+			{
+				input << (jj ? " + " : "") << "(" << coefficient(generator) << ")";
+				auto num_factors = how_many_factors(generator);
+				for (unsigned kk = 0; kk < num_factors; ++kk)
+					input << "*x" << which_variable(generator);
+			}
+			input << ";\n";
+		}
+
+		std::string str = input.str();
+		bertini::System sys;
+		bertini::parsing::classic::parse(str.begin(), str.end(), sys);
+		return sys;
+	}
+
+
+	/**
+	 A square system of dense polynomials, each having every monomial of total degree at most `degree`, with random coefficients, written with powers like x0^3*x1^2.  The same arguments always give the same system.
+	 */
+	inline bertini::System DensePolynomialSystem(unsigned num_variables, unsigned degree, unsigned seed = 42)
+	{
+		std::mt19937 generator(seed);
+		std::uniform_real_distribution<double> coefficient(-2, 2);
+
+		// the exponents of every monomial of degree at most `degree`
+		std::vector<std::vector<unsigned>> monomials{ std::vector<unsigned>(num_variables, 0) };
+		for (unsigned ii = 0; ii < num_variables; ++ii)
+		{
+			std::vector<std::vector<unsigned>> with_this_variable;
+			for (auto const& m : monomials)
+			{
+				unsigned degree_so_far = 0;
+				for (auto e : m)
+					degree_so_far += e;
+				for (unsigned e = 0; degree_so_far + e <= degree; ++e)
+				{
+					with_this_variable.push_back(m);
+					with_this_variable.back()[ii] = e;
+				}
+			}
+			monomials = std::move(with_this_variable);
+		}
+
+		std::stringstream input;
+		input.precision(17);
+
+		input << "variable_group ";
+		for (unsigned ii = 0; ii < num_variables; ++ii)
+			input << (ii ? "," : "") << "x" << ii;
+		input << ";\nfunction ";
+		for (unsigned ii = 0; ii < num_variables; ++ii)
+			input << (ii ? "," : "") << "f" << ii;
+		input << ";\n";
+
+		for (unsigned ii = 0; ii < num_variables; ++ii)
+		{
+			input << "f" << ii << " = ";
+			for (unsigned jj = 0; jj < monomials.size(); ++jj)
+			{
+				input << (jj ? " + " : "") << "(" << coefficient(generator) << ")";
+				for (unsigned kk = 0; kk < num_variables; ++kk)
+					if (monomials[jj][kk] == 1)
+						input << "*x" << kk;
+					else if (monomials[jj][kk] > 1)
+						input << "*x" << kk << "^" << monomials[jj][kk];
+			}
+			input << ";\n";
+		}
+
+		std::string str = input.str();
+		bertini::System sys;
+		bertini::parsing::classic::parse(str.begin(), str.end(), sys);
+		return sys;
+	}
+
+
+	template<typename CType>
+	Vec<CType> RandomPoint(unsigned num_variables)
+	{
+		Vec<CType> v(num_variables);
+		for (unsigned ii = 0; ii < num_variables; ++ii)
+			v(ii) = bertini::RandomUnit<CType>();
+		return v;
+	}
+
+
+	/**
+	 Average wall-clock seconds for one call of `f`, over `num_repetitions` calls.
+	 */
+	template<typename F>
+	double SecondsPerCall(F const& f, unsigned num_repetitions)
+	{
+		f(); // warm up caches, and the branch predictor
+
+		auto start = std::chrono::steady_clock::now();
+		for (unsigned ii = 0; ii < num_repetitions; ++ii)
+			f();
+		auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double>(end-start).count() / num_repetitions;
+	}
+
+} // namespace demo
@@ -0,0 +1,357 @@
+#include "benchmark_systems.hpp"
+
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+
+
+struct SystemSize{
+	unsigned num_variables;
+	unsigned degree;
+	unsigned num_terms;
+};
+
+// from tiny, where dispatch is most of the work, to big enough that it isn't
+const std::vector<SystemSize> system_sizes{ {2,2,3}, {4,3,8}, {10,4,20}, {30,5,60} };
+
+
+
+
+template<typename NumT>
+void DispatchTimes(bertini::StraightLineProgram & slp, Vec<NumT> const& x, unsigned num_repetitions)
+{
+	using bertini::DispatchMethod;
+
+	slp.SetDispatchMethod(DispatchMethod::Switch);
+	auto switch_time = demo::SecondsPerCall([&](){ slp.Eval(x); }, num_repetitions);
+
+	slp.SetDispatchMethod(DispatchMethod::Threaded);
+	auto threaded_time = demo::SecondsPerCall([&](){ slp.Eval(x); }, num_repetitions);
+
+	std::cout << std::setw(14) << switch_time*1e9 << std::setw(14) << threaded_time*1e9 << std::setw(10) << switch_time/threaded_time;
+}
+
+
+void BenchmarkDispatch()
+{
+	std::cout << "\ndispatch: nanoseconds per evaluation of functions and Jacobian, switch on the instruction stream vs threaded code\n\n";
+	std::cout << std::setw(6) << "vars" << std::setw(8) << "instrs"
+	          << std::setw(14) << "dbl switch" << std::setw(14) << "dbl threaded" << std::setw(10) << "speedup"
+	          << std::setw(14) << "mp switch" << std::setw(14) << "mp threaded" << std::setw(10) << "speedup" << '\n';
+
+	for (auto const& size : system_sizes)
+	{
+		auto sys = demo::RandomPolynomialSystem(size.num_variables, size.degree, size.num_terms);
+		bertini::StraightLineProgram slp(sys);
+
+		const unsigned num_repetitions = 2000000 / (10*size.num_terms*size.num_variables);
+
+		std::cout << std::setw(6) << size.num_variables << std::setw(8) << slp.GetOptimizationStatistics().InstructionsAfter;
+
+		DispatchTimes(slp, demo::RandomPoint<dbl>(size.num_variables), num_repetitions);
+
+		bertini::DefaultPrecision(30);
+		slp.precision(30);
+		DispatchTimes(slp, demo::RandomPoint<mpfr_complex>(size.num_variables), num_repetitions/10+1);
+		bertini::DefaultPrecision(16);
+		slp.precision(16);
+
+		std::cout << '\n';
+	}
+}
+
+
+
+
+void BenchmarkJIT()
+{
+	using bertini::DispatchMethod;
+
+	std::cout << "\njit: nanoseconds per evaluation of functions and Jacobian in double precision, threaded code vs machine code\n\n";
+	std::cout << std::setw(6) << "vars" << std::setw(8) << "instrs"
+	          << std::setw(14) << "threaded" << std::setw(14) << "jit" << std::setw(10) << "speedup" << '\n';
+
+	for (auto const& size : system_sizes)
+	{
+		auto sys = demo::RandomPolynomialSystem(size.num_variables, size.degree, size.num_terms);
+		bertini::StraightLineProgram slp(sys);
+
+		if (!slp.HasJIT())
+		{
+			std::cout << "no jit on this platform\n";
+			return;
+		}
+
+		const unsigned num_repetitions = 2000000 / (10*size.num_terms*size.num_variables);
+		auto x = demo::RandomPoint<dbl>(size.num_variables);
+
+		slp.SetDispatchMethod(DispatchMethod::Threaded);
+		auto threaded_time = demo::SecondsPerCall([&](){ slp.Eval(x); }, num_repetitions);
+
+		slp.SetDispatchMethod(DispatchMethod::JIT);
+		auto jit_time = demo::SecondsPerCall([&](){ slp.Eval(x); }, num_repetitions);
+
+		std::cout << std::setw(6) << size.num_variables << std::setw(8) << slp.GetOptimizationStatistics().InstructionsAfter
+		          << std::setw(14) << threaded_time*1e9 << std::setw(14) << jit_time*1e9 << std::setw(10) << threaded_time/jit_time << '\n';
+	}
+}
+
+
+
+// the double precision values of the functions, and how many digits of them are right, judging by a higher precision evaluation of the same program
+double CorrectDigits(bertini::StraightLineProgram & slp, Vec<dbl> const& x)
+{
+	slp.Eval(x);
+	Vec<dbl> f = slp.GetFuncVals<dbl>();
+
+	const unsigned higher_precision = 60;
+	bertini::DefaultPrecision(higher_precision);
+	slp.precision(higher_precision);
+	Vec<mpfr_complex> x_mp(x.size());
+	for (int ii = 0; ii < x.size(); ++ii)
+		x_mp(ii) = mpfr_complex(x(ii));
+	slp.Eval(x_mp);
+	Vec<mpfr_complex> f_mp = slp.GetFuncVals<mpfr_complex>();
+	bertini::DefaultPrecision(16);
+	slp.precision(16);
+
+	double worst = 16;
+	for (int ii = 0; ii < f.size(); ++ii)
+	{
+		auto exact = static_cast<dbl>(f_mp(ii));
+		auto relative_error = abs(f(ii) - exact) / abs(exact);
+		if (relative_error > 0)
+			worst = std::min(worst, -std::log10(relative_error));
+	}
+	return worst;
+}
+
+
+void BenchmarkReduction()
+{
+	using bertini::ReductionMethod;
+
+	// wide sums.  the random coefficients have both signs, so there's cancellation
+	const std::vector<SystemSize> wide_sizes{ {2,3,50}, {4,3,200}, {4,4,1000}, {8,4,4000} };
+	const unsigned num_points = 100;
+	const double enough_digits = 13;
+
+	std::cout << "\nreduction: sums made into a chain of additions vs a pairwise tree.  nanoseconds per evaluation of functions and Jacobian in double precision, and the fewest correct digits of the functions over " << num_points << " random points\n";
+	std::cout << "'short' counts the points with fewer than " << enough_digits << " correct digits, where adaptive precision would likely have to go up\n\n";
+	std::cout << std::setw(6) << "vars" << std::setw(8) << "terms"
+	          << std::setw(12) << "chain" << std::setw(12) << "pairwise" << std::setw(10) << "speedup"
+	          << std::setw(14) << "chain digits" << std::setw(10) << "short" << std::setw(14) << "pair digits" << std::setw(10) << "short" << '\n';
+
+	for (auto const& size : wide_sizes)
+	{
+		auto sys = demo::RandomPolynomialSystem(size.num_variables, size.degree, size.num_terms);
+
+		bertini::SLPCompiler compiler;
+		compiler.SetReductionMethod(ReductionMethod::Chain);
+		auto chain = compiler.Compile(sys);
+		compiler.SetReductionMethod(ReductionMethod::Pairwise);
+		auto pairwise = compiler.Compile(sys);
+
+		const unsigned num_repetitions = 2000000 / (10*size.num_terms*size.num_variables) + 1;
+		auto x = demo::RandomPoint<dbl>(size.num_variables);
+		auto chain_time = demo::SecondsPerCall([&](){ chain.Eval(x); }, num_repetitions);
+		auto pairwise_time = demo::SecondsPerCall([&](){ pairwise.Eval(x); }, num_repetitions);
+
+		double chain_digits = 16, pairwise_digits = 16;
+		unsigned chain_short = 0, pairwise_short = 0;
+		for (unsigned p = 0; p < num_points; ++p)
+		{
+			auto point = demo::RandomPoint<dbl>(size.num_variables);
+
+			auto c = CorrectDigits(chain, point);
+			chain_digits = std::min(chain_digits, c);
+			chain_short += c < enough_digits;
+
+			auto w = CorrectDigits(pairwise, point);
+			pairwise_digits = std::min(pairwise_digits, w);
+			pairwise_short += w < enough_digits;
+		}
+
+		std::cout << std::setw(6) << size.num_variables << std::setw(8) << size.num_terms
+		          << std::setw(12) << chain_time*1e9 << std::setw(12) << pairwise_time*1e9 << std::setw(10) << chain_time/pairwise_time
+		          << std::setw(14) << chain_digits << std::setw(10) << chain_short << std::setw(14) << pairwise_digits << std::setw(10) << pairwise_short << '\n';
+	}
+}
+
+
+
+void BenchmarkPolynomial()
+{
+	using bertini::PolynomialMethod;
+
+	// every monomial up to the degree, like the kinematics systems, where the same powers are in many terms
+	const std::vector<std::pair<unsigned,unsigned>> dense_sizes{ {2,6}, {3,5}, {4,4}, {6,3} }; // variables, degree
+	const std::vector<std::pair<PolynomialMethod, std::string>> methods{ {PolynomialMethod::Generic, "generic"}, {PolynomialMethod::SparseMonomial, "sparse"}, {PolynomialMethod::Horner, "horner"} };
+
+	std::cout << "\npolynomial: dense polynomial systems compiled with a power instruction per power, with shared power tables and monomials, and by the Horner rule.  instructions, and nanoseconds per evaluation of functions and Jacobian in double precision\n\n";
+	std::cout << std::setw(6) << "vars" << std::setw(8) << "degree";
+	for (auto const& m : methods)
+		std::cout << std::setw(14) << m.second + " ins" << std::setw(14) << m.second + " ns";
+	std::cout << '\n';
+
+	for (auto const& size : dense_sizes)
+	{
+		auto sys = demo::DensePolynomialSystem(size.first, size.second);
+		auto x = demo::RandomPoint<dbl>(size.first);
+
+		std::cout << std::setw(6) << size.first << std::setw(8) << size.second;
+		for (auto const& m : methods)
+		{
+			bertini::SLPCompiler compiler;
+			compiler.SetPolynomialMethod(m.first);
+			auto slp = compiler.Compile(sys);
+
+			const unsigned num_repetitions = 20000000 / (10*slp.GetOptimizationStatistics().InstructionsAfter) + 1;
+			auto time = demo::SecondsPerCall([&](){ slp.Eval(x); }, num_repetitions);
+
+			std::cout << std::setw(14) << slp.GetOptimizationStatistics().InstructionsAfter << std::setw(14) << time*1e9;
+		}
+		std::cout << '\n';
+	}
+}
+
+
+
+void BenchmarkProfile()
+{
+	const unsigned num_repetitions = 1000;
+
+	std::cout << "\nprofile: where evaluation of functions and Jacobian spends its time, by opcode, for " << num_repetitions << " evaluations in double precision and at 30 digits\n";
+
+	for (auto const& size : {system_sizes.front(), system_sizes.back()})
+	{
+		auto sys = demo::RandomPolynomialSystem(size.num_variables, size.degree, size.num_terms);
+		bertini::StraightLineProgram slp(sys);
+		slp.SetProfiling(true);
+
+		auto x = demo::RandomPoint<dbl>(size.num_variables);
+		for (unsigned ii=0; ii<num_repetitions; ++ii)
+			slp.Eval(x);
+
+		bertini::DefaultPrecision(30);
+		slp.precision(30);
+		auto x_mp = demo::RandomPoint<mpfr_complex>(size.num_variables);
+		for (unsigned ii=0; ii<num_repetitions; ++ii)
+			slp.Eval(x_mp);
+		bertini::DefaultPrecision(16);
+		slp.precision(16);
+
+		std::cout << "\n" << size.num_variables << " variables, degree " << size.degree << ", " << size.num_terms << " terms: " << slp.GetProfile();
+	}
+}
+
+
+
+// seconds to parse a system, to differentiate it, and to destroy it, with its nodes on the heap or in an arena
+struct ConstructionTimes{
+	double parse, differentiate, destroy;
+	double megabytes; // in the arena
+};
+
+ConstructionTimes TimeConstruction(SystemSize const& size, bool use_arena)
+{
+	using clock = std::chrono::steady_clock;
+	auto seconds_since = [](clock::time_point start){ return std::chrono::duration<double>(clock::now()-start).count(); };
+
+	ConstructionTimes times{0,0,0,0};
+	auto arena = use_arena ? bertini::node::NodeArena::Make() : nullptr;
+
+	auto start = clock::now();
+	std::unique_ptr<bertini::System> sys;
+	{
+		bertini::node::NodeArena::Scope scope(arena);
+		sys = std::make_unique<bertini::System>(demo::RandomPolynomialSystem(size.num_variables, size.degree, size.num_terms));
+	}
+	times.parse = seconds_since(start);
+
+	sys->SetNodeArena(arena);
+	sys->SetEvalMethod(bertini::EvalMethod::FunctionTree);
+	sys->SetDerivMethod(bertini::DerivMethod::Derivatives);
+
+	start = clock::now();
+	sys->Differentiate();
+	times.differentiate = seconds_since(start);
+
+	if (arena)
+		times.megabytes = arena->NumBytes() / 1e6;
+	arena.reset(); // the system and its nodes are all that keep it now
+
+	start = clock::now();
+	sys.reset();
+	times.destroy = seconds_since(start);
+
+	return times;
+}
+
+
+void BenchmarkArena()
+{
+	// many terms, so many nodes, and many derivatives of them
+	const std::vector<SystemSize> large_sizes{ {10,4,200}, {30,5,400}, {60,5,800}, {100,6,1000} };
+
+	std::cout << "\narena: milliseconds to parse a system, to differentiate it symbolically, and to destroy it, with the nodes allocated one by one on the heap vs in a node::NodeArena\n\n";
+	std::cout << std::setw(6) << "vars" << std::setw(8) << "terms"
+	          << std::setw(12) << "heap parse" << std::setw(12) << "arena parse"
+	          << std::setw(12) << "heap diff" << std::setw(12) << "arena diff"
+	          << std::setw(14) << "heap destroy" << std::setw(14) << "arena destroy"
+	          << std::setw(10) << "speedup" << std::setw(10) << "arena MB" << '\n';
+
+	for (auto const& size : large_sizes)
+	{
+		TimeConstruction(size, false); // warm up the heap and the parser
+
+		auto heap = TimeConstruction(size, false);
+		auto arena = TimeConstruction(size, true);
+
+		auto total = [](ConstructionTimes const& t){ return t.parse + t.differentiate + t.destroy; };
+
+		std::cout << std::setw(6) << size.num_variables << std::setw(8) << size.num_terms
+		          << std::setw(12) << heap.parse*1e3 << std::setw(12) << arena.parse*1e3
+		          << std::setw(12) << heap.differentiate*1e3 << std::setw(12) << arena.differentiate*1e3
+		          << std::setw(14) << heap.destroy*1e3 << std::setw(14) << arena.destroy*1e3
+		          << std::setw(10) << total(heap)/total(arena) << std::setw(10) << arena.megabytes << '\n';
+	}
+}
+
+
+
+int main(int argc, char** argv)
+{
+	const std::map<std::string, std::function<void()>> benchmarks{
+		{"dispatch", BenchmarkDispatch},
+		{"jit", BenchmarkJIT},
+		{"reduction", BenchmarkReduction},
+		{"polynomial", BenchmarkPolynomial},
+		{"profile", BenchmarkProfile},
+		{"arena", BenchmarkArena},
+	};
+
+	std::vector<std::string> to_run(argv+1, argv+argc);
+	if (to_run.empty())
+		for (auto const& b : benchmarks)
+			to_run.push_back(b.first);
+
+	for (auto const& name : to_run)
+	{
+		auto found = benchmarks.find(name);
+		if (found==benchmarks.end())
+		{
+			std::cerr << "no benchmark named " << name << ".  the benchmarks are:";
+			for (auto const& b : benchmarks)
+				std::cerr << ' ' << b.first;
+			std::cerr << '\n';
+			return 1;
+		}
+		found->second();
+	}
+
+	return 0;
+}
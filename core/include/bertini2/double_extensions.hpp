@@ -113,6 +113,41 @@ namespace bertini{
 			return result;
 		}
 	}
+
+
+	/**
+	 The operations of a StraightLineProgram, writing into a result which already exists.  Named for the opcodes.  There are overloads for mpfr_complex in mpfr_complex.hpp, which don't allocate, so the interpreter and generated code are written once, in these terms.
+
+	 The result must not alias an operand.
+	 */
+	namespace inplace{
+
+		inline void Add(dbl & out, dbl const& a, dbl const& b){ out = a + b;}
+		inline void Subtract(dbl & out, dbl const& a, dbl const& b){ out = a - b;}
+		inline void Multiply(dbl & out, dbl const& a, dbl const& b){ out = a * b;}
+		inline void Divide(dbl & out, dbl const& a, dbl const& b){ out = a / b;}
+		inline void Power(dbl & out, dbl const& a, dbl const& b){ out = pow(a, b);}
+		inline void IntPower(dbl & out, dbl const& a, int k){ out = pow(a, k);}
+
+		inline void Assign(dbl & out, dbl const& a){ out = a;}
+		inline void Negate(dbl & out, dbl const& a){ out = -a;}
+		inline void Sqrt(dbl & out, dbl const& a){ out = sqrt(a);}
+		inline void Exp(dbl & out, dbl const& a){ out = exp(a);}
+		inline void Log(dbl & out, dbl const& a){ out = log(a);}
+		inline void Sin(dbl & out, dbl const& a){ out = sin(a);}
+		inline void Cos(dbl & out, dbl const& a){ out = cos(a);}
+		inline void Tan(dbl & out, dbl const& a){ out = tan(a);}
+		inline void Asin(dbl & out, dbl const& a){ out = asin(a);}
+		inline void Acos(dbl & out, dbl const& a){ out = acos(a);}
+		inline void Atan(dbl & out, dbl const& a){ out = atan(a);}
+
+		// the fused operations.  in double precision, the product is rounded, then the sum, just as for separate instructions
+		inline void FMA(dbl & out, dbl const& a, dbl const& b, dbl const& c){ out = a*b + c;}
+		inline void Square(dbl & out, dbl const& a){ out = a*a;}
+		inline void ScaleByInt(dbl & out, dbl const& a, int k){ out = a*static_cast<double>(k);} // both parts times k, as a real number
+		inline void MulAddConst(dbl & out, dbl const& a, int k, dbl const& c){ out = a*static_cast<double>(k) + c;}
+
+	} // namespace inplace
 	
 } // namespace bertini
 
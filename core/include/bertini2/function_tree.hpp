@@ -51,6 +51,8 @@
 #include "bertini2/function_tree/roots/jacobian.hpp"
 
 #include "bertini2/function_tree/simplify.hpp"
+#include "bertini2/function_tree/factory.hpp"
+#include "bertini2/function_tree/flat_tree.hpp"
 
 
 
@@ -0,0 +1,240 @@
+//This file is part of Bertini 2.
+//
+//b2/core/include/bertini2/function_tree/factory.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//b2/core/include/bertini2/function_tree/factory.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with b2/core/include/bertini2/function_tree/factory.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2021 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+//  silviana amethyst, university of wisconsin-eau claire
+
+/**
+\file include/bertini2/function_tree/factory.hpp
+
+\brief A factory for nodes which hash-conses them, so that structurally identical subtrees are one node.
+
+Nodes made with the various Make functions are all separate objects, even when they're the same expression, and Differentiate() makes lots of the same expressions.  A NodeFactory keeps one node for each expression it has seen, keyed by the kind of node and its children, so that a subexpression appearing in many functions and derivatives is stored, and evaluated, once.
+*/
+
+
+#ifndef BERTINI_FUNCTION_TREE_FACTORY_HPP
+#define BERTINI_FUNCTION_TREE_FACTORY_HPP
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bertini2/detail/visitor.hpp"
+
+#include "bertini2/function_tree/node.hpp"
+#include "bertini2/function_tree/operators/arithmetic.hpp"
+#include "bertini2/function_tree/operators/trig.hpp"
+#include "bertini2/function_tree/symbols/linear_product.hpp"
+#include "bertini2/function_tree/symbols/variable.hpp"
+#include "bertini2/function_tree/symbols/differential.hpp"
+#include "bertini2/function_tree/symbols/number.hpp"
+#include "bertini2/function_tree/symbols/special_number.hpp"
+#include "bertini2/function_tree/roots/function.hpp"
+#include "bertini2/function_tree/roots/jacobian.hpp"
+
+namespace bertini {
+namespace node {
+
+	/**
+	\class NodeFactory
+
+	\brief Makes and interns nodes, so that there's one node per distinct expression.
+
+	Two nodes are the same expression if they're the same kind of node, with the same data (the value of a number, the signs of a sum, the exponent of an integer power, ...), and the same children, in the same order.  Children are interned first, so "the same children" is just a comparison of pointers.
+
+	Interning a tree replaces the children of its nodes with the interned ones, in place.  The values of the trees don't change, but they come to share nodes, so change them in place (by homogenizing, say) only before interning.
+
+	Some nodes are never merged with others:
+
+	* Variables, since two variables with the same name are still different variables,
+	* Functions and Jacobians, since they're the roots other code holds on to.  Their entries are interned, though,
+	* linear products, which carry their own coefficients and variables.
+
+	Use one factory for all the trees which should share nodes, such as the functions of a system and their derivatives.  See System::InternNodes.
+
+	Nothing is interned unless a factory is used, so this is opt-in.
+	*/
+	class NodeFactory : public VisitorBase,
+
+			// IF YOU ADD A THING HERE, YOU MUST ADD IT BELOW AND IN THE CPP SOURCE
+
+			// symbols and roots
+			public Visitor<Variable>,
+			public Visitor<Integer>,
+			public Visitor<Float>,
+			public Visitor<Rational>,
+			public Visitor<Function>,
+			public Visitor<Jacobian>,
+			public Visitor<Differential>,
+			public Visitor<LinearProduct>,
+			public Visitor<DiffLinear>,
+
+			// arithmetic
+			public Visitor<SumOperator>,
+			public Visitor<MultOperator>,
+			public Visitor<IntegerPowerOperator>,
+			public Visitor<PowerOperator>,
+			public Visitor<ExpOperator>,
+			public Visitor<LogOperator>,
+			public Visitor<NegateOperator>,
+			public Visitor<SqrtOperator>,
+
+			// the trig operators
+			public Visitor<SinOperator>,
+			public Visitor<ArcSinOperator>,
+			public Visitor<CosOperator>,
+			public Visitor<ArcCosOperator>,
+			public Visitor<TanOperator>,
+			public Visitor<ArcTanOperator>,
+
+			public Visitor<special_number::Pi>,
+			public Visitor<special_number::E>
+	{
+		using Nd = std::shared_ptr<Node>;
+
+	public:
+
+		/**
+		\brief Make a node, and intern it.
+
+		\return The node for the expression, which is an earlier one if the factory has seen the same expression before.  It's a Node, not a T, since the earlier one may be of a different type, for example when a sum of numbers was made into a Float by the arithmetic on nodes.
+
+		\tparam T The type of node to make.
+		\param args The arguments to T::Make.
+		*/
+		template<typename T, typename... Ts>
+		Nd Make(Ts&&... args)
+		{
+			return Intern(Nd(T::Make(std::forward<Ts>(args)...)));
+		}
+
+		/**
+		\brief Intern a tree.
+
+		\return The node for the expression n, which is n itself if the factory hasn't seen the same expression before.  A Function or Jacobian is always itself, with its entry interned.
+		*/
+		Nd Intern(Nd const& n);
+
+		/**
+		\brief The number of distinct expressions the factory keeps nodes for.
+		*/
+		size_t NumInterned() const
+		{
+			return interned_.size();
+		}
+
+		/**
+		\brief The number of nodes which were replaced by an earlier node for the same expression.
+		*/
+		size_t NumShared() const
+		{
+			return num_shared_;
+		}
+
+
+		// IF YOU ADD A THING HERE, YOU MUST ADD IT ABOVE AND IN THE CPP SOURCE
+
+		// symbols and roots
+		virtual void Visit(Variable const& n);
+		virtual void Visit(Integer const& n);
+		virtual void Visit(Float const& n);
+		virtual void Visit(Rational const& n);
+		virtual void Visit(Function const& n);
+		virtual void Visit(Jacobian const& n);
+		virtual void Visit(Differential const& n);
+		virtual void Visit(LinearProduct const& n);
+		virtual void Visit(DiffLinear const& n);
+
+		// arithmetic
+		virtual void Visit(SumOperator const& n);
+		virtual void Visit(MultOperator const& n);
+		virtual void Visit(IntegerPowerOperator const& n);
+		virtual void Visit(PowerOperator const& n);
+		virtual void Visit(ExpOperator const& n);
+		virtual void Visit(LogOperator const& n);
+		virtual void Visit(NegateOperator const& n);
+		virtual void Visit(SqrtOperator const& n);
+
+		// the trig operators
+		virtual void Visit(SinOperator const& n);
+		virtual void Visit(ArcSinOperator const& n);
+		virtual void Visit(CosOperator const& n);
+		virtual void Visit(ArcCosOperator const& n);
+		virtual void Visit(TanOperator const& n);
+		virtual void Visit(ArcTanOperator const& n);
+
+		virtual void Visit(special_number::Pi const& n);
+		virtual void Visit(special_number::E const& n);
+
+	private:
+
+		/**
+		\brief What makes two nodes the same expression.
+		*/
+		struct Key{
+			std::string kind; ///< the type of node, and any data it has besides its children
+			std::vector<Node const*> children; ///< interned children
+
+			bool operator==(Key const& other) const
+			{
+				return kind==other.kind && children==other.children;
+			}
+		};
+
+		struct KeyHash{
+			size_t operator()(Key const& k) const;
+		};
+
+		/**
+		\brief Intern a node which is merged with no other, such as a Variable.
+		*/
+		void Keep(Node const& n);
+
+		/**
+		\brief Intern a node, given its key.  Its children must already be interned.
+		*/
+		void Record(Node const& n, Key key);
+
+		/**
+		\brief Intern the operand of a unary operator, and then the operator.
+		*/
+		void VisitUnary(UnaryOperator const& n, std::string kind);
+
+		/**
+		\brief Intern the operands of a sum or product, and then the operator.
+
+		\param flags The signs of the sum, or whether each factor of the product multiplies or divides.
+		*/
+		void VisitNary(NaryOperator const& n, std::vector<bool> const& flags);
+
+		std::unordered_map<Key, Nd, KeyHash> interned_; ///< expression --> its node
+		std::unordered_map<Nd, Nd> canonical_; ///< every node seen --> the node for its expression.  Holds on to the nodes seen, so their addresses, in the keys of interned_, aren't reused while the factory is around.
+		size_t num_shared_ = 0;
+	};
+
+} // namespace node
+} // namespace bertini
+
+
+#endif //include guards
@@ -0,0 +1,225 @@
+//This file is part of Bertini 2.
+//
+//b2/core/include/bertini2/function_tree/flat_tree.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//b2/core/include/bertini2/function_tree/flat_tree.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with b2/core/include/bertini2/function_tree/flat_tree.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2021 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+//  silviana amethyst, university of wisconsin-eau claire
+
+/**
+\file include/bertini2/function_tree/flat_tree.hpp
+
+\brief Function trees, flattened into one contiguous array of nodes.
+
+A FlatTree has one entry per node of the trees it was made from, in topological order, with the children of each entry referred to by their indices.  Evaluating it is a single loop over the entries, switching on the kind of each, with no virtual calls, no recursion, and no shared pointers.  The values live in one array per number type.
+
+Unlike a StraightLineProgram, the nodes aren't optimized, fused or reordered, so evaluation does the same arithmetic as the trees would.  See EvalMethod::FlatTree.
+*/
+
+
+#ifndef BERTINI_FUNCTION_TREE_FLAT_TREE_HPP
+#define BERTINI_FUNCTION_TREE_FLAT_TREE_HPP
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "bertini2/double_extensions.hpp"
+#include "bertini2/mpfr_complex.hpp"
+#include "bertini2/function_tree/node.hpp"
+
+namespace bertini {
+namespace node {
+
+	namespace detail{
+		class FlatTreeBuilder;
+	}
+
+	/**
+	\class FlatTree
+
+	\brief Function trees, flattened into a contiguous, topologically ordered array of entries with integer children.
+
+	Make one by adding its inputs, the variables, and then the trees to flatten, as outputs.  Then set the values of the inputs, and read the values of the outputs.  The entries are evaluated as needed, and only as far as needed for the output asked for, once per setting of the inputs.
+
+	Handles are flattened into their entries, and linear products into sums and products.  Derivatives are flattened with respect to their variable of differentiation, which fixes the values of Differential and DiffLinear nodes.  Nodes shared by several trees are flattened once, except that those in derivatives aren't shared between different variables of differentiation.
+
+	Numbers are evaluated when flattened, and again from their nodes when the precision changes.  Evaluation never touches the nodes otherwise, though the FlatTree holds on to them, so trees added later can share entries with those added before.
+	*/
+	class FlatTree
+	{
+		friend class detail::FlatTreeBuilder;
+
+	public:
+
+		/**
+		\brief The kinds of entry.  Handles, Differentials and linear products have none of their own, as they're flattened into these.
+		*/
+		enum class Kind : std::uint8_t
+		{
+			Input,
+			Constant,
+			Sum, // of all the children, each added or subtracted.  the first is added.
+			Product, // of all the children, each multiplied or divided.  the first is multiplied.
+			IntPower,
+			Power,
+			Negate,
+			Sqrt,
+			Exp,
+			Log,
+			Sin,
+			Cos,
+			Tan,
+			ArcSin,
+			ArcCos,
+			ArcTan
+		};
+
+		/**
+		\brief One entry of the flattened trees.
+		*/
+		struct Entry
+		{
+			Kind kind;
+			std::uint32_t first_child; ///< where the children of the entry start in the list of children
+			std::uint32_t num_children;
+			int exponent; ///< for IntPower
+		};
+
+
+		/**
+		\brief Add an input.  Set its value with SetInput, by the order in which it was added.
+
+		Inputs must be added before any tree using them.
+		*/
+		void AddInput(std::shared_ptr<const Variable> const& v);
+
+		/**
+		\brief Flatten some trees, and add them as outputs, in order.  Read their values with Output.
+
+		\param roots The trees.
+		\param diff_variable The variable of differentiation, if the trees are derivatives, or nullptr for no variable of differentiation.
+
+		\throws std::runtime_error if a tree has a variable which isn't an input.
+		*/
+		void AddOutputs(std::vector<std::shared_ptr<Node>> const& roots, std::shared_ptr<const Variable> const& diff_variable = nullptr);
+
+
+		/**
+		\brief Set the value of an input.
+
+		In multiple precision, the value is rounded to the precision of the FlatTree.
+		*/
+		template<typename T>
+		void SetInput(size_t index, T const& value)
+		{
+			inplace::Assign(std::get< std::vector<T> >(values_)[inputs_[index]], value);
+			num_evaluated_[TypeIndex<T>()] = 0;
+		}
+
+		/**
+		\brief The value of an output, for the values of the inputs set last.  Evaluates the entries needed for it, if they haven't been already.
+		*/
+		template<typename T>
+		T const& Output(size_t index) const
+		{
+			const auto location = outputs_[index];
+			EvalUpTo<T>(location+1);
+			return std::get< std::vector<T> >(values_)[location];
+		}
+
+
+		/**
+		\brief Change the precision of the multiple precision values, and re-evaluate the numbers at it.
+		*/
+		void precision(unsigned prec);
+
+		unsigned precision() const
+		{
+			return precision_;
+		}
+
+
+		size_t NumEntries() const
+		{
+			return entries_.size();
+		}
+
+		size_t NumInputs() const
+		{
+			return inputs_.size();
+		}
+
+		size_t NumOutputs() const
+		{
+			return outputs_.size();
+		}
+
+		std::vector<Entry> const& Entries() const
+		{
+			return entries_;
+		}
+
+	private:
+
+		template<typename T>
+		static constexpr size_t TypeIndex()
+		{
+			return std::is_same<T,dbl>::value ? 0 : 1;
+		}
+
+		/**
+		\brief Evaluate the entries before an index, starting after those already evaluated.
+		*/
+		template<typename T>
+		void EvalUpTo(size_t end) const;
+
+		/**
+		\brief Make room for the values of the entries added since the last call.
+		*/
+		void Grow();
+
+		std::vector<Entry> entries_;
+		std::vector<std::uint32_t> children_; ///< the children of all the entries, each entry's together
+		std::vector<std::uint8_t> adds_; ///< for each child, 1 if it's added or multiplied, 0 if subtracted or divided
+
+		std::vector<std::uint32_t> inputs_; ///< the entries of the inputs
+		std::vector<std::uint32_t> outputs_; ///< the entries of the outputs
+
+		std::vector< std::pair<std::uint32_t, std::shared_ptr<const Node>> > constants_; ///< the entries of the numbers, and their nodes
+		std::map< std::shared_ptr<const Node>, std::uint32_t > locations_; ///< node --> its entry, while flattening
+		std::map< int, std::uint32_t > integer_locations_; ///< entries of the small integers made while flattening, such as the values of Differentials
+
+		mutable std::tuple< std::vector<dbl>, std::vector<mpfr_complex> > values_;
+		mutable std::tuple< dbl, mpfr_complex > scratch_; ///< for accumulating sums and products, without aliasing
+		mutable std::array<size_t,2> num_evaluated_ = {0,0}; ///< how many entries have been evaluated since the inputs were set, for each number type
+
+		unsigned precision_ = DefaultPrecision();
+	};
+
+} // namespace node
+} // namespace bertini
+
+
+#endif //include guards
@@ -44,15 +44,20 @@
 
 
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <tuple>
+#include <type_traits>
 
 #include <boost/type_index.hpp>
 
 #include "bertini2/num_traits.hpp"
 #include "bertini2/detail/visitable.hpp"
 #include "bertini2/function_tree/forward_declares.hpp"
+#include "bertini2/function_tree/node_arena.hpp"
 
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/archive/text_iarchive.hpp>
@@ -128,7 +133,40 @@ namespace detail{
 		}
 
 	};
+
+	/**
+	The last evaluation epoch handed out, to any thread.  Each is handed out once, so no two threads are ever in the same epoch.
+	*/
+	extern std::atomic<std::uint64_t> last_evaluation_epoch;
+
+	/**
+	The evaluation epoch of this thread, or 0 until it has one.  Use NewEvaluationEpoch to move it along.
+	*/
+	extern thread_local std::uint64_t evaluation_epoch;
 }
+
+
+/**
+\brief Start a new evaluation epoch on this thread, so that every Node will be freshly evaluated next time it is evaluated on this thread.
+
+This is O(1), no matter how big the trees are.  Numbers keep their values, as they do when Reset().  Other threads stay in their epochs, keeping their stored values.
+*/
+void NewEvaluationEpoch();
+
+/**
+\brief The current evaluation epoch of this thread.
+
+A value stored in a Node is good only during the epoch in which it was computed.  Moving to a new epoch, with NewEvaluationEpoch, forgets every stored value in every tree at once, in place of Reset()'ing each tree node by node.  Each thread has its own epoch, and epochs are never shared between threads, so a value stored by one thread is never taken as current by another.
+*/
+inline
+std::uint64_t CurrentEvaluationEpoch()
+{
+	if (detail::evaluation_epoch==0)
+		NewEvaluationEpoch();
+	return detail::evaluation_epoch;
+}
+
+
 /**
 An interface for all nodes in a function tree, and for a function object as well.  Almost all
  methods that will be called on a node must be declared in this class.  The main evaluation method is
@@ -145,6 +183,22 @@ class Node : public virtual VisitableBase<>, public std::enable_shared_from_this
 public:
 	
 	virtual ~Node() = default;
+
+	/**
+	 \brief Nodes are allocated in the current NodeArena, if there is one, or on the heap.
+
+	 Either way, each allocation is prefixed by the arena it came from, so that deleting the node gives its memory back to the right place.
+	*/
+	static void* operator new(std::size_t num_bytes);
+	static void operator delete(void* n) noexcept;
+
+	// declaring operator new hides the placement forms
+	static void* operator new(std::size_t, void* where) noexcept
+	{
+		return where;
+	}
+	static void operator delete(void*, void*) noexcept
+	{}
 	
 	///////// PUBLIC PURE METHODS /////////////////
   
@@ -323,6 +377,35 @@ protected:
 	//We must hard code in all types that we want here.
 	//TODO: Initialize this to some default value, second = false
 	mutable std::tuple< std::pair<dbl,bool>, std::pair<mpfr_complex,bool> > current_value_;
+
+	//The evaluation epoch in which each of the values in current_value_ was stored.  0 is never an epoch.
+	mutable std::array<std::uint64_t,2> stored_epoch_ = {0,0};
+
+	//Whether the stored values stay good from one evaluation epoch to the next.  True only for Numbers.
+	bool keeps_values_across_epochs_ = false;
+
+
+	/**
+	\brief Whether the value of type T stored in this Node is good, or it must be freshly evaluated.
+
+	It's good if it was stored since the last Reset(), and in the current evaluation epoch.
+	*/
+	template<typename T>
+	bool HaveStoredValue() const
+	{
+		return std::get< std::pair<T,bool> >(current_value_).second
+			&& (keeps_values_across_epochs_ || StoredEpoch<T>() == CurrentEvaluationEpoch());
+	}
+
+	/**
+	\brief Mark the value of type T in current_value_ as freshly evaluated, in the current evaluation epoch.
+	*/
+	template<typename T>
+	void MarkStoredValue() const
+	{
+		std::get< std::pair<T,bool> >(current_value_).second = true;
+		StoredEpoch<T>() = CurrentEvaluationEpoch();
+	}
 	
 	
 	
@@ -368,6 +451,16 @@ protected:
 	*/
 	void ResetStoredValues() const;
 
+private:
+
+	template<typename T>
+	std::uint64_t& StoredEpoch() const
+	{
+		return stored_epoch_[std::is_same<T,dbl>::value ? 0 : 1];
+	}
+
+protected:
+
 	Node();
 
 private:
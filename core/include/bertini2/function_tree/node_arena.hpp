@@ -0,0 +1,211 @@
+//This file is part of Bertini 2.
+//
+//b2/core/include/bertini2/function_tree/node_arena.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//b2/core/include/bertini2/function_tree/node_arena.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with b2/core/include/bertini2/function_tree/node_arena.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2021 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+//  silviana amethyst, university of wisconsin-eau claire
+
+/**
+\file include/bertini2/function_tree/node_arena.hpp
+
+\brief An arena for the memory of nodes, so that making big trees doesn't go to the heap for every node.
+
+Parsing and differentiating make lots of small nodes, each with its own allocation for the node and another for its shared_ptr.  While a NodeArena is current, see NodeArena::Scope, nodes made on that thread are carved out of the arena's big blocks instead, both the node and its shared_ptr's control block.  The blocks are all given back at once, when the arena and every node made in it are gone.
+*/
+
+
+#ifndef BERTINI_FUNCTION_TREE_NODE_ARENA_HPP
+#define BERTINI_FUNCTION_TREE_NODE_ARENA_HPP
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+
+namespace bertini {
+namespace node {
+
+	/**
+	\class NodeArena
+
+	\brief Memory for nodes, handed out from big blocks and given back all at once.
+
+	Make one with NodeArena::Make, and make nodes in it by making them while a NodeArena::Scope for it is around.  Nothing else changes: the nodes are held by shared_ptr's as usual, and are destroyed as usual when the last of those goes away.  Only their memory is different.  It's not given back when the node is destroyed, but when the arena is, and the arena lives until it and every node made in it are gone.  So nodes can safely outlive the System or other code which made the arena.
+
+	An arena never reuses memory, so it's for trees which are made and kept, like the functions of a System and their derivatives.  Trees which are made and thrown away repeatedly are better off on the heap.
+
+	Allocating from an arena is thread safe, but making it current is per thread.
+	*/
+	class NodeArena
+	{
+	public:
+
+		/**
+		\brief Make a new arena.
+
+		\param initial_block_size The size in bytes of the first block of memory.  Later blocks grow geometrically.
+		*/
+		static std::shared_ptr<NodeArena> Make(std::size_t initial_block_size = 1<<16);
+
+		/**
+		\brief The arena nodes made on this thread are allocated in, or nullptr for the heap.
+		*/
+		static NodeArena* Current();
+
+
+		/**
+		\class Scope
+
+		\brief Makes an arena current on this thread, for as long as the Scope is around.  Scopes nest, restoring the arena current before them when they end.
+
+		A Scope for no arena, a null pointer, leaves the current arena current, so that code with an optional arena can always make a Scope.  The caller keeps the arena alive while the Scope is around.
+		*/
+		class Scope
+		{
+		public:
+			explicit
+			Scope(std::shared_ptr<NodeArena> const& arena);
+
+			~Scope();
+
+			Scope(Scope const&) = delete;
+			Scope& operator=(Scope const&) = delete;
+
+		private:
+			NodeArena* previous_;
+		};
+
+
+		/**
+		\brief Get some memory from the arena.  It's given back when the arena is destroyed.
+		*/
+		void* Allocate(std::size_t num_bytes, std::size_t alignment);
+
+		/**
+		\brief Note that something allocated in the arena needs it to stay around.
+		*/
+		void Retain();
+
+		/**
+		\brief Note that something allocated in the arena is gone.  The arena is destroyed when nothing needs it any more.
+		*/
+		void Release();
+
+
+		/**
+		\brief The number of allocations made from the arena.
+		*/
+		std::size_t NumAllocations() const
+		{
+			return num_allocations_;
+		}
+
+		/**
+		\brief The number of bytes allocated from the arena, not counting unused space at the ends of blocks.
+		*/
+		std::size_t NumBytes() const
+		{
+			return num_bytes_;
+		}
+
+	private:
+
+		explicit
+		NodeArena(std::size_t initial_block_size);
+
+		~NodeArena() = default;
+
+		std::pmr::monotonic_buffer_resource resource_;
+		std::mutex mutex_; ///< guards resource_ and the counts
+		std::atomic<std::size_t> num_references_{1}; ///< the owners of the arena, plus everything allocated in it which hasn't gone yet
+		std::size_t num_allocations_ = 0;
+		std::size_t num_bytes_ = 0;
+	};
+
+
+
+	/**
+	\brief An allocator for the control blocks of shared_ptr's to nodes, from the arena current when it was made, or the heap if there wasn't one.
+	*/
+	template<typename T>
+	struct NodeAllocator
+	{
+		using value_type = T;
+
+		NodeAllocator() : arena(NodeArena::Current())
+		{}
+
+		template<typename U>
+		NodeAllocator(NodeAllocator<U> const& other) : arena(other.arena)
+		{}
+
+		T* allocate(std::size_t n)
+		{
+			if (!arena)
+				return std::allocator<T>().allocate(n);
+
+			auto memory = arena->Allocate(n*sizeof(T), alignof(T));
+			arena->Retain();
+			return static_cast<T*>(memory);
+		}
+
+		void deallocate(T* p, std::size_t n)
+		{
+			if (arena)
+				arena->Release();
+			else
+				std::allocator<T>().deallocate(p, n);
+		}
+
+		NodeArena* arena;
+	};
+
+	template<typename T, typename U>
+	bool operator==(NodeAllocator<T> const& a, NodeAllocator<U> const& b)
+	{
+		return a.arena==b.arena;
+	}
+
+	template<typename T, typename U>
+	bool operator!=(NodeAllocator<T> const& a, NodeAllocator<U> const& b)
+	{
+		return !(a==b);
+	}
+
+
+	/**
+	\brief Take ownership of a newly made node, with the control block of its shared_ptr in the current arena, if there is one.
+
+	The Make functions of the nodes use this, as their constructors are private, which rules out std::allocate_shared.  The node itself is allocated in the arena by Node::operator new.
+	*/
+	template<typename T>
+	std::shared_ptr<T> ShareNode(T* n)
+	{
+		return std::shared_ptr<T>(n, std::default_delete<T>(), NodeAllocator<T>());
+	}
+
+} // namespace node
+} // namespace bertini
+
+
+#endif //include guards
@@ -92,7 +92,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<SumOperator> Make(Ts&& ...ts){ 
-			return std::shared_ptr<SumOperator>( new SumOperator(ts...) );
+			return ShareNode( new SumOperator(ts...) );
 		}
 
 	private:
@@ -285,7 +285,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<NegateOperator> Make(Ts&& ...ts){ 
-			return std::shared_ptr<NegateOperator>( new NegateOperator(ts...) );
+			return ShareNode( new NegateOperator(ts...) );
 		}
 
 	private:
@@ -383,7 +383,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<MultOperator> Make(Ts&& ...ts){ 
-			return std::shared_ptr<MultOperator>( new MultOperator(ts...) );
+			return ShareNode( new MultOperator(ts...) );
 		}
 
 	private:
@@ -547,7 +547,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<PowerOperator> Make(Ts&& ...ts){ 
-			return std::shared_ptr<PowerOperator>( new PowerOperator(ts...) );
+			return ShareNode( new PowerOperator(ts...) );
 		}
 
 
@@ -750,7 +750,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<IntegerPowerOperator> Make(Ts&& ...ts){ 
-			return std::shared_ptr<IntegerPowerOperator>( new IntegerPowerOperator(ts...) );
+			return ShareNode( new IntegerPowerOperator(ts...) );
 		}
 
 	private:
@@ -839,7 +839,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<SqrtOperator> Make(Ts&& ...ts){ 
-			return std::shared_ptr<SqrtOperator>( new SqrtOperator(ts...) );
+			return ShareNode( new SqrtOperator(ts...) );
 		}
 
 	private:
@@ -918,7 +918,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<ExpOperator> Make(Ts&& ...ts){ 
-			return std::shared_ptr<ExpOperator>( new ExpOperator(ts...) );
+			return ShareNode( new ExpOperator(ts...) );
 		}
 
 	private:
@@ -984,7 +984,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<LogOperator> Make(Ts&& ...ts){ 
-			return std::shared_ptr<LogOperator>( new LogOperator(ts...) );
+			return ShareNode( new LogOperator(ts...) );
 		}
 
 	private:
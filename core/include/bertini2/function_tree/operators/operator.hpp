@@ -176,6 +176,14 @@ namespace node{
 		
 		// Add an operand onto the container for this operator
 		virtual void AddOperand(std::shared_ptr<Node> n);
+
+		/**
+		\brief Replace an operand.  Any sign or other data going with it stays as it was.
+
+		\param index Which operand to replace.
+		\param n The new operand.
+		*/
+		void SetOperand(size_t index, std::shared_ptr<Node> n);
 		
 		
 		size_t NumOperands() const;
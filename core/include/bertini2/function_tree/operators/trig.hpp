@@ -102,7 +102,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<SinOperator> Make(Ts&& ...ts){ 
-			return std::shared_ptr<SinOperator>( new SinOperator(ts...) );
+			return ShareNode( new SinOperator(ts...) );
 		}
 
 	private:
@@ -165,7 +165,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<ArcSinOperator> Make(Ts&& ...ts){ 
-			return std::shared_ptr<ArcSinOperator>( new ArcSinOperator(ts...) );
+			return ShareNode( new ArcSinOperator(ts...) );
 		}
 
 	private:
@@ -232,7 +232,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<CosOperator> Make(Ts&& ...ts){ 
-			return std::shared_ptr<CosOperator>( new CosOperator(ts...) );
+			return ShareNode( new CosOperator(ts...) );
 		}
 
 	private:
@@ -298,7 +298,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<ArcCosOperator> Make(Ts&& ...ts){ 
-			return std::shared_ptr<ArcCosOperator>( new ArcCosOperator(ts...) );
+			return ShareNode( new ArcCosOperator(ts...) );
 		}
 
 	private:
@@ -370,7 +370,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<TanOperator> Make(Ts&& ...ts){ 
-			return std::shared_ptr<TanOperator>( new TanOperator(ts...) );
+			return ShareNode( new TanOperator(ts...) );
 		}
 
 	private:
@@ -433,7 +433,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<ArcTanOperator> Make(Ts&& ...ts){ 
-			return std::shared_ptr<ArcTanOperator>( new ArcTanOperator(ts...) );
+			return ShareNode( new ArcTanOperator(ts...) );
 		}
 
 	private:
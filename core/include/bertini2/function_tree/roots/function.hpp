@@ -222,7 +222,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<Function> Make(Ts&& ...ts){ 
-			return std::shared_ptr<Function>( new Function(ts...) );
+			return ShareNode( new Function(ts...) );
 		}
 
 		template<typename... Ts> 
@@ -72,7 +72,7 @@ namespace node{
 			template<typename... Ts> 
 			static 
 			std::shared_ptr<Jacobian> Make(Ts&& ...ts){ 
-				return std::shared_ptr<Jacobian>( new Jacobian(ts...) );
+				return ShareNode( new Jacobian(ts...) );
 			}
 
 		private:
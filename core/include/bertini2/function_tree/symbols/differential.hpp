@@ -67,7 +67,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<Differential> Make(Ts&& ...ts){ 
-			return std::shared_ptr<Differential>( new Differential(ts...) );
+			return ShareNode( new Differential(ts...) );
 		}
 
 
@@ -67,7 +67,7 @@ namespace  bertini {
 			template<typename... Ts> 
 			static 
 			std::shared_ptr<LinearProduct> Make(Ts&& ...ts){ 
-				return std::shared_ptr<LinearProduct>( new LinearProduct(ts...) );
+				return ShareNode( new LinearProduct(ts...) );
 			}
 
 
@@ -393,7 +393,7 @@ namespace  bertini {
 			/**
 			 \brief Are there rational coefficients?
 			*/
-			bool IsRationalCoefficients()
+			bool IsRationalCoefficients() const
 			{
 				return is_rational_coeffs_;
 			}
@@ -422,6 +422,24 @@ namespace  bertini {
 			}
 			
 			
+			/**
+			 \brief The number of linear factors in the product.
+			 */
+			size_t NumFactors() const
+			{
+				return num_factors_;
+			}
+			
+			
+			/**
+			 \brief A single coefficient, as a number node.  Rational if the coefficients are, so it can be had at any precision.
+			 
+			 \param factor Index of the linear factor.
+			 \param term Index of the variable, or the number of variables for the coefficient of the homogenizing variable.
+			 */
+			std::shared_ptr<Node> GetCoefficientNode(size_t factor, size_t term) const;
+			
+			
 
 
 			
@@ -786,7 +804,7 @@ namespace  bertini {
 			template<typename... Ts> 
 			static 
 			std::shared_ptr<DiffLinear> Make(Ts&& ...ts){ 
-				return std::shared_ptr<DiffLinear>( new DiffLinear(ts...) );
+				return ShareNode( new DiffLinear(ts...) );
 			}
 
 		private:
@@ -812,6 +830,32 @@ namespace  bertini {
 			
 			
 			
+			/**
+			 \brief Getter for the variables of the linear
+			 */
+			void GetVariables(VariableGroup& vars) const
+			{
+				vars = variables_;
+			}
+			
+			
+			/**
+			 \brief Getter for the homogenizing variable
+			 */
+			void GetHomVariable(std::shared_ptr<Node>& hom_var) const
+			{
+				hom_var = hom_variable_;
+			}
+			
+			
+			/**
+			 \brief A single coefficient of the linear, as a number node.  This is the derivative of the linear with respect to the corresponding variable.
+			 
+			 \param term Index of the variable, or the number of variables for the coefficient of the homogenizing variable.
+			 */
+			std::shared_ptr<Node> GetCoefficientNode(size_t term) const;
+			
+			
 			/**
 			 \brief Reset variable values in this node
 			 */
@@ -985,7 +1029,7 @@ namespace  bertini {
 				if(diff_variable == hom_variable_)
 				{
 					auto& coeff_ref = std::get<Mat<dbl>>(coeffs_);
-					evaluation_value = coeff_ref(0,variables_.size()-1);
+					evaluation_value = coeff_ref(0,num_variables_); // the last column
 					return;
 				}
 				
@@ -1032,7 +1076,7 @@ namespace  bertini {
 				if(diff_variable == hom_variable_)
 				{
 					auto& coeff_ref = std::get<Mat<mpfr_complex>>(coeffs_);
-					evaluation_value = coeff_ref(0,variables_.size()-1);
+					evaluation_value = coeff_ref(0,num_variables_); // the last column
 					return;
 				}
 				
@@ -1076,6 +1120,7 @@ namespace  bertini {
 			
 			
 			size_t num_variables_;  ///< The number of variables in each linear.
+			bool is_rational_coeffs_ = false; ///< Do we have a rational coefficient to downsample from?
 			
 			
 			
@@ -67,6 +67,9 @@ namespace node{
 
 
 
+		/**
+		Numbers don't change, so their stored values aren't reset, and they're good in every evaluation epoch.
+		*/
 		void Reset() const override;
 
 
@@ -152,6 +155,11 @@ namespace node{
 		
 	protected:
 
+		Number()
+		{
+			keeps_values_across_epochs_ = true;
+		}
+
 	private:
 		friend class boost::serialization::access;
 
@@ -188,7 +196,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<Integer> Make(Ts&& ...ts){ 
-			return std::shared_ptr<Integer>( new Integer(ts...) );
+			return ShareNode( new Integer(ts...) );
 		}
 
 	private:
@@ -265,7 +273,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<Float> Make(Ts&& ...ts){ 
-			return std::shared_ptr<Float>( new Float(ts...) );
+			return ShareNode( new Float(ts...) );
 		}
 
 
@@ -366,7 +374,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<Rational> Make(Ts&& ...ts){ 
-			return std::shared_ptr<Rational>( new Rational(ts...) );
+			return ShareNode( new Rational(ts...) );
 		}
 
 
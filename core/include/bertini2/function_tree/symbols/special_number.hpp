@@ -73,7 +73,7 @@ namespace node{
 			template<typename... Ts> 
 			static 
 			std::shared_ptr<Pi> Make(Ts&& ...ts){ 
-				return std::shared_ptr<Pi>( new Pi(ts...) );
+				return ShareNode( new Pi(ts...) );
 			}
 
 
@@ -122,7 +122,7 @@ namespace node{
 			template<typename... Ts> 
 			static 
 			std::shared_ptr<E> Make(Ts&& ...ts){ 
-				return std::shared_ptr<E>( new E(ts...) );
+				return ShareNode( new E(ts...) );
 			}
 
 
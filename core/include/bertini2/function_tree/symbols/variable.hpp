@@ -64,7 +64,7 @@ namespace node{
 		template<typename... Ts> 
 		static 
 		std::shared_ptr<Variable> Make(Ts&& ...ts){ 
-			return std::shared_ptr<Variable>( new Variable(ts...) );
+			return ShareNode( new Variable(ts...) );
 		}
 
 	private:
@@ -140,6 +140,44 @@ using bmp::backends::mpc_complex_backend;
 	}
 
 
+	/**
+	 The operations of a StraightLineProgram, for mpfr_complex.  See the overloads for dbl in double_extensions.hpp.
+
+	 Each goes straight to MPC, rounding into the result at the result's own precision, so there are no temporaries, and nothing is allocated or reallocated by this code.  MPC may still use scratch space of its own for some operations, like products.  The result must not alias an operand.
+	 */
+	namespace inplace{
+
+		inline void Add(mpfr_complex & out, mpfr_complex const& a, mpfr_complex const& b){ mpc_add(out.backend().data(), a.backend().data(), b.backend().data(), MPC_RNDNN);}
+		inline void Subtract(mpfr_complex & out, mpfr_complex const& a, mpfr_complex const& b){ mpc_sub(out.backend().data(), a.backend().data(), b.backend().data(), MPC_RNDNN);}
+		inline void Multiply(mpfr_complex & out, mpfr_complex const& a, mpfr_complex const& b){ mpc_mul(out.backend().data(), a.backend().data(), b.backend().data(), MPC_RNDNN);}
+		inline void Divide(mpfr_complex & out, mpfr_complex const& a, mpfr_complex const& b){ mpc_div(out.backend().data(), a.backend().data(), b.backend().data(), MPC_RNDNN);}
+		inline void Power(mpfr_complex & out, mpfr_complex const& a, mpfr_complex const& b){ mpc_pow(out.backend().data(), a.backend().data(), b.backend().data(), MPC_RNDNN);}
+		inline void IntPower(mpfr_complex & out, mpfr_complex const& a, int k){ mpc_pow_si(out.backend().data(), a.backend().data(), k, MPC_RNDNN);}
+
+		inline void Assign(mpfr_complex & out, mpfr_complex const& a){ mpc_set(out.backend().data(), a.backend().data(), MPC_RNDNN);}
+		inline void Negate(mpfr_complex & out, mpfr_complex const& a){ mpc_neg(out.backend().data(), a.backend().data(), MPC_RNDNN);}
+		inline void Sqrt(mpfr_complex & out, mpfr_complex const& a){ mpc_sqrt(out.backend().data(), a.backend().data(), MPC_RNDNN);}
+		inline void Exp(mpfr_complex & out, mpfr_complex const& a){ mpc_exp(out.backend().data(), a.backend().data(), MPC_RNDNN);}
+		inline void Log(mpfr_complex & out, mpfr_complex const& a){ mpc_log(out.backend().data(), a.backend().data(), MPC_RNDNN);}
+		inline void Sin(mpfr_complex & out, mpfr_complex const& a){ mpc_sin(out.backend().data(), a.backend().data(), MPC_RNDNN);}
+		inline void Cos(mpfr_complex & out, mpfr_complex const& a){ mpc_cos(out.backend().data(), a.backend().data(), MPC_RNDNN);}
+		inline void Tan(mpfr_complex & out, mpfr_complex const& a){ mpc_tan(out.backend().data(), a.backend().data(), MPC_RNDNN);}
+		inline void Asin(mpfr_complex & out, mpfr_complex const& a){ mpc_asin(out.backend().data(), a.backend().data(), MPC_RNDNN);}
+		inline void Acos(mpfr_complex & out, mpfr_complex const& a){ mpc_acos(out.backend().data(), a.backend().data(), MPC_RNDNN);}
+		inline void Atan(mpfr_complex & out, mpfr_complex const& a){ mpc_atan(out.backend().data(), a.backend().data(), MPC_RNDNN);}
+
+		// the fused operations.  FMA rounds only once
+		inline void FMA(mpfr_complex & out, mpfr_complex const& a, mpfr_complex const& b, mpfr_complex const& c){ mpc_fma(out.backend().data(), a.backend().data(), b.backend().data(), c.backend().data(), MPC_RNDNN);}
+		inline void Square(mpfr_complex & out, mpfr_complex const& a){ mpc_sqr(out.backend().data(), a.backend().data(), MPC_RNDNN);}
+		inline void ScaleByInt(mpfr_complex & out, mpfr_complex const& a, int k){ mpc_mul_si(out.backend().data(), a.backend().data(), k, MPC_RNDNN);}
+		inline void MulAddConst(mpfr_complex & out, mpfr_complex const& a, int k, mpfr_complex const& c){
+			mpc_mul_si(out.backend().data(), a.backend().data(), k, MPC_RNDNN);
+			mpc_add(out.backend().data(), out.backend().data(), c.backend().data(), MPC_RNDNN);
+		}
+
+	} // namespace inplace
+
+
 }
 
 
@@ -0,0 +1,125 @@
+//This file is part of Bertini 2.
+//
+//slp_binary.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//slp_binary.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with slp_binary.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2021 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// silviana amethyst, university of wisconsin eau claire
+
+/**
+\file slp_binary.hpp
+
+\brief A compact binary format for compiled straight-line programs, and an on-disk cache of them.
+
+StraightLineProgram::WriteBinary writes a compiled program, and StraightLineProgram::ReadBinary reads one back.  Unlike the Boost archives, the format doesn't go through the node pointers of the whole program, and doesn't store the memory.  It's
+
+* a header: a magic string, and the version of the format,
+* the sizes, locations and instructions, as variable-length integers, so the format doesn't depend on the byte order or word size of the machine,
+* the numbers in the program, each as the small tree of number nodes it was made from, so they can still be had at any precision,
+* a checksum of all of the above.
+
+Reading checks all of it, and throws if anything is off.  A program read back evaluates exactly like the one written.
+
+SLPCache keeps programs in a directory, under a key made from a hash of a description of the system they were compiled from.  See System::SetSLPCacheDirectory.  The format version is part of every key, so changing the format just makes old entries unused.  Each entry starts with the whole description, which is checked when reading it, so that two systems whose descriptions hash the same can't be mistaken for each other.
+*/
+
+#ifndef BERTINI_SLP_BINARY_HPP
+#define BERTINI_SLP_BINARY_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+
+namespace bertini {
+
+	class StraightLineProgram;
+
+	namespace slp_binary {
+
+		/**
+		 \brief The version of the binary format written by StraightLineProgram::WriteBinary.  Bump it when changing the format.
+		 */
+		constexpr std::uint32_t FormatVersion = 3;
+
+		/**
+		 \brief A 64 bit hash of some text, as 16 hex digits.  Not cryptographic, just enough to tell systems apart.
+		 */
+		std::string Hash(std::string const& text);
+
+	} // namespace slp_binary
+
+
+
+	/**
+	 \class SLPCache
+
+	 A directory of compiled straight-line programs, written with StraightLineProgram::WriteBinary, each in a file named by its key.
+
+	 Entries are written to a temporary file first, then renamed into place, so several processes can share a cache.
+	 */
+	class SLPCache{
+	public:
+
+		/**
+		 \param directory Where to keep the programs.  Made when the first one is stored, if it doesn't exist.
+		 */
+		explicit
+		SLPCache(std::string const& directory) : directory_(directory)
+		{}
+
+		/**
+		 \brief The key for a program compiled from a system.
+
+		 \param description Everything the compiled program depends on, as text.  See System::SLPCacheDescription.
+		 */
+		static std::string Key(std::string const& description);
+
+		/**
+		 \brief Read the program stored for a description.
+
+		 \param description Everything the compiled program depends on, as text.  It's looked up by its Key, and has to match the description stored with the program.
+
+		 \return false, leaving the program alone, if there isn't one, it was stored for a different description, or it can't be read.  A file that can't be read is left for Store to replace.
+		 */
+		bool Load(std::string const& description, StraightLineProgram & slp) const;
+
+		/**
+		 \brief Store a program for a description, under its Key, replacing whatever was there.
+
+		 \throws std::runtime_error if the file can't be written.
+		 */
+		void Store(std::string const& description, StraightLineProgram const& slp) const;
+
+		/**
+		 \brief The file for a key.
+		 */
+		std::string PathFor(std::string const& key) const;
+
+		std::string const& Directory() const{ return directory_;}
+
+	private:
+		std::string directory_;
+	};
+
+} // namespace bertini
+
+
+#endif // for the ifndef include guards
@@ -0,0 +1,136 @@
+//This file is part of Bertini 2.
+//
+//slp_codegen.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//slp_codegen.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with slp_codegen.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2021 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// silviana amethyst, university of wisconsin eau claire
+
+/**
+\file slp_codegen.hpp
+
+\brief Ahead-of-time compilation of straight-line programs into shared libraries.
+
+StraightLineProgram::GenerateCpp writes a C++ source file in which every instruction of the program is one statement, with one function per block of instructions.  Compile it into a shared library, pointing the compiler at Bertini2's include directory:
+
+```
+c++ -std=c++17 -O2 -fPIC -shared -I<path to bertini2>/include my_slp.cpp -o my_slp.so
+```
+
+The double precision functions only need `bertini2/double_extensions.hpp`.  If the source was generated with the multiple precision functions too, the include paths for Boost.Multiprecision and MPC are needed as well.
+
+Then load it with StraightLineProgram::LoadNativeEvaluator, or with System::SetNativeSLPLibrary and EvalMethod::NativeSLP.  The SLP then calls the compiled functions instead of interpreting its instructions.
+
+The numbers in the program aren't written into the generated code.  They stay in the SLP's memory, so changing precision works as always.  The generated code is only good for the exact program it came from, so the library carries a fingerprint of the program, which is checked when loading.
+*/
+
+#ifndef BERTINI_SLP_CODEGEN_HPP
+#define BERTINI_SLP_CODEGEN_HPP
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bertini2/mpfr_complex.hpp"
+
+
+namespace bertini {
+
+	namespace slp_codegen {
+
+		/**
+		 \brief The name of the function in a generated library which returns the fingerprint of the program it came from.
+		 */
+		std::string FingerprintSymbol();
+
+		/**
+		 \brief The name of the function in a generated library which runs a block of instructions.
+
+		 \param multiple_precision Whether it's the function for mpfr_complex, or for dbl_complex.
+		 \param block Which block.  See StraightLineProgram::InstructionRanges.
+		 */
+		std::string BlockSymbol(bool multiple_precision, size_t block);
+
+		/**
+		 \brief Which whole blocks make up the range of instructions [begin, end)?
+
+		 \return false if the range doesn't start and stop on block boundaries.
+
+		 \param block_bounds The indices of the first instruction of each block, and one past the last instruction of the last block.
+		 \param[out] first_block The first block in the range.
+		 \param[out] end_block One past the last block in the range.
+		 */
+		bool BlocksSpanning(std::vector<size_t> const& block_bounds, size_t begin, size_t end, size_t & first_block, size_t & end_block);
+
+	} // namespace slp_codegen
+
+
+	/**
+	 \class NativeEvaluator
+
+	 The functions loaded from a shared library made from the output of StraightLineProgram::GenerateCpp.  The library stays open as long as any copy of the SLP that loaded it is around.
+	 */
+	class NativeEvaluator{
+	public:
+		using BlockFunction = void (*)(void* memory);
+
+		/**
+		 \brief Open a library and look up its functions.
+
+		 \throws std::runtime_error if the library can't be opened, is missing the double precision functions, or was made from a different program.
+
+		 \param library The path to the library.
+		 \param fingerprint The fingerprint of the program the library will be used for.
+		 \param block_bounds The indices of the first instruction of each block, and one past the last instruction of the last block.
+		 */
+		static std::shared_ptr<const NativeEvaluator> Load(std::string const& library, std::string const& fingerprint, std::vector<size_t> const& block_bounds);
+
+		/**
+		 \brief Run the instructions in the half-open range [begin, end) on the memory.
+
+		 \return false, without doing anything, if the range doesn't start and stop on block boundaries, or the library doesn't have functions for this number type.
+		 */
+		bool Run(dbl_complex* memory, size_t begin, size_t end) const;
+
+		bool Run(mpfr_complex* memory, size_t begin, size_t end) const;
+
+		/**
+		 \brief Does the library have the multiple precision functions, too?
+		 */
+		bool HasMultiplePrecision() const{ return !multiple_blocks_.empty();}
+
+		std::string const& Library() const{ return library_;}
+
+	private:
+
+		bool Run(std::vector<BlockFunction> const& blocks, void* memory, size_t begin, size_t end) const;
+
+		std::shared_ptr<void> handle_; //< From dlopen.  Closed when the last copy goes.
+		std::string library_;
+		std::vector<size_t> block_bounds_;
+		std::vector<BlockFunction> double_blocks_;
+		std::vector<BlockFunction> multiple_blocks_; //< Empty if the source was generated without them
+	};
+
+} // namespace bertini
+
+
+#endif // for the ifndef include guards
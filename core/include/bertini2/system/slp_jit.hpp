@@ -0,0 +1,101 @@
+//This file is part of Bertini 2.
+//
+//slp_jit.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//slp_jit.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with slp_jit.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2021 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// silviana amethyst, university of wisconsin eau claire
+
+/**
+\file slp_jit.hpp
+
+\brief Machine code for double precision evaluation of straight-line programs, made in-process.
+
+On x86-64 (other than Windows, whose calling convention is different), compiling a StraightLineProgram also turns its instructions into machine code, one function per block of instructions.  Addition, subtraction, multiplication, negation and assignment are done inline with SSE2.  Everything else is a call to a function doing exactly what the interpreter does.  There's no dependency on anything but mmap.
+
+The inline multiplication is the textbook formula, like the interpreter's for finite numbers.  Where the interpreter would try to recover an infinity from a NaN result, the machine code doesn't.
+
+Elsewhere, or with BERTINI_DISABLE_SLP_JIT defined, there's no machine code, and DispatchMethod::JIT falls back to DispatchMethod::Threaded.
+*/
+
+#ifndef BERTINI_SLP_JIT_HPP
+#define BERTINI_SLP_JIT_HPP
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "bertini2/double_extensions.hpp"
+
+
+#if defined(__x86_64__) && !defined(_WIN32) && !defined(BERTINI_DISABLE_SLP_JIT)
+	#define BERTINI_SLP_JIT_AVAILABLE 1
+#else
+	#define BERTINI_SLP_JIT_AVAILABLE 0
+#endif
+
+
+namespace bertini {
+
+	struct Instruction;
+
+	/**
+	 \class JITEvaluator
+
+	 The machine code for the blocks of a straight-line program.  Immutable once made, so copies of an SLP share it.
+	 */
+	class JITEvaluator{
+	public:
+		using BlockFunction = void (*)(dbl_complex* memory);
+
+		/**
+		 \brief Make machine code for each block of instructions.
+
+		 \return nullptr if there's no JIT for this platform, or if making the code failed.
+
+		 \param instructions The decoded instructions.
+		 \param integers The exponents of the IntPower instructions.
+		 \param block_bounds The indices of the first instruction of each block, and one past the last instruction of the last block.
+		 */
+		static std::shared_ptr<const JITEvaluator> Compile(std::vector<Instruction> const& instructions, std::vector<int> const& integers, std::vector<size_t> const& block_bounds);
+
+		/**
+		 \brief Run the instructions in the half-open range [begin, end) on the memory.
+
+		 \return false, without doing anything, if the range doesn't start and stop on block boundaries.
+		 */
+		bool Run(dbl_complex* memory, size_t begin, size_t end) const;
+
+		/**
+		 \brief How many bytes of machine code there are.
+		 */
+		size_t CodeSize() const{ return code_size_;}
+
+	private:
+		std::shared_ptr<void> code_; //< The executable memory.  Unmapped when the last copy goes.
+		size_t code_size_{0};
+		std::vector<size_t> block_bounds_;
+		std::vector<BlockFunction> blocks_;
+	};
+
+} // namespace bertini
+
+
+#endif // for the ifndef include guards
@@ -0,0 +1,107 @@
+//This file is part of Bertini 2.
+//
+//slp_kernels.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//slp_kernels.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with slp_kernels.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2021 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// silviana amethyst, university of wisconsin eau claire
+
+/**
+\file slp_kernels.hpp
+
+\brief Vectorized kernels for batched double precision evaluation of straight-line programs.
+
+The kernels work on complex numbers split into arrays of real and imaginary parts, one entry per point, as laid out by StraightLineProgram::EvalBatch.  There is a plain C++ version of each kernel, and AVX2 and AVX-512 versions on x86-64.  Which one gets used is decided once, at run time, from what the CPU supports, so the same binary runs everywhere.
+
+All versions give bit-for-bit the same results: none of them use fused multiply-add, and the file is compiled without floating point contraction.  Define BERTINI_DISABLE_SIMD_KERNELS to build only the plain versions.
+*/
+
+#ifndef BERTINI_SLP_KERNELS_HPP
+#define BERTINI_SLP_KERNELS_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+
+namespace bertini {
+	namespace slp_kernels {
+
+		/**
+		 \brief The instruction sets there are kernels for.
+		 */
+		enum class SIMDLevel{
+			Scalar,
+			AVX2,
+			AVX512
+		};
+
+		std::string SIMDLevelToString(SIMDLevel level);
+
+		/**
+		 \brief Can the kernels for this level run on this CPU?
+		 */
+		bool Supported(SIMDLevel level);
+
+		/**
+		 \brief The best level the CPU running this program supports.
+		 */
+		SIMDLevel BestSupportedLevel();
+
+		/**
+		 \struct KernelTable
+
+		 One function per vectorized operation.  Each works on `n` points; `o` is the result, `a` and `b` the operands.  The result must not share memory with an operand.
+		 */
+		struct KernelTable{
+			using Binary = void (*)(double* o_re, double* o_im, const double* a_re, const double* a_im, const double* b_re, const double* b_im, std::size_t n);
+			using Unary = void (*)(double* o_re, double* o_im, const double* a_re, const double* a_im, std::size_t n);
+
+			/**
+			 `z` is scratch space for `n` points.
+			 */
+			using IntegerPower = void (*)(double* o_re, double* o_im, const double* a_re, const double* a_im, double* z_re, double* z_im, int exponent, std::size_t n);
+
+			Binary Add;
+			Binary Subtract;
+			Binary Multiply;
+			Binary Divide; //< The textbook formula, without the rescaling std::complex does to avoid overflow
+			Unary Negate;
+			Unary Assign;
+			IntegerPower IntPower; //< Square-and-multiply, like bertini::pow for doubles
+		};
+
+		/**
+		 \brief The kernels for a particular level.
+
+		 Throws if the CPU doesn't support the level.
+		 */
+		KernelTable const& Kernels(SIMDLevel level);
+
+		/**
+		 \brief The kernels for the best level this CPU supports.  The CPU is only asked once.
+		 */
+		KernelTable const& Kernels();
+
+	} // namespace slp_kernels
+} // namespace bertini
+
+
+#endif // for the ifndef include guards
@@ -36,8 +36,13 @@
 #pragma once
 
 #include <assert.h>
+#include <array>
 #include <vector>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <tuple>
 
 #include "bertini2/mpfr_complex.hpp"
 #include "bertini2/mpfr_extensions.hpp"
@@ -138,6 +143,8 @@ namespace bertini {
 
 	class SLPCompiler;
 	class System; // a forward declaration, solving the circular inclusion problem
+	class NativeEvaluator;
+	class JITEvaluator;
 
 
 	enum Operation { // we'll start with the binary ones
@@ -158,11 +165,17 @@ namespace bertini {
 		Atan=     1 << 14,
 		Assign=   1 << 15,
 		IntPower= 1 << 16,
+		FMA=      1 << 17, // a*b + c
+		Square=   1 << 18, // a*a
+		ScaleByInt= 1 << 19, // a*k, for an integer k
+		MulAddConst= 1 << 20, // a*k + c, for an integer k
 	};
 
-	const int BinaryOperations = Add|Subtract | Multiply|Divide | Power | IntPower;
+	const int BinaryOperations = Add|Subtract | Multiply|Divide | Power | IntPower | ScaleByInt;
 	const int TrigOperations   = Sin|Cos|Tan | Asin|Acos|Atan;
-	const int UnaryOperations  = Exp|Log | Negate | Assign | TrigOperations | Sqrt;
+	const int UnaryOperations  = Exp|Log | Negate | Assign | TrigOperations | Sqrt | Square;
+	const int TernaryOperations = FMA | MulAddConst;
+	const int IntegerOperandOperations = IntPower | ScaleByInt | MulAddConst; //< the second operand is an index into the integers, not into memory
 
 	constexpr bool IsUnary(Operation op)
 	{
@@ -174,8 +187,100 @@ namespace bertini {
 		return op & BinaryOperations;
 	}
 
+	constexpr bool IsTernary(Operation op)
+	{
+		return op & TernaryOperations;
+	}
+
+	/**
+	 \brief Does the second operand of an instruction with this operation refer to a location in memory?
+	 */
+	constexpr bool SecondOperandInMemory(Operation op)
+	{
+		return (IsBinary(op) || IsTernary(op)) && !(op & IntegerOperandOperations);
+	}
+
+	/**
+	 \brief How many words an instruction with this operation takes in the instruction stream: the opcode, the operands, and the result.
+	 */
+	constexpr size_t InstructionLength(Operation op)
+	{
+		return IsUnary(op) ? 3 : (IsTernary(op) ? 5 : 4);
+	}
+
 	std::string OpcodeToString(Operation op);
 
+	constexpr unsigned NumOperations = 21; //< How many kinds of Operation there are
+
+	/**
+	 \brief Where an operation goes in a table of all of them.  Each opcode is a single bit, so it's the position of that bit.
+	 */
+	constexpr unsigned OpcodeIndex(Operation op)
+	{
+		unsigned index = 0;
+		while (!(op & (1u << index)))
+			++index;
+		return index;
+	}
+
+
+	/**
+	 \struct Instruction
+
+	 One instruction of a StraightLineProgram, decoded from the instruction stream, so that evaluation doesn't have to work out arities and offsets as it goes.
+
+	 For unary operations, `in2` is unused.  For IntPower, ScaleByInt and MulAddConst, `in2` is an index into the integers, not into memory.  `in3` is only used by the ternary operations, FMA and MulAddConst, for the number added.
+	 */
+	struct Instruction{
+		Operation op;
+		size_t in1;
+		size_t in2;
+		size_t out;
+		size_t in3 = 0;
+	};
+
+
+	/**
+	 \brief How a StraightLineProgram gets from one instruction to the next.
+	 */
+	enum class DispatchMethod
+	{
+		Switch, // a switch on each opcode in the instruction stream, working out each instruction's arity as it goes
+		Threaded, // pre-decoded instructions, with each handler jumping straight to the next (computed goto), where the compiler supports it
+		JIT // machine code made when compiling, for double precision.  Threaded for multiple precision, or where there's no JIT.  see slp_jit.hpp
+	};
+
+	/**
+	 \brief How the SLPCompiler makes the instructions for the Jacobian and the time derivatives.
+	 */
+	enum class JacobianMethod
+	{
+		Symbolic, // compile the derivatives the System made by differentiating its function trees
+		Forward, // forward mode automatic differentiation of the functions' instructions.  one sweep per variable, plus one for time
+		Reverse, // reverse mode automatic differentiation of the functions' instructions.  one sweep per function
+		Automatic // forward or reverse, whichever needs fewer sweeps
+	};
+
+	/**
+	 \brief How the SLPCompiler turns sums and products of many operands into binary instructions.
+	 */
+	enum class ReductionMethod
+	{
+		Chain, // ((a+b)+c)+d.  each instruction waits on the one before it
+		Pairwise // (a+b)+(c+d).  the chain of dependent instructions is only logarithmically long, and the rounding error of a sum grows with the log of the number of terms, instead of the number of terms
+	};
+
+	/**
+	 \brief How the SLPCompiler makes the instructions for polynomials.  Only used for systems for which System::IsPolynomial is true.
+	 */
+	enum class PolynomialMethod
+	{
+		Generic, // every power and product as it is in the function tree, with an IntPower instruction for each power
+		SparseMonomial, // powers of each variable from a table shared by the whole system, made by squaring and multiplying.  monomials are built from them variable by variable, so monomials with the same powers of the first variables share those products
+		Horner // sums of monomials factored by the multivariate Horner rule, repeatedly pulling out the variable appearing in the most terms, with powers from the shared table
+	};
+
+
 	/**
 	 \class StraightLineProgram
 
@@ -263,6 +368,237 @@ namespace bertini {
 			}
 		};
 
+		/**
+		 \struct InstructionRanges
+
+		 The instructions are stored in blocks, so that the functions can be evaluated without also evaluating the derivatives, and so that what doesn't depend on the variables isn't run every time they change.  The blocks are, in order:
+
+		 1. [0, ConstantEnd) -- everything depending only on the numbers.  Run when the numbers are put into memory, and not again.
+		 2. [ConstantEnd, TimeOnlyEnd) -- everything depending on the path variable, but not the space variables.  Run only when the path variable changes.
+		 3. [TimeOnlyEnd, FunctionsEnd) -- the rest of what the functions depend on.
+		 4. [FunctionsEnd, SharedDerivativesEnd) -- the rest of what both the Jacobian and the time derivatives depend on.
+		 5. [SharedDerivativesEnd, JacobianEnd) -- the rest of what the Jacobian depends on.
+		 6. [JacobianEnd, TimeDerivEnd) -- the rest of what the time derivatives depend on.
+
+		 The numbers are indices of instructions, not offsets into the instruction stream.
+		 */
+		struct InstructionRanges{
+			size_t ConstantEnd{0};
+			size_t TimeOnlyEnd{0};
+			size_t FunctionsEnd{0};
+			size_t SharedDerivativesEnd{0};
+			size_t JacobianEnd{0};
+			size_t TimeDerivEnd{0};
+
+			/**
+			 \brief Where each block starts, and where the last one ends.  One more than the number of blocks.
+			 */
+			std::vector<size_t> Bounds() const{
+				return {0, ConstantEnd, TimeOnlyEnd, FunctionsEnd, SharedDerivativesEnd, JacobianEnd, TimeDerivEnd};
+			}
+
+			friend class boost::serialization::access;
+
+			template <typename Archive>
+			void serialize(Archive& ar, const unsigned version) {
+				ar & ConstantEnd;
+				ar & TimeOnlyEnd;
+				ar & FunctionsEnd;
+				ar & SharedDerivativesEnd;
+				ar & JacobianEnd;
+				ar & TimeDerivEnd;
+			}
+		};
+
+		/**
+		 \struct OptimizationStatistics
+
+		 How big the program was as first compiled from the system, and how big it is after the compiler's optimization pass.  Instruction counts are numbers of instructions, not lengths of the instruction stream.
+		 */
+		struct OptimizationStatistics{
+			size_t InstructionsBefore{0};
+			size_t InstructionsAfter{0};
+			size_t MemoryBefore{0};
+			size_t MemoryAfter{0};
+
+			friend class boost::serialization::access;
+
+			template <typename Archive>
+			void serialize(Archive& ar, const unsigned version) {
+				ar & InstructionsBefore;
+				ar & InstructionsAfter;
+				ar & MemoryBefore;
+				ar & MemoryAfter;
+			}
+		};
+
+		/**
+		 \struct ProgramStatistics
+
+		 The size and shape of the program as it's evaluated.
+		 */
+		struct ProgramStatistics{
+			size_t Instructions{0};
+			size_t Memory{0}; //< How many numbers are in the memory of a workspace
+			size_t LongestChain{0}; //< The most instructions, each using the result of the one before, from the inputs to any output.  No evaluation can take fewer steps than this, however parallel.
+			size_t ConstantStage{0}; //< How many of the instructions depend only on the numbers, and so are run only when they're put into memory
+			size_t TimeStage{0}; //< How many depend on the path variable but not the space variables, and so are run only when it changes
+		};
+
+		/**
+		 \struct ErrorBounds
+
+		 Bounds on the absolute error in the outputs of an evaluation in double precision, found by EvalErrorBounds.  Each is the largest over the outputs of its kind.  The inputs are taken as exact, and the numbers in the program as correctly rounded.
+		 */
+		struct ErrorBounds{
+			double Functions{0};
+			double Jacobian{0};
+			double TimeDeriv{0}; //< Zero if there's no path variable
+
+			/**
+			 \brief Whether the functions and Jacobian are known to be correct to within a tolerance.  False if either bound is infinite, or not a number.
+			 */
+			bool Trustworthy(double tolerance) const{
+				return Functions <= tolerance && Jacobian <= tolerance;
+			}
+		};
+
+		/**
+		 \struct EvaluationProfile
+
+		 What evaluation spent its time on: how many times each opcode ran, and for how long in total, in each number type.  Recorded while profiling is on.  See SetProfiling.
+
+		 Print it, or write it as JSON with WriteJSON.
+		 */
+		struct EvaluationProfile{
+
+			struct Entry{
+				size_t Count{0};
+				double Seconds{0};
+			};
+
+			std::array<Entry, NumOperations> Double; //< Indexed by OpcodeIndex
+			std::array<Entry, NumOperations> Multiple; //< Indexed by OpcodeIndex
+			ProgramStatistics Program; //< Filled in by GetProfile
+
+			template<typename NumT>
+			std::array<Entry, NumOperations>& For(){
+				if constexpr (std::is_same<NumT,dbl_complex>::value)
+					return Double;
+				else
+					return Multiple;
+			}
+
+			void Clear(){
+				Double = {};
+				Multiple = {};
+			}
+
+			void WriteJSON(std::ostream & out) const;
+
+			friend std::ostream& operator<<(std::ostream& out, EvaluationProfile const& p);
+		};
+
+		/**
+		 \struct EvaluationState
+
+		 Which blocks of instructions have been run since the inputs last changed.
+
+		 The time-only block is tracked for each number type, since it stays run when only the space variables change.  Clear leaves it alone.
+		 */
+		struct EvaluationState{
+			bool Functions{false};
+			bool SharedDerivatives{false};
+			bool Jacobian{false};
+			bool TimeDeriv{false};
+			bool TimeStageDouble{false}; //< Whether the time-only block has been run in double precision, at the path variable now in memory
+			bool TimeStageMultiple{false}; //< The same, for multiple precision
+
+			template<typename NumT>
+			bool& TimeStage(){
+				return std::is_same<NumT,dbl_complex>::value ? TimeStageDouble : TimeStageMultiple;
+			}
+
+			void Clear(){
+				Functions = SharedDerivatives = Jacobian = TimeDeriv = false;
+			}
+
+			void SetAll(){
+				Functions = SharedDerivatives = Jacobian = TimeDeriv = true;
+			}
+
+			bool All() const{
+				return Functions && SharedDerivatives && Jacobian && TimeDeriv;
+			}
+
+			friend class boost::serialization::access;
+
+			template <typename Archive>
+			void serialize(Archive& ar, const unsigned version) {
+				ar & Functions;
+				ar & SharedDerivatives;
+				ar & Jacobian;
+				ar & TimeDeriv;
+				ar & TimeStageDouble;
+				ar & TimeStageMultiple;
+			}
+		};
+
+
+		/**
+		 \struct BatchMemory
+
+		 Memory for evaluating many points at once.  The value at location `loc` for point `p` is at `loc*NumPoints + p`, so the values for all points are contiguous and the loop over points vectorizes.  In double precision the real and imaginary parts are kept in separate arrays, for the same reason.
+		 */
+		struct BatchMemory{
+			size_t NumPoints{0};
+			unsigned Precision{0}; //< The precision of the multiple precision values, so they can be changed when the SLP's changes
+
+			std::vector<double> Real;
+			std::vector<double> Imag;
+			std::vector<double> ScratchReal; //< One location's worth, for IntPower
+			std::vector<double> ScratchImag;
+
+			std::vector<mpfr_complex> Multiple;
+		};
+
+		/**
+		 \struct RunningErrorMemory
+
+		 Memory for EvalErrorBounds: a value in double precision for each location, and a bound on its error.
+		 */
+		struct RunningErrorMemory{
+			std::vector<dbl_complex> Values;
+			std::vector<double> Bounds;
+		};
+
+		/**
+		 \struct Workspace
+
+		 Everything evaluating a program writes to: its memory, which blocks of instructions have been run, the precision, and the memory for batches.  The rest of a StraightLineProgram is left alone by evaluation, so one compiled program can be shared by many threads, each evaluating it with its own workspace, made by MakeWorkspace.
+
+		 The overloads of the evaluation functions not taking a workspace use the program's own, for the usual case of one thread.
+		 */
+		struct Workspace{
+			unsigned Precision{16}; //< The current working number of digits of the multiple precision memory
+			std::tuple< std::vector<dbl_complex>, std::vector<mpfr_complex> > Memory; //< Numbers and variables, plus temp results and output locations.  It's all one block.  That's why it's called a SLP!
+			EvaluationState Evaluated; //< Which blocks have been evaluated at the current input values
+			BatchMemory Batch; //< For EvalBatch.  Not serialized.
+			RunningErrorMemory RunningError; //< For EvalErrorBounds.  Not serialized.
+			bool Profiling{false}; //< Whether to record an EvaluationProfile.  Not serialized.
+			EvaluationProfile Profile; //< Not serialized.
+
+			template<typename NumT>
+			std::vector<NumT>& GetMemory(){
+				return std::get<std::vector<NumT>>(Memory);
+			}
+
+			template<typename NumT>
+			std::vector<NumT> const& GetMemory() const{
+				return std::get<std::vector<NumT>>(Memory);
+			}
+		};
+
 		/**
 		The constructor -- how to make a SLP from a System.
 		*/
@@ -270,14 +606,27 @@ namespace bertini {
 
 		StraightLineProgram() = default;
 
+		/**
+		 \brief Make a workspace for evaluating this program, with the numbers in its memory.  It's safe to make workspaces from many threads at once.
+
+		 \param precision The precision of its multiple precision memory.
+		 */
+		Workspace MakeWorkspace(unsigned precision = DefaultPrecision()) const;
+
 		template<typename Derived>
 		void Eval(Eigen::MatrixBase<Derived> const& variable_values) const
+		{
+			Eval(workspace_, variable_values);
+		}
+
+		template<typename Derived>
+		void Eval(Workspace & w, Eigen::MatrixBase<Derived> const& variable_values) const
 		{
 
 			using NumT = typename Derived::Scalar;
-			SetVariableValues(variable_values);
+			SetVariableValues(w, variable_values);
 
-			Eval<NumT>();
+			Eval<NumT>(w);
 
 
 		}
@@ -296,14 +645,20 @@ namespace bertini {
 		 */
 		template<typename Derived, typename ComplexT>
 		void Eval(Eigen::MatrixBase<Derived> const& variable_values, ComplexT const& time) const
+		{
+			Eval(workspace_, variable_values, time);
+		}
+
+		template<typename Derived, typename ComplexT>
+		void Eval(Workspace & w, Eigen::MatrixBase<Derived> const& variable_values, ComplexT const& time) const
 		{
 			using NumT = typename Derived::Scalar;
 			static_assert(std::is_same<NumT, ComplexT>::value, "scalar types must be the same");
 
 			// 1. copy variable values into memory locations they're supposed to go in
-			SetVariableValues(variable_values);
-			SetPathVariable(time);
-			Eval<NumT>();
+			SetVariableValues(w, variable_values);
+			SetPathVariable(w, time);
+			Eval<NumT>(w);
 		}
 
 
@@ -317,29 +672,71 @@ namespace bertini {
 		todo: implement a compile-time version of this using Boost.Hana
 		 */
 		template<typename NumT>
-		void Eval() const;  // this definition is in cpp, along with the lines that instantiate the needed versions.
+		void Eval() const{ Eval<NumT>(workspace_);}
 
+		template<typename NumT>
+		void Eval(Workspace & w) const;  // this definition is in cpp, along with the lines that instantiate the needed versions.
 
 
-		// a placeholder function that needs to be written.  now just calls eval, since the eval functionality is both functions and jacobian wrapped together -- we don't keep arrays of their locations separately yet, so that would be the starting point.
+
+		/**
+		\brief Evaluate only the functions, running only the instructions they depend on.
+
+		\tparam T numeric type
+		 */
 		template <typename T>
-		void EvalFunctions() const{
-			this->Eval<T>();
+		void EvalFunctions() const{ EvalFunctions<T>(workspace_);}
+
+		template <typename T>
+		void EvalFunctions(Workspace & w) const{
+			if (w.Evaluated.Functions)
+				return;
+
+			EvalTimeStage<T>(w);
+			EvalRange<T>(w, instruction_ranges_.TimeOnlyEnd, instruction_ranges_.FunctionsEnd);
+			w.Evaluated.Functions = true;
 		}
 
 
+		/**
+		\brief Evaluate the Jacobian.  
+
+		Also evaluates the functions, because the derivatives share most of their work with them, and the Newton corrector asks for both at the same point anyway.
+
+		\tparam T numeric type
+		 */
+		template <typename T>
+		void EvalJacobian() const{ EvalJacobian<T>(workspace_);}
 
-		// a placeholder function that needs to be written.  now just calls eval, since the eval functionality is both functions and jacobian wrapped together -- we don't keep arrays of their locations separately yet, so that would be the starting point.
 		template <typename T>
-		void EvalJacobian() const{
-			this->Eval<T>();
+		void EvalJacobian(Workspace & w) const{
+			if (w.Evaluated.Jacobian)
+				return;
+
+			EvalSharedDerivatives<T>(w);
+			EvalRange<T>(w, instruction_ranges_.SharedDerivativesEnd, instruction_ranges_.JacobianEnd);
+			w.Evaluated.Jacobian = true;
 		}
 
 
-		// a placeholder function that needs to be written.  now just calls eval, since the eval functionality is both functions and jacobian wrapped together -- we don't keep arrays of their locations separately yet, so that would be the starting point.
+		/**
+		\brief Evaluate the derivatives with respect to the path variable.
+
+		Also evaluates the functions, for the same reason as EvalJacobian.
+
+		\tparam T numeric type
+		 */
+		template <typename T>
+		void EvalTimeDeriv() const{ EvalTimeDeriv<T>(workspace_);}
+
 		template <typename T>
-		void EvalTimeDeriv() const{
-			this->Eval<T>();
+		void EvalTimeDeriv(Workspace & w) const{
+			if (w.Evaluated.TimeDeriv)
+				return;
+
+			EvalSharedDerivatives<T>(w);
+			EvalRange<T>(w, instruction_ranges_.JacobianEnd, instruction_ranges_.TimeDerivEnd);
+			w.Evaluated.TimeDeriv = true;
 		}
 
 
@@ -355,10 +752,14 @@ namespace bertini {
 		 */
 		template<typename NumT>
 		void GetFuncValsInPlace(Vec<NumT> & result) const{
-			if (!is_evaluated_)
-				this->EvalFunctions<NumT>();
+			GetFuncValsInPlace(workspace_, result);
+		}
+
+		template<typename NumT>
+		void GetFuncValsInPlace(Workspace & w, Vec<NumT> & result) const{
+			this->EvalFunctions<NumT>(w);
 
-			auto& memory =  std::get<std::vector<NumT>>(memory_);
+			auto& memory = w.GetMemory<NumT>();
 
 			// copy content
 			for (int ii = 0; ii < number_of_.Functions; ++ii) {
@@ -379,10 +780,14 @@ namespace bertini {
 
 		template<typename NumT>
 		void GetJacobianInPlace(Mat<NumT> & result) const{
-			if (!is_evaluated_)
-				this->EvalJacobian<NumT>();
+			GetJacobianInPlace(workspace_, result);
+		}
 
-			auto& memory =  std::get<std::vector<NumT>>(memory_);
+		template<typename NumT>
+		void GetJacobianInPlace(Workspace & w, Mat<NumT> & result) const{
+			this->EvalJacobian<NumT>(w);
+
+			auto& memory = w.GetMemory<NumT>();
 		
 			// copy content
 			for (int jj =0; jj < number_of_.Variables; ++jj) {
@@ -405,10 +810,14 @@ namespace bertini {
 
 		template<typename NumT>
 		void GetTimeDerivInPlace(Vec<NumT> & result) const{
-			if (!is_evaluated_)
-				this->EvalTimeDeriv<NumT>();
+			GetTimeDerivInPlace(workspace_, result);
+		}
 
-			auto& memory =  std::get<std::vector<NumT>>(memory_);
+		template<typename NumT>
+		void GetTimeDerivInPlace(Workspace & w, Vec<NumT> & result) const{
+			this->EvalTimeDeriv<NumT>(w);
+
+			auto& memory = w.GetMemory<NumT>();
 			// 1. make container, size correctly.
 			// 2. copy content
 			for (int ii = 0; ii < number_of_.Functions; ++ii) {
@@ -424,8 +833,13 @@ namespace bertini {
 		 */
 		template<typename NumT>
 		Vec<NumT> GetFuncVals() const{
+			return GetFuncVals<NumT>(workspace_);
+		}
+
+		template<typename NumT>
+		Vec<NumT> GetFuncVals(Workspace & w) const{
 			Vec<NumT> return_me(this->NumFunctions());
-			GetFuncValsInPlace(return_me);
+			GetFuncValsInPlace(w, return_me);
 			return return_me;
 		}
 		/**
@@ -436,8 +850,13 @@ namespace bertini {
 		 */
 		template<typename NumT>
 		Mat<NumT> GetJacobian() const{
+			return GetJacobian<NumT>(workspace_);
+		}
+
+		template<typename NumT>
+		Mat<NumT> GetJacobian(Workspace & w) const{
 			Mat<NumT> return_me(this->NumFunctions(), this->NumVariables());
-			GetJacobianInPlace(return_me);
+			GetJacobianInPlace(w, return_me);
 			return return_me;
 		}
 		/**
@@ -448,16 +867,246 @@ namespace bertini {
 		 */
 		template<typename NumT>
 		Vec<NumT> GetTimeDeriv() const{
+			return GetTimeDeriv<NumT>(workspace_);
+		}
+
+		template<typename NumT>
+		Vec<NumT> GetTimeDeriv(Workspace & w) const{
 			Vec<NumT> return_me(this->NumFunctions());
-			GetTimeDerivInPlace(return_me);
+			GetTimeDerivInPlace(w, return_me);
+			return return_me;
+		}
+
+
+		/**
+		\brief Evaluate the functions and all the derivatives at many points, in one pass over the instructions.
+
+		Get the results using GetFuncValsBatch, GetJacobianBatch, and GetTimeDerivBatch.  Evaluating a batch does not disturb the values from evaluating a single point, and vice versa.
+
+		\param variable_values The points, one per column.
+
+		\tparam NumT numeric type
+		 */
+		template<typename NumT>
+		void EvalBatch(Mat<NumT> const& variable_values) const{
+			EvalBatch(workspace_, variable_values);
+		}
+
+		template<typename NumT>
+		void EvalBatch(Workspace & w, Mat<NumT> const& variable_values) const;  // this definition is in cpp, along with the lines that instantiate the needed versions.
+
+		/**
+		\brief Evaluate the functions and all the derivatives at many points and path variable values, in one pass over the instructions.
+
+		\param variable_values The points, one per column.
+		\param times The values of the path variable, one per point.
+
+		\tparam NumT numeric type
+		 */
+		template<typename NumT>
+		void EvalBatch(Mat<NumT> const& variable_values, Vec<NumT> const& times) const{
+			EvalBatch(workspace_, variable_values, times);
+		}
+
+		template<typename NumT>
+		void EvalBatch(Workspace & w, Mat<NumT> const& variable_values, Vec<NumT> const& times) const;  // this definition is in cpp, along with the lines that instantiate the needed versions.
+
+		/**
+		\brief copies the values of the functions at each point of the last batch into the given matrix, one column per point
+
+		the function will NOT automatically resize your matrix for you to be the correct size
+		 */
+		template<typename NumT>
+		void GetFuncValsBatchInPlace(Mat<NumT> & result) const{
+			GetFuncValsBatchInPlace(workspace_, result);
+		}
+
+		template<typename NumT>
+		void GetFuncValsBatchInPlace(Workspace const& w, Mat<NumT> & result) const;
+
+		/**
+		\brief copies the Jacobian at each point of the last batch into the given matrices, one per point
+
+		the function will NOT automatically resize your vector or matrices for you to be the correct size
+		 */
+		template<typename NumT>
+		void GetJacobianBatchInPlace(std::vector<Mat<NumT>> & result) const{
+			GetJacobianBatchInPlace(workspace_, result);
+		}
+
+		template<typename NumT>
+		void GetJacobianBatchInPlace(Workspace const& w, std::vector<Mat<NumT>> & result) const;
+
+		/**
+		\brief copies the time derivatives at each point of the last batch into the given matrix, one column per point
+
+		the function will NOT automatically resize your matrix for you to be the correct size
+		 */
+		template<typename NumT>
+		void GetTimeDerivBatchInPlace(Mat<NumT> & result) const{
+			GetTimeDerivBatchInPlace(workspace_, result);
+		}
+
+		template<typename NumT>
+		void GetTimeDerivBatchInPlace(Workspace const& w, Mat<NumT> & result) const;
+
+		template<typename NumT>
+		Mat<NumT> GetFuncValsBatch() const{
+			return GetFuncValsBatch<NumT>(workspace_);
+		}
+
+		template<typename NumT>
+		Mat<NumT> GetFuncValsBatch(Workspace const& w) const{
+			Mat<NumT> return_me(this->NumFunctions(), w.Batch.NumPoints);
+			GetFuncValsBatchInPlace(w, return_me);
+			return return_me;
+		}
+
+		template<typename NumT>
+		std::vector<Mat<NumT>> GetJacobianBatch() const{
+			return GetJacobianBatch<NumT>(workspace_);
+		}
+
+		template<typename NumT>
+		std::vector<Mat<NumT>> GetJacobianBatch(Workspace const& w) const{
+			std::vector<Mat<NumT>> return_me(w.Batch.NumPoints, Mat<NumT>(this->NumFunctions(), this->NumVariables()));
+			GetJacobianBatchInPlace(w, return_me);
+			return return_me;
+		}
+
+		template<typename NumT>
+		Mat<NumT> GetTimeDerivBatch() const{
+			return GetTimeDerivBatch<NumT>(workspace_);
+		}
+
+		template<typename NumT>
+		Mat<NumT> GetTimeDerivBatch(Workspace const& w) const{
+			Mat<NumT> return_me(this->NumFunctions(), w.Batch.NumPoints);
+			GetTimeDerivBatchInPlace(w, return_me);
 			return return_me;
 		}
 
+		/**
+		\brief The number of points in the last batch evaluated.
+		*/
+		inline size_t BatchSize() const{ return workspace_.Batch.NumPoints;}
+
+
+		/**
+		\brief Evaluate the functions and all the derivatives in double precision, carrying a bound on the error in every value along, and return the bounds on the outputs.
+
+		This is running error analysis, to first order: each instruction's bound is made from its operands', times how much the operation can amplify them, plus a bound on its own rounding.  It costs a few times a plain evaluation, and is often much smaller than a bound made from the degrees and coefficients of the system, since it sees the actual point.
+
+		The values themselves are kept in the workspace's RunningErrorMemory, so this doesn't disturb a plain evaluation, and vice versa.
+
+		\param variable_values The values of the variables, taken as exact.
+		 */
+		ErrorBounds EvalErrorBounds(Vec<dbl_complex> const& variable_values) const{
+			return EvalErrorBounds(workspace_, variable_values);
+		}
+
+		ErrorBounds EvalErrorBounds(Workspace & w, Vec<dbl_complex> const& variable_values) const;
+
+		/**
+		\brief Evaluate in double precision with bounds on the error, at a value of the path variable.
+
+		\throws std::runtime_error if this program doesn't have a path variable.
+		 */
+		ErrorBounds EvalErrorBounds(Vec<dbl_complex> const& variable_values, dbl_complex const& time) const{
+			return EvalErrorBounds(workspace_, variable_values, time);
+		}
+
+		ErrorBounds EvalErrorBounds(Workspace & w, Vec<dbl_complex> const& variable_values, dbl_complex const& time) const;
+
+
+		/**
+		\brief Choose how to get from one instruction to the next.  The default is JIT; the others are there for comparison, and for debugging.
+		*/
+		void SetDispatchMethod(DispatchMethod method){ dispatch_method_ = method;}
+
+		DispatchMethod GetDispatchMethod() const{ return dispatch_method_;}
+
+
+		/**
+		\brief Write this program out as C++, to be compiled into a shared library and loaded with LoadNativeEvaluator.  See slp_codegen.hpp.
+
+		\param out Where to write the source.
+		\param multiple_precision Also write functions for mpfr_complex.  Without them the library only speeds up double precision evaluation.
+		*/
+		void GenerateCpp(std::ostream & out, bool multiple_precision = false) const;
+
+		/**
+		\brief A hash of the instructions and the sizes of things, identifying the program for code generated from it.
+		*/
+		std::string Fingerprint() const;
+
+		/**
+		\brief Evaluate using functions from a shared library compiled from the output of GenerateCpp, instead of interpreting the instructions.
+
+		\throws std::runtime_error if the library can't be loaded, or was generated from a different program.
+		*/
+		void LoadNativeEvaluator(std::string const& library);
+
+		/**
+		\brief Go back to interpreting the instructions.
+		*/
+		void UnloadNativeEvaluator();
+
+		bool HasNativeEvaluator() const{ return static_cast<bool>(native_evaluator_);}
+
+		/**
+		\brief Was machine code made for double precision evaluation?  If not, DispatchMethod::JIT is the same as DispatchMethod::Threaded.
+		*/
+		bool HasJIT() const{ return static_cast<bool>(jit_evaluator_);}
+
+		/**
+		\brief Write this program in the compact binary format.  See slp_binary.hpp.
+
+		\throws std::runtime_error if the stream fails.
+		*/
+		void WriteBinary(std::ostream & out) const;
+
+		/**
+		\brief Replace this program with one read from the binary format.  The program's own workspace is made fresh, at the default precision.
+
+		\throws std::runtime_error if what's read isn't a program in the current version of the format, or is corrupt.  This program is left alone then.
+		*/
+		void ReadBinary(std::istream & in);
 
 		inline unsigned NumFunctions() const{ return number_of_.Functions;}
 
 		inline unsigned NumVariables() const{ return number_of_.Variables;}
 
+		/**
+		\brief The number of instructions, the size of memory, and the longest chain of dependent instructions.
+		*/
+		ProgramStatistics GetProgramStatistics() const;
+
+		/**
+		\brief Turn profiling of evaluation in a workspace on or off.
+
+		While profiling, Eval interprets one instruction at a time, timing each, whatever the dispatch method or native evaluator.  The timer costs something, so the times of the cheap double precision operations are mostly the timer's.  Use the counts for those, and the times for comparing multiple precision operations.  Off, the only cost is one check per block of instructions.  Batch evaluation isn't profiled.
+		*/
+		void SetProfiling(Workspace & w, bool profiling) const{ w.Profiling = profiling;}
+
+		void SetProfiling(bool profiling) const{ SetProfiling(workspace_, profiling);}
+
+		/**
+		\brief What has been recorded while profiling in a workspace, since it was last cleared, along with the statistics of the program.
+		*/
+		EvaluationProfile GetProfile(Workspace const& w) const;
+
+		EvaluationProfile GetProfile() const{ return GetProfile(workspace_);}
+
+		void ClearProfile(Workspace & w) const{ w.Profile.Clear();}
+
+		void ClearProfile() const{ ClearProfile(workspace_);}
+
+		/**
+		\brief How much the compiler's optimization pass shrank this program.
+		*/
+		inline OptimizationStatistics const& GetOptimizationStatistics() const{ return optimization_statistics_;}
+
 
 		/**
 		\brief Get the current precision of the SLP.
@@ -467,17 +1116,24 @@ namespace bertini {
 		inline
 		unsigned precision() const
 		{
-			return precision_;
+			return workspace_.Precision;
 		}
 
 		/**
 		\brief change the precision of the SLP.
 
-		Downsamples from the true values.
+		Downsamples from the true values.  The numbers are evaluated from their nodes only when the new precision is higher than any before it, and are kept at that precision.  Going to a lower precision just rounds them, so the bouncing between precisions in adaptive precision tracking is cheap.
 
 		\param new_precision The new number of digits
 		*/
-		void precision(unsigned new_precision) const;
+		void precision(unsigned new_precision) const{
+			precision(workspace_, new_precision);
+		}
+
+		/**
+		\brief change the precision of a workspace.  Many threads can do this at once, each to its own workspace.
+		*/
+		void precision(Workspace & w, unsigned new_precision) const;
 
 		/**
 		 \brief Does this SLP have a path variable?
@@ -503,24 +1159,28 @@ namespace bertini {
 		 */
 		template<typename Derived>
 		void SetVariableValues(Eigen::MatrixBase<Derived> const& variable_values) const{
+			SetVariableValues(workspace_, variable_values);
+		}
+
+		template<typename Derived>
+		void SetVariableValues(Workspace & w, Eigen::MatrixBase<Derived> const& variable_values) const{
 			using NumT = typename Derived::Scalar;
 
 #ifndef BERTINI_DISABLE_PRECISION_CHECKS
-			if (!std::is_same<NumT,dbl_complex>::value && Precision(variable_values)!=this->precision_){
+			if (!std::is_same<NumT,dbl_complex>::value && Precision(variable_values)!=w.Precision){
 				std::stringstream err_msg;
-				err_msg << "variable_values and SLP must be of same precision.  respective precisions: " << Precision(variable_values) << " " << this->precision_ << std::endl;
+				err_msg << "variable_values and SLP must be of same precision.  respective precisions: " << Precision(variable_values) << " " << w.Precision << std::endl;
 				throw std::runtime_error(err_msg.str());
 			}
 #endif
 
-			using NumT = typename Derived::Scalar;
-			auto& memory =  std::get<std::vector<NumT>>(memory_); // unpack for local reference
+			auto& memory = w.GetMemory<NumT>(); // unpack for local reference
 
+			// in place, so the slots keep their precision, and multiple precision ones aren't reallocated
 			for (int ii = 0; ii < number_of_.Variables; ++ii) {
-				//assign  to memory
-				memory[ii + input_locations_.Variables] = variable_values(ii);
+				inplace::Assign(memory[ii + input_locations_.Variables], variable_values(ii));
 			}
-			is_evaluated_ = false;
+			w.Evaluated.Clear();
 		}
 
 		/**
@@ -530,14 +1190,21 @@ namespace bertini {
 		 \tparam ComplexT the complex numeric type.
 
 		 If the SLP doesn't have a path variable, then this will throw.
+
+		 Setting the same time again leaves the time-only instructions' results as they are, so they aren't run again.
 		 */
 		template<typename ComplexT>
 		void SetPathVariable(ComplexT const& time) const{
+			SetPathVariable(workspace_, time);
+		}
+
+		template<typename ComplexT>
+		void SetPathVariable(Workspace & w, ComplexT const& time) const{
 
 #ifndef BERTINI_DISABLE_PRECISION_CHECKS
-			if (Precision(time)!= DoublePrecision() && Precision(time)!=this->precision_){
+			if (Precision(time)!= DoublePrecision() && Precision(time)!=w.Precision){
 				std::stringstream err_msg;
-				err_msg << "time value and SLP must be of same precision.  respective precisions: " << Precision(time) << " " << this->precision_ << std::endl;
+				err_msg << "time value and SLP must be of same precision.  respective precisions: " << Precision(time) << " " << w.Precision << std::endl;
 				throw std::runtime_error(err_msg.str());
 			}
 #endif
@@ -546,10 +1213,14 @@ namespace bertini {
 				throw std::runtime_error("calling Eval with path variable, but this StraightLineProgram doesn't have one.");
 			// then actually copy the path variable into where it goes in memory
 
-			auto& memory =  std::get<std::vector<ComplexT>>(memory_); // unpack for local reference
+			auto& memory = w.GetMemory<ComplexT>(); // unpack for local reference
+
+			if (w.Evaluated.TimeStage<ComplexT>() && memory[input_locations_.Time]==time)
+				return;
 
-			memory[input_locations_.Time] = time;
-			is_evaluated_ = false;
+			inplace::Assign(memory[input_locations_.Time], time);
+			w.Evaluated.TimeStage<ComplexT>() = false;
+			w.Evaluated.Clear();
 		}
 
 
@@ -581,6 +1252,122 @@ namespace bertini {
 		void AddInstruction(Operation unary_op, size_t in_loc, size_t out_loc);
 
 
+		/**
+		 \brief Run the instructions in the half-open range [begin, end), using the chosen DispatchMethod.
+
+		 \tparam NumT numeric type
+		 \param begin Index of the first instruction to run.
+		 \param end Index one past the last instruction to run.
+		 */
+		template<typename NumT>
+		void EvalRange(Workspace & w, size_t begin, size_t end) const;  // this definition is in cpp, along with the lines that instantiate the needed versions.
+
+		/**
+		 \brief Run the instructions in the half-open range [begin, end) of the instruction stream, using a switch on the opcodes.
+
+		 \param begin Offset into the instruction stream of the first instruction to run.
+		 \param end Offset one past the last instruction to run.
+		 */
+		template<typename NumT>
+		void EvalRangeSwitch(Workspace & w, size_t begin, size_t end) const;
+
+		/**
+		 \brief Run the decoded instructions in the half-open range [begin, end), using threaded code.
+
+		 \param begin Index of the first instruction to run.
+		 \param end Index one past the last instruction to run.
+		 */
+		template<typename NumT>
+		void EvalRangeThreaded(Workspace & w, size_t begin, size_t end) const;
+
+		/**
+		 \brief Evaluate the instructions in [begin, end) one at a time, counting and timing each in the workspace's profile.
+		 */
+		template<typename NumT>
+		void EvalRangeProfiled(Workspace & w, size_t begin, size_t end) const;
+
+		/**
+		 \brief Fill in the decoded instructions from the instruction stream.
+		 */
+		void DecodeInstructions();
+
+		/**
+		 \brief Make the machine code for DispatchMethod::JIT from the decoded instructions, if this platform has a JIT.
+		 */
+		void CompileJIT();
+
+		/**
+		 \brief Run the block depending only on the numbers.  Everything read from it afterward keeps its slot, so it's run when the numbers are put into memory, and not again until they are next.
+
+		 Any other block may have reused its slots for temporaries, so they're all marked as not run.
+		 */
+		template<typename NumT>
+		void EvalConstantStage(Workspace & w) const{
+			EvalRange<NumT>(w, 0, instruction_ranges_.ConstantEnd);
+			w.Evaluated.TimeStage<NumT>() = false;
+			w.Evaluated.Clear();
+		}
+
+		/**
+		 \brief Run the block depending only on the path variable, if it hasn't been run at the current one.
+		 */
+		template<typename NumT>
+		void EvalTimeStage(Workspace & w) const{
+			if (w.Evaluated.TimeStage<NumT>())
+				return;
+
+			EvalRange<NumT>(w, instruction_ranges_.ConstantEnd, instruction_ranges_.TimeOnlyEnd);
+			w.Evaluated.TimeStage<NumT>() = true;
+		}
+
+		/**
+		 \brief Run the functions block and the block shared by the Jacobian and time derivatives, if not already done.
+		 */
+		template<typename NumT>
+		void EvalSharedDerivatives(Workspace & w) const{
+			EvalFunctions<NumT>(w);
+
+			if (w.Evaluated.SharedDerivatives)
+				return;
+
+			EvalRange<NumT>(w, instruction_ranges_.FunctionsEnd, instruction_ranges_.SharedDerivativesEnd);
+			w.Evaluated.SharedDerivatives = true;
+		}
+
+		/**
+		 \brief Size the batch memory for this many points, and copy the numbers into it.
+		 */
+		template<typename NumT>
+		void PrepareBatch(Workspace & w, size_t num_points) const;
+
+		/**
+		 \brief Put a value into the batch memory, at a location for a point.
+		 */
+		template<typename NumT>
+		static void SetBatchValue(BatchMemory & batch, size_t loc, size_t point, NumT const& value);
+
+		/**
+		 \brief Get a value from the batch memory, at a location for a point.
+		 */
+		template<typename NumT>
+		static NumT GetBatchValue(BatchMemory const& batch, size_t loc, size_t point);
+
+		/**
+		 \brief Run the instructions in the half-open range [begin, end) on every point in the batch memory.
+		 */
+		template<typename NumT>
+		void EvalBatchRange(BatchMemory & batch, size_t begin, size_t end) const;
+
+		/**
+		 \brief Set the variables in the running error memory, with the numbers and their bounds, ready for EvalRunningError.
+		 */
+		void PrepareRunningError(Workspace & w, Vec<dbl_complex> const& variable_values) const;
+
+		/**
+		 \brief Run all the instructions on the running error memory, and collect the bounds on the outputs.
+		 */
+		ErrorBounds EvalRunningError(RunningErrorMemory & memory) const;
+
 		/**
 		 \brief Add a number to the memory at location, and memoize it for precision changing later.
 		 */
@@ -588,28 +1375,51 @@ namespace bertini {
 
 		template<typename NumT>
 		auto& GetMemory() const{
-			return std::get<std::vector<NumT>>(this->memory_);
+			return workspace_.GetMemory<NumT>();
 		}
 
 
+		/**
+		 \brief Put the numbers into a workspace's memory, at its precision.
+		 */
 		template<typename NumT>
-		void CopyNumbersIntoMemory() const;
+		void CopyNumbersIntoMemory(Workspace & w) const;
+
+
+		/**
+		 \struct Numbers
 
+		 The values of the numbers in the program, shared by all its workspaces, and by copies of it.  Filled as needed, under the lock, since evaluating the nodes of the numbers isn't safe from more than one thread.
+		 */
+		struct Numbers{
+			std::mutex Mutex;
+			std::vector<dbl_complex> Double; //< In the order of `true_values_of_numbers_`
+			std::vector<mpfr_complex> Multiple; //< At the highest precision asked for so far.  Changing to a lower precision rounds these, instead of evaluating the nodes again.
+			unsigned HighestPrecision{0}; //< The precision of `Multiple`
+		};
 
-		mutable unsigned precision_ = 16; //< The current working number of digits
+
+		mutable Workspace workspace_; //< The program's own workspace, used by the overloads not taking one
 		bool has_path_variable_ = false; //< Does this SLP have a path variable?
 
 		NumberOf number_of_;  //< Quantities of things
 		OutputLocations output_locations_; //< Where to find outputs, like functions and derivatives
 		InputLocations input_locations_; //< Where to find inputs, like variables and time
 
-		mutable std::tuple< std::vector<dbl_complex>, std::vector<mpfr_complex> > memory_; //< The memory of the object.  Numbers and variables, plus temp results and output locations.  It's all one block.  That's why it's called a SLP!
+		size_t memory_size_{0}; //< How many numbers are in the memory of a workspace
 		std::vector<IntT> integers_;
 
 		std::vector<size_t> instructions_; //< The instructions.  The opcodes are  stored as size_t's, as well as the locations of operands and results.
+		InstructionRanges instruction_ranges_; //< Where the blocks for functions and derivatives start and stop in `instructions_`
+		std::vector<Instruction> decoded_instructions_; //< The same instructions, decoded.  Not serialized, since it's made from `instructions_`.
+		std::vector<size_t> instruction_offsets_; //< Where each instruction starts in `instructions_`, plus one past the end.
+		DispatchMethod dispatch_method_ = DispatchMethod::JIT; //< How to get from one instruction to the next
+		std::shared_ptr<const JITEvaluator> jit_evaluator_; //< Machine code for the blocks of instructions, in double precision.  Not serialized, it's remade when loading.
+		std::shared_ptr<const NativeEvaluator> native_evaluator_; //< Compiled versions of the blocks of instructions, if loaded.  Not serialized, since it's a handle to a loaded library.
 		std::vector< std::pair<Nd,size_t> > true_values_of_numbers_; //< the size_t is where in memory to downsample to.
+		std::shared_ptr<Numbers> numbers_ = std::make_shared<Numbers>(); //< Not serialized, since it's remade as needed
+		OptimizationStatistics optimization_statistics_; //< Sizes of the program before and after optimization
 
-		mutable bool is_evaluated_ = false;
 
 
 
@@ -618,21 +1428,33 @@ namespace bertini {
 		template <typename Archive>
 		void serialize(Archive& ar, const unsigned version) {
 
-			ar & precision_;
+			ar & workspace_.Precision;
 			ar & has_path_variable_;
 
 			ar & number_of_;
 			ar & output_locations_;
 			ar & input_locations_;
 
-			ar & std::get<std::vector<dbl_complex>>(memory_);
-			ar & std::get<std::vector<mpfr_complex>>(memory_);
+			ar & workspace_.GetMemory<dbl_complex>();
+			ar & workspace_.GetMemory<mpfr_complex>();
+			if (Archive::is_loading::value)
+				memory_size_ = workspace_.GetMemory<dbl_complex>().size();
 			ar & integers_;
 			
 			ar & instructions_;
+			if (Archive::is_loading::value)
+				DecodeInstructions();
+			ar & instruction_ranges_;
+			ar & dispatch_method_;
 			ar & true_values_of_numbers_;
+			if (Archive::is_loading::value)
+				numbers_ = std::make_shared<Numbers>(); // don't share the values of whatever program was here before
+			ar & optimization_statistics_;
+
+			ar & workspace_.Evaluated;
 
-			ar & is_evaluated_;
+			if (Archive::is_loading::value)
+				CompileJIT(); // needs the instruction ranges, too
 		}
 
 	};
@@ -651,6 +1473,8 @@ namespace bertini {
 			public Visitor<node::Function>,
 			public Visitor<node::Jacobian>,
 			public Visitor<node::Differential>,
+			public Visitor<node::LinearProduct>,
+			public Visitor<node::DiffLinear>,
 
 			// arithmetic
 			public Visitor<node::SumOperator>,
@@ -673,8 +1497,6 @@ namespace bertini {
 			public Visitor<node::special_number::Pi>,
 			public Visitor<node::special_number::E>
 
-			// also missing -- linears and difflinears.
-
 			// these abstract base types left out,
 
 			// but commented here to explain why
@@ -686,11 +1508,50 @@ namespace bertini {
 	private:
 		using Nd = std::shared_ptr<const node::Node>;
 		using SLP = StraightLineProgram;
+		using IntT = int;  // this needs to co-vary on the stored type inside the node.  node should stop using mpz, it's slow.
 
 		public:
 
 			SLP Compile(System const& sys);
 
+			/**
+			 \brief Choose how the Jacobian and time derivatives are made.  The default is JacobianMethod::Symbolic.
+
+			 With any of the automatic differentiation methods, the compiler doesn't need the System's symbolic derivatives, and doesn't ask for them.
+			 */
+			void SetJacobianMethod(JacobianMethod method){ jacobian_method_ = method;}
+
+			JacobianMethod GetJacobianMethod() const{ return jacobian_method_;}
+
+			/**
+			 \brief Forward mode needs a sweep per input, reverse mode a sweep per function.  Pick whichever is fewer, preferring forward mode on a tie, since it doesn't need to go backwards.
+
+			 \param num_functions The number of functions.
+			 \param num_inputs The number of variables, plus one if there's a path variable.
+			 */
+			static JacobianMethod ChooseAutomaticDifferentiationMode(size_t num_functions, size_t num_inputs);
+
+			/**
+			 \brief Choose how sums and products are made into instructions.  The default is ReductionMethod::Pairwise.
+			 */
+			void SetReductionMethod(ReductionMethod method){ reduction_method_ = method;}
+
+			ReductionMethod GetReductionMethod() const{ return reduction_method_;}
+
+			/**
+			 \brief Choose how polynomial systems are made into instructions.  The default is PolynomialMethod::SparseMonomial.
+			 */
+			void SetPolynomialMethod(PolynomialMethod method){ polynomial_method_ = method;}
+
+			PolynomialMethod GetPolynomialMethod() const{ return polynomial_method_;}
+
+			/**
+			 \brief Choose whether to fuse instructions into the specialized operations FMA, Square, ScaleByInt and MulAddConst after optimizing.  The default is to fuse them.
+			 */
+			void SetFuseInstructions(bool fuse){ fuse_instructions_ = fuse;}
+
+			bool GetFuseInstructions() const{ return fuse_instructions_;}
+
 
 			// IF YOU ADD A THING HERE, YOU MUST ADD IT ABOVE AND IN THE CPP SOURCE
 
@@ -702,6 +1563,8 @@ namespace bertini {
 			virtual void Visit(node::Function const& n);
 			virtual void Visit(node::Jacobian const& n);
 			virtual void Visit(node::Differential const& n);
+			virtual void Visit(node::LinearProduct const& n);
+			virtual void Visit(node::DiffLinear const& n);
 
 			// arithmetic
 			virtual void Visit(node::SumOperator const& n);
@@ -724,7 +1587,6 @@ namespace bertini {
 
 			virtual void Visit(node::special_number::Pi const& n);
 			virtual void Visit(node::special_number::E const& n);
-			// missing -- linear and difflinear
 		private:
 
 
@@ -738,6 +1600,136 @@ namespace bertini {
 						this->locations_encountered_nodes_[nd] = next_available_complex_++; // add to found symbols in the compiler, increment counter.
 			}
 
+			/**
+			 \brief Combine operands with an operation and its inverse, like addition and subtraction, in the order of the ReductionMethod.
+
+			 \param operands The locations of the operands.
+			 \param is_inverted For each operand, whether it's combined with the inverse operation, as in subtracted, or divided by.
+			 \param op Add or Multiply.
+			 \param inverse_op Subtract or Divide.
+
+			 \return The location of the result.
+			 */
+			size_t Reduce(std::vector<size_t> const& operands, std::vector<bool> const& is_inverted, Operation op, Operation inverse_op);
+
+			/**
+			 \brief A term of a sum, while compiling a polynomial: a product of powers of variables, times other factors, like numbers.
+			 */
+			struct Term{
+				std::map<size_t, IntT> powers; //< location of the variable --> exponent.  no zero exponents.
+				std::vector<Nd> coefficients; //< the factors which aren't powers of variables
+				bool is_subtracted = false;
+			};
+
+			/**
+			 \brief Split a factor of a term into powers of variables and other factors, looking through products.
+			 */
+			void CollectFactors(Nd const& n, Term & term);
+
+			/**
+			 \brief The location of a power of something in memory, from the power table, made if needed.
+
+			 x^k is (x^(k/2))^2, times x if k is odd, so making x^k makes at most two more entries in the table than x^(k/2) did.
+
+			 \param base The location of the thing being raised to the power.
+			 \param exponent A non-negative exponent.
+			 */
+			size_t PowerOf(size_t base, IntT exponent);
+
+			/**
+			 \brief The location of a product of powers, made if needed.  The product of the powers of all but the last variable is itself a monomial, so it's shared with every other monomial having those powers.
+			 */
+			size_t Monomial(std::map<size_t, IntT> powers);
+
+			/**
+			 \brief The sum of the terms, each made as its coefficients times its monomial.
+			 */
+			size_t SumOfTerms(std::vector<Term> const& terms);
+
+			/**
+			 \brief The sum of the terms, factored by the multivariate Horner rule.
+
+			 The variable appearing in the most terms is factored out of them, to its lowest power among them, and the two parts are factored in turn, until no variable appears in more than one term.
+			 */
+			size_t Horner(std::vector<Term> terms);
+
+			/**
+			 \brief Visit the nodes of derivatives with respect to one variable.
+
+			 Derivatives can depend on the variable of differentiation, through Differential and DiffLinear nodes, so the locations of the nodes visited are forgotten afterward.  Those of the nodes in the functions stay, and are shared by the derivatives with respect to every variable.
+
+			 \param variable The variable of differentiation.
+			 \param visit Does the visiting.
+			 */
+			template<typename VisitT>
+			void WithRespectTo(Nd const& variable, VisitT const& visit){
+				auto encountered = locations_encountered_nodes_;
+				current_diff_variable_ = variable;
+
+				visit();
+
+				current_diff_variable_.reset();
+				locations_encountered_nodes_ = std::move(encountered);
+			}
+
+			/**
+			 \brief Make the instructions for the Jacobian and time derivatives by automatic differentiation of the instructions compiled so far, which must be those for the functions.
+
+			 The instructions computing the functions write each location at most once, so each instruction's partial derivatives with respect to its operands can be computed once, and shared by every sweep.  Derivatives which are known to be 0, 1 or -1 are tracked without instructions.
+
+			 \param mode Either JacobianMethod::Forward or JacobianMethod::Reverse.
+			 \param inputs The locations of the variables, then of the path variable if there is one.
+			 */
+			void DifferentiateAutomatically(JacobianMethod mode, std::vector<size_t> const& inputs);
+
+			/**
+			 \brief The location of a number holding a small integer, made if needed.
+			 */
+			size_t LocationOfInteger(IntT value);
+
+			/**
+			 \brief The index among the SLP's integers of an exponent for IntPower, or a factor for ScaleByInt or MulAddConst, added if needed.
+			 */
+			size_t IndexOfExponent(IntT exponent);
+
+			/**
+			 \brief Shrink the compiled program, in place.
+
+			 In order, this
+			 
+			 1. merges numbers with the same value, 
+			 2. folds instructions whose operands are all numbers into new numbers, 
+			 3. merges instructions which compute the same operation on the same operands (common subexpression elimination), 
+			 4. removes copies into locations which aren't outputs, and makes the instruction computing an output write straight into its output location,
+			 5. removes instructions and numbers no output depends on, and
+			 6. renumbers memory so there are no holes in it.
+			 */
+			void Optimize();
+
+			/**
+			 \brief Combine instructions into the specialized operations, in place.  Must be run right after Optimize, while each temporary is still written exactly once.
+
+			 In order, this
+
+			 1. makes products of a location with itself, and integer powers 2, into Square, and products with a number which is a small integer into ScaleByInt, and
+			 2. makes a sum with a product which nothing else reads into a single FMA, or MulAddConst if the product was a ScaleByInt.
+			 */
+			void FuseInstructions();
+
+			/**
+			 \brief Reorder the compiled instructions into the blocks described by StraightLineProgram::InstructionRanges, dropping any instruction no output depends on.
+
+			 What an instruction depends on is found by following its operands back: to only numbers, it's in the constant block; to the path variable but not the space variables, in the time-only block.  Everything else goes by which outputs need it.
+			 */
+			void PartitionIntoBlocks();
+
+			/**
+			 \brief Give temporaries which are never alive at the same time the same slot in memory.
+
+			 Must be run after PartitionIntoBlocks, since the blocks can be run separately.  Temporaries read only in the block computing them are freed after their last read; temporaries read by a later block keep their slot.  The numbers are moved to just after the inputs and outputs.
+			 */
+			void ReuseMemory();
+
 			/**
 			 \brief Reset the compiler to compile another SLP from another system.
 			 */
@@ -745,12 +1737,20 @@ namespace bertini {
 
 			size_t next_available_complex_ = 0; //< Where should the next complex number go in memory?
 			size_t next_available_int_ = 0; //< Where should the next integer go?
-
-			using IntT = int;  // this needs to co-vary on the stored type inside the node.  node should stop using mpz, it's slow.
+			size_t first_temporary_location_ = 0; //< The first location in memory after the inputs and outputs.
+			Nd current_diff_variable_; //< What Differential and DiffLinear nodes are with respect to.  null when compiling the functions.
+			JacobianMethod jacobian_method_ = JacobianMethod::Symbolic; //< How to make the derivatives
+			ReductionMethod reduction_method_ = ReductionMethod::Pairwise; //< How to make sums and products
+			PolynomialMethod polynomial_method_ = PolynomialMethod::SparseMonomial; //< How to make polynomials
+			bool fuse_instructions_ = true; //< Whether to combine instructions into the specialized operations
+			bool is_polynomial_ = false; //< Whether the system being compiled is polynomial, so the PolynomialMethod applies
 
 			std::map<Nd, size_t> locations_encountered_nodes_; //< A registry of pointers-to-nodes and location in memory on where to find *their results*
 			std::map<IntT, size_t> locations_integers_;
+			std::map<IntT, size_t> locations_integer_numbers_; //< Where the integers the compiler makes for itself are in memory
 			std::map<Nd, size_t> locations_top_level_functions_and_derivatives_;
+			std::map<size_t, std::map<IntT, size_t>> power_tables_; //< location of a base --> exponent --> location of the power
+			std::map<std::map<size_t, IntT>, size_t> locations_monomials_; //< the powers in a monomial --> its location
 
 			SLP slp_under_construction_; //< the under-construction SLP.  will be returned at end of `compile`
 	};
@@ -65,8 +65,10 @@ namespace bertini {
 	enum class EvalMethod
 	{
 		FunctionTree, // using virtual methods and recursion
-		SLP // using straight line programs
+		SLP, // using straight line programs
 		    // now!  20230714, Eindhoven, Netherlands
+		NativeSLP, // a straight line program, compiled ahead of time into a shared library.  see System::SetNativeSLPLibrary
+		FlatTree // the function trees and their derivatives, flattened into one array of entries, evaluated in a loop.  see node::FlatTree
 	};
 
 	enum class DerivMethod
@@ -89,6 +91,11 @@ namespace bertini {
 	*/
 	bool DefaultAutoSimplify();
 
+	/**
+	\brief Get the default number of threads for differentiating a system.  0 means as many as the hardware has, for systems big enough to be worth it.
+	*/
+	unsigned DefaultNumDifferentiationThreads();
+
 	/**
 	\brief The fundamental polynomial system class for Bertini2.
 	
@@ -169,16 +176,19 @@ namespace bertini {
 		
 		/**
 		\brief Force re-evaluation of the system next eval of functions. If something has changed in the system, call this.
+
+		For function trees, this starts a new evaluation epoch (see node::NewEvaluationEpoch), which is O(1) rather than a walk over the trees.  It forgets the stored values in every tree evaluated on this thread, not just this system's, and none on other threads.
 		*/
 		void ResetFunctions() const
 		{
 			// TODO: it has the unfortunate side effect of resetting constant functions, too.
 			switch (eval_method_){
 			case EvalMethod::FunctionTree:
-				for (const auto& iter : functions_) 
-					iter->Reset();
+				node::NewEvaluationEpoch();
 				break;
 			case EvalMethod::SLP:
+			case EvalMethod::NativeSLP:
+			case EvalMethod::FlatTree:
 				// nothing
 				break;
 			}	
@@ -192,26 +202,15 @@ namespace bertini {
 		{
 			switch (eval_method_)
 			{
-				case EvalMethod::FunctionTree:{
-
-					switch (deriv_method_){
-						case DerivMethod::JacobianNode:
-						{
-							for (const auto& iter : jacobian_) 
-								iter->Reset();
-							break;
-						}
-						case DerivMethod::Derivatives:
-						{
-							for (const auto& iter : space_derivatives_) 
-								iter->Reset();
-							break;
-						}
-					}
-
+				case EvalMethod::FunctionTree:
+				{
+					// the space derivatives and the Jacobian nodes alike are stamped with the epoch
+					node::NewEvaluationEpoch();
 					break;
 				}
 				case EvalMethod::SLP:
+				case EvalMethod::NativeSLP:
+				case EvalMethod::FlatTree:
 				{
 					// nothing to do, it's not a resetting kind of thing.
 					break;					
@@ -224,26 +223,14 @@ namespace bertini {
 		{
 			switch (eval_method_)
 			{
-				case EvalMethod::FunctionTree:{
-					
-					switch (deriv_method_){
-						case DerivMethod::JacobianNode:
-						{
-							for (const auto& iter : jacobian_) 
-								iter->Reset();
-							break;
-						}
-						case DerivMethod::Derivatives:
-						{
-							for (const auto& iter : time_derivatives_) 
-								iter->Reset();
-							break;
-						}
-					}
-
+				case EvalMethod::FunctionTree:
+				{
+					node::NewEvaluationEpoch();
 					break;
 				}
 				case EvalMethod::SLP:
+				case EvalMethod::NativeSLP:
+				case EvalMethod::FlatTree:
 				{
 					// nothing to do, it's not a resetting kind of thing.
 					break;					
@@ -286,11 +273,22 @@ namespace bertini {
 					for (auto iter=functions_.begin(); iter!=functions_.end(); iter++, counter++) {
 						(*iter)->EvalInPlace<T>(function_values(counter));
 					}
+					break;
 				}
 
 				case EvalMethod::SLP:
+
+				case EvalMethod::NativeSLP:
 					{
 						slp_.GetFuncValsInPlace<T>(function_values);
+						break;
+					}
+
+				case EvalMethod::FlatTree:
+					{
+						for (unsigned ii(0); ii<NumNaturalFunctions(); ++ii)
+							function_values(ii) = flat_tree_.Output<T>(ii);
+						break;
 					}
 			}
 
@@ -504,10 +502,22 @@ namespace bertini {
 				} // function tree branch
 
 				case EvalMethod::SLP:
+
+				case EvalMethod::NativeSLP:
 				{
 					this->slp_.GetJacobianInPlace<T>(J); // the variable values should have been copied into place elsewhere.  that's not this function's responsibility.
 					break;					
 				}
+
+				case EvalMethod::FlatTree:
+				{
+					// the space derivatives follow the functions in the flat tree, column-major
+					const auto num_functions = NumNaturalFunctions();
+					for (int jj = 0; jj < NumVariables(); ++jj)
+						for (int ii = 0; ii < num_functions; ++ii)
+							J(ii,jj) = flat_tree_.Output<T>(num_functions + ii + jj*num_functions);
+					break;
+				}
 			}
 			
 			if (IsPatched())
@@ -793,10 +803,21 @@ namespace bertini {
 				} // function tree branch
 
 				case EvalMethod::SLP:
+
+				case EvalMethod::NativeSLP:
 				{
 					this->slp_.GetTimeDerivInPlace(ds_dt); // the variable values should have been copied into place elsewhere.  that's not this function's responsibility.
 					break;					
 				}
+
+				case EvalMethod::FlatTree:
+				{
+					// the time derivatives follow the space derivatives in the flat tree
+					const auto offset = NumNaturalFunctions()*(1+NumVariables());
+					for (int ii = 0; ii < NumNaturalFunctions(); ++ii)
+						ds_dt(ii) = flat_tree_.Output<T>(offset + ii);
+					break;
+				}
 			}
 
 			// the patch doesn't move with time.  derivatives 0.
@@ -991,11 +1012,18 @@ namespace bertini {
 					std::get<Vec<T> >(current_variable_values_) = new_values;
 					break;
 				}
-				case EvalMethod::SLP:{
+				case EvalMethod::SLP:
+				case EvalMethod::NativeSLP:{
 					std::get<Vec<T> >(current_variable_values_) = new_values; // if this isn't here, then patch evaluation breaks.
 					slp_.SetVariableValues(new_values);
 					break;
 				}
+				case EvalMethod::FlatTree:{
+					std::get<Vec<T> >(current_variable_values_) = new_values; // for the patch
+					for (int ii = 0; ii < new_values.size(); ++ii)
+						flat_tree_.SetInput(ii, new_values(ii));
+					break;
+				}
 			} // switch
 
 			
@@ -1025,9 +1053,16 @@ namespace bertini {
 					path_variable_->set_current_value(new_value);
 					break;
 				}
-				case EvalMethod::SLP:{
+				case EvalMethod::SLP:
+				case EvalMethod::NativeSLP:{
 					path_variable_->set_current_value(new_value);
 					slp_.SetPathVariable(new_value);
+					break;
+				}
+				case EvalMethod::FlatTree:{
+					path_variable_->set_current_value(new_value);
+					flat_tree_.SetInput(NumVariables(), new_value); // the path variable is the input after the variables
+					break;
 				}
 			}
 		}
@@ -1368,6 +1403,13 @@ namespace bertini {
 		 */
 		std::vector< Nd > GetTimeDerivatives() const;
 
+		/**
+		 \brief Get the Jacobian nodes of all functions
+
+		 These are as computed using the JacobianNode method.  Each is every derivative of its function, depending on the variable of differentiation it's evaluated with.  Stored in order of functions.
+		 */
+		std::vector< Jac > GetJacobianNodes() const;
+
 
 		//////////////////////
 		//
@@ -1576,15 +1618,164 @@ namespace bertini {
 		*/
 		void Simplify();
 
+		/**
+		\brief Choose whether to intern the nodes of the system when differentiating.  See InternNodes.  Off by default.
+		*/
+		void SetInternNodes(bool val)
+		{
+			intern_nodes_ = val;
+		}
+
+		/**
+		\brief Query whether the system interns its nodes when differentiating.
+		*/
+		auto IsInterningNodes() const
+		{
+			return intern_nodes_;
+		}
+
+		/**
+		\brief Set the arena the system makes its nodes in, when differentiating.  See node::NodeArena.  Pass nullptr for the heap, the default.
+
+		To have the nodes of the functions in the arena too, make them, or parse the system, while a node::NodeArena::Scope for it is around:
+
+		\code
+		auto arena = node::NodeArena::Make();
+		{
+			node::NodeArena::Scope scope(arena);
+			parsing::classic::parse(input.begin(), input.end(), sys);
+		}
+		sys.SetNodeArena(arena);
+		\endcode
+
+		The memory of the nodes is given back all at once, when the system, the arena and all the nodes are gone.
+		*/
+		void SetNodeArena(std::shared_ptr<node::NodeArena> const& arena)
+		{
+			node_arena_ = arena;
+		}
+
+		/**
+		\brief The arena the system makes its nodes in, or nullptr if it makes them on the heap.
+		*/
+		std::shared_ptr<node::NodeArena> GetNodeArena() const
+		{
+			return node_arena_;
+		}
+
+		/**
+		\brief Set how many threads differentiate the functions symbolically.
+
+		Each derivative, of one function with respect to one variable, is made by one thread, and goes in its own place, so the derivatives are the same no matter how many threads make them.  Simplifying and interning them afterwards is serial, as they share nodes with the functions.
+
+		\param num_threads The number of threads, including the calling one.  0 for as many as the hardware has, but only for systems with enough derivatives to be worth it.  1 for no other threads.
+		*/
+		void SetNumDifferentiationThreads(unsigned num_threads)
+		{
+			num_differentiation_threads_ = num_threads;
+		}
+
+		/**
+		\brief Get the number of threads set for differentiating.  0 means automatic.
+		*/
+		unsigned GetNumDifferentiationThreads() const
+		{
+			return num_differentiation_threads_;
+		}
+
+		/**
+		\brief Intern the nodes of the functions and derivatives of the system, all together, with a node::NodeFactory, so that each distinct subexpression is one node, stored and evaluated once.
+
+		The derivatives repeat a lot of the functions' subexpressions, and each other's.
+
+		\return The number of nodes replaced by an equal one.
+
+		\note This changes the children of nodes on which the system depends, though not their values.  Homogenize and the like before interning.
+		*/
+		size_t InternNodes() const;
+
 
 		/**  
 		 \brief Set  method being used for evaluation
 		 * */
 		void SetEvalMethod(EvalMethod method)
 		{
+			if (method != eval_method_)
+				is_differentiated_ = false; // whatever was prepared for the old method is no good for the new one
 			eval_method_ = method;
 		}
 
+		/**
+		 \brief Set the shared library to use with EvalMethod::NativeSLP.
+
+		 Make the library by compiling the output of GenerateNativeSLPSource.  Until one is set, EvalMethod::NativeSLP interprets the straight line program, same as EvalMethod::SLP.
+
+		 \throws std::runtime_error if the system is already differentiated for EvalMethod::NativeSLP, and the library doesn't load or is for a different program.
+		 */
+		void SetNativeSLPLibrary(std::string const& library);
+
+		std::string const& GetNativeSLPLibrary() const
+		{
+			return native_slp_library_;
+		}
+
+		/**
+		 \brief Whether this system evaluates with the compiled code of a native library, rather than interpreting its straight line program.  Differentiates the system first, if it isn't already.
+		 */
+		bool HasNativeSLPEvaluator() const;
+
+		/**
+		 \brief Keep the compiled straight line program in a directory, to be read back by later runs on the same system instead of differentiating and compiling again.  See slp_binary.hpp.
+
+		 The program is looked up by SLPCacheDescription when the system is differentiated for EvalMethod::SLP or EvalMethod::NativeSLP, and stored there after compiling, if it wasn't found.  Pass an empty string for no cache, which is the default.
+		 */
+		void SetSLPCacheDirectory(std::string const& directory)
+		{
+			slp_cache_directory_ = directory;
+		}
+
+		std::string const& GetSLPCacheDirectory() const
+		{
+			return slp_cache_directory_;
+		}
+
+		/**
+		 \brief What this system's straight line program is kept under in a cache.  The functions, with every digit of their numbers, the variable ordering and the options the compiled program depends on.  See SLPCache.
+		 */
+		std::string SLPCacheDescription() const;
+
+		/**
+		 \brief Write the straight line program for this system as C++, to be compiled into a library for EvalMethod::NativeSLP.
+
+		 \param out Where to write the source.
+		 \param multiple_precision Also write the functions for mpfr_complex.  See StraightLineProgram::GenerateCpp.
+		 */
+		void GenerateNativeSLPSource(std::ostream & out, bool multiple_precision = false) const;
+
+		/**
+		 \brief Whether this system can evaluate with running error bounds, that is, whether it's evaluated with a straight line program.  See EvalErrorBounds.
+		 */
+		bool CanEvalErrorBounds() const
+		{
+			return eval_method_==EvalMethod::SLP || eval_method_==EvalMethod::NativeSLP;
+		}
+
+		/**
+		 \brief Evaluate in double precision at a point, with a running bound on the error of every value, and get the bounds on the functions and derivatives.  See StraightLineProgram::EvalErrorBounds.
+
+		 Only the natural functions are bounded, not the patch.  The values this system gives from evaluating normally are left alone.
+
+		 \throws std::runtime_error if the system isn't evaluated with a straight line program.
+		 */
+		StraightLineProgram::ErrorBounds EvalErrorBounds(Vec<dbl> const& variable_values) const;
+
+		/**
+		 \brief Evaluate in double precision with running error bounds, at a value of the path variable.
+
+		 \throws std::runtime_error if the system isn't evaluated with a straight line program, or doesn't have a path variable.
+		 */
+		StraightLineProgram::ErrorBounds EvalErrorBounds(Vec<dbl> const& variable_values, dbl const& time) const;
+
 		/**  
 		 \brief Query the current method used for evaluation
 		 * */
@@ -1593,6 +1784,23 @@ namespace bertini {
 			return eval_method_;
 		}
 
+		/**
+		 \brief Set how the straight line program gets its Jacobian and time derivatives.
+
+		 With anything but JacobianMethod::Symbolic, the functions aren't differentiated symbolically at all when evaluating with an SLP.  Instead, the SLP compiler differentiates the program for the functions, by forward or reverse mode automatic differentiation.  Has no effect on EvalMethod::FunctionTree.
+		 */
+		void SetSLPJacobianMethod(JacobianMethod method)
+		{
+			if (method != slp_jacobian_method_)
+				is_differentiated_ = false;
+			slp_jacobian_method_ = method;
+		}
+
+		JacobianMethod GetSLPJacobianMethod() const
+		{
+			return slp_jacobian_method_;
+		}
+
 
 
 
@@ -1601,6 +1809,8 @@ namespace bertini {
 		 * */
 		void SetDerivMethod(DerivMethod method)
 		{
+			if (method != deriv_method_)
+				is_differentiated_ = false;
 			deriv_method_ = method;
 		}
 
@@ -1734,6 +1944,26 @@ namespace bertini {
 		void DifferentiateUsingDerivatives() const;
 		void DifferentiateUsingJacobianNode() const;
 
+		/**
+		 How many threads to make some number of derivatives with, from num_differentiation_threads_.
+		*/
+		unsigned NumDifferentiationThreads(size_t num_derivatives) const;
+
+		/**
+		 Flattens the functions and their derivatives into flat_tree_, for EvalMethod::FlatTree.
+
+		 The inputs are the variables, in order, then the path variable.  The outputs are the functions, then the space derivatives in column-major order, then the time derivatives.
+		*/
+		void FlattenTrees() const;
+
+		/**
+		 The method of differentiation actually used.  That's the one set with SetDerivMethod, except for EvalMethod::FlatTree, which flattens the derivatives one variable of differentiation at a time, so always uses DerivMethod::Derivatives.
+		*/
+		DerivMethod DifferentiationMethod() const
+		{
+			return eval_method_==EvalMethod::FlatTree ? DerivMethod::Derivatives : deriv_method_;
+		}
+
 		/**
 		 Puts together the ordering of variables, and stores it internally.
 		*/
@@ -1769,6 +1999,7 @@ namespace bertini {
 		mutable bool is_differentiated_ = false; ///< indicator for whether the jacobian tree has been populated.
 
 		mutable StraightLineProgram slp_; ///< The straight line program.  Is mutable since  it's a has-a, not is-a relationship.
+		mutable node::FlatTree flat_tree_; ///< The flattened functions and derivatives, for EvalMethod::FlatTree.
 
 		std::vector< VariableGroupType > time_order_of_variable_groups_;
 
@@ -1782,9 +2013,15 @@ namespace bertini {
 		bool assume_uniform_precision_ = false; ///< a bit, setting whether we can assume the system is in uniform precision.  if you are doing things that will allow pieces of the system to drift in terms of precision, then you should not assume this.  \see AssumeUniformPrecision
 
 		EvalMethod eval_method_ = DefaultEvalMethod(); ///< an enum class value, indicating which method of evaluation should be used.
+		std::string native_slp_library_; ///< The library with the compiled straight line program, for EvalMethod::NativeSLP
+		std::string slp_cache_directory_; ///< Where compiled straight line programs are cached between runs.  Empty for no cache.
+		JacobianMethod slp_jacobian_method_ = JacobianMethod::Symbolic; ///< How the SLP gets its derivatives.
 		DerivMethod deriv_method_ = DefaultDerivMethod(); ///< an enum class value, indicating which method of evaluation should be used.
 
 		bool auto_simplify_ = DefaultAutoSimplify();
+		bool intern_nodes_ = false; ///< whether to intern the nodes of the functions and derivatives when differentiating.  \see InternNodes
+		unsigned num_differentiation_threads_ = DefaultNumDifferentiationThreads(); ///< how many threads make the derivatives.  0 for automatic.  \see SetNumDifferentiationThreads
+		std::shared_ptr<node::NodeArena> node_arena_; ///< where the nodes made when differentiating go.  nullptr for the heap.  not serialized, as it's about memory, not the system.
 
 
 
@@ -1820,9 +2057,14 @@ namespace bertini {
 			ar & assume_uniform_precision_;
 
 			ar & eval_method_;
+			ar & native_slp_library_;
+			ar & slp_cache_directory_;
+			ar & slp_jacobian_method_;
 			ar & deriv_method_;
 
 			ar & auto_simplify_;
+			ar & intern_nodes_;
+			ar & num_differentiation_threads_;
 
 			// now for the cached / mutable things
 			ar & precision_;
@@ -1840,6 +2082,8 @@ namespace bertini {
 
 
 			ar & slp_; // does this need to be re-constructed after de-serialization?
+			if (Archive::is_loading::value && is_differentiated_ && eval_method_==EvalMethod::NativeSLP && !native_slp_library_.empty())
+				slp_.LoadNativeEvaluator(native_slp_library_); // the library handle isn't serialized
 
 			ar & time_order_of_variable_groups_;
 
@@ -1860,6 +2104,8 @@ namespace bertini {
 			// ar & std::get<Vec<dbl>>(current_variable_values_);
 			// ar & std::get<Vec<mpfr_complex>>(current_variable_values_);
 
+			if (Archive::is_loading::value && is_differentiated_ && eval_method_==EvalMethod::FlatTree)
+				FlattenTrees(); // the flat tree isn't serialized, since it's made from the trees
 		}
 
 
@@ -380,6 +380,17 @@ namespace bertini{
 				return current_precision_;
 			}
 
+
+			/**
+			\brief The AMP settings the criteria are checked against.
+
+			Those set for the tracker, except that when AdaptiveMultiplePrecisionConfig::use_evaluation_error_bounds is on, Phi and Psi are the ones measured at the current point by MeasureEvaluationError.
+			*/
+			PrecConf const& CriteriaConfig() const
+			{
+				return have_measured_error_ ? measured_config_ : Get<PrecConf>();
+			}
+
 			
 			/**
 			\brief Switch preservation of precision after tracking on / off
@@ -467,6 +478,7 @@ namespace bertini{
 					MultipleToMultiple(initial_precision_, start_point);
 				
 				ChangePrecision<upsample_refine_off>(initial_precision_);
+				MeasureEvaluationError();
 				
 				ResetCounters();
 
@@ -628,6 +640,7 @@ namespace bertini{
 				#endif
 
 				NotifyObservers(NewStep<EmitterType>(*this));
+				MeasureEvaluationError();
 
 				Vec<ComplexType>& predicted_space = std::get<Vec<ComplexType> >(temporary_space_); // this will be populated in the Predict step
 				Vec<ComplexType>& current_space = std::get<Vec<ComplexType> >(current_space_); // the thing we ultimately wish to update
@@ -894,6 +907,41 @@ namespace bertini{
 
 
 
+			/**
+			\brief Measure Phi and Psi at the current point, by evaluating the system in double precision with running error bounds, if the settings ask for it.
+
+			Phi and Psi are errors in units of the roundoff \f$10^{-P}\f$, so the bounds from double precision are scaled by \f$10^{16}\f$.  They hold for any precision to first order, since the error of every operation scales with the roundoff.  So the tracker can drop to double precision, and stay there, whenever the measured error allows, instead of whenever the bounds from the degrees and coefficients do.
+
+			Falls back to the configured values if the system isn't evaluated with a straight line program, or the point is too large for double precision.
+			*/
+			void MeasureEvaluationError() const
+			{
+				have_measured_error_ = false;
+				if (!Get<PrecConf>().use_evaluation_error_bounds || !GetSystem().CanEvalErrorBounds())
+					return;
+
+				Vec<dbl> space;
+				if (current_precision_==DoublePrecision())
+					space = std::get<Vec<dbl> >(current_space_);
+				else{
+					auto const& mp_space = std::get<Vec<mpfr_complex> >(current_space_);
+					space.resize(mp_space.size());
+					for (unsigned ii=0; ii<mp_space.size(); ii++)
+						space(ii) = dbl(mp_space(ii));
+				}
+
+				auto bounds = GetSystem().EvalErrorBounds(space, dbl(current_time_));
+				if (!std::isfinite(bounds.Functions) || !std::isfinite(bounds.Jacobian))
+					return;
+
+				const NumErrorT roundoff_units = std::pow(NumErrorT(10), NumErrorT(DoublePrecision()));
+				measured_config_ = Get<PrecConf>();
+				measured_config_.Phi = NumErrorT(bounds.Jacobian)*roundoff_units;
+				measured_config_.Psi = NumErrorT(bounds.Functions)*roundoff_units;
+				have_measured_error_ = true;
+			}
+
+
 			/**
 			\brief Get the raw right-hand side of Criterion B based on current state.
 			*/
@@ -905,7 +953,7 @@ namespace bertini{
 				           					  Get<NewtonConfig>().max_num_newton_iterations, 
 				           					  tracking_tolerance_, 
 				           					  this->size_proportion_, 
-				           					  Get<PrecConf>()), NumErrorT(0));
+				           					  CriteriaConfig()), NumErrorT(0));
 			}
 
 
@@ -945,7 +993,7 @@ namespace bertini{
 				return max(amp::CriterionCRHS(this->norm_J_inverse_, 
 				                              NumErrorT(std::get<Vec<ComplexType> > (current_space_).norm()), 
 				                              tracking_tolerance_, 
-				                              Get<PrecConf>()), NumErrorT(0));
+				                              CriteriaConfig()), NumErrorT(0));
 			}
 
 
@@ -1094,7 +1142,7 @@ namespace bertini{
 									num_steps_since_last_condition_number_computation_, 
 									Get<Stepping>().frequency_of_CN_estimation, 
 									tracking_tolerance_,
-									Get<PrecConf>());
+									CriteriaConfig());
 				else
 					return predictor_->Predict(predicted_space,
 									this->size_proportion_,
@@ -1107,7 +1155,7 @@ namespace bertini{
 									num_steps_since_last_condition_number_computation_, 
 									Get<Stepping>().frequency_of_CN_estimation, 
 									tracking_tolerance_,
-									Get<PrecConf>());
+									CriteriaConfig());
 			}
 
 
@@ -1149,7 +1197,7 @@ namespace bertini{
 									tracking_tolerance_,
 									Get<NewtonConfig>().min_num_newton_iterations,
 									Get<NewtonConfig>().max_num_newton_iterations,
-									Get<PrecConf>());
+									CriteriaConfig());
 			}
 
 
@@ -1224,7 +1272,7 @@ namespace bertini{
 										   tracking_tolerance_,
 										   Get<NewtonConfig>().min_num_newton_iterations,
 										   Get<NewtonConfig>().max_num_newton_iterations,
-										   Get<PrecConf>());
+										   CriteriaConfig());
 			}
 
 
@@ -1268,7 +1316,7 @@ namespace bertini{
 										tolerance,
 										1,
 										max_iterations,
-										Get<PrecConf>());
+										CriteriaConfig());
 			}
 
 
@@ -1628,6 +1676,9 @@ namespace bertini{
 
 			mutable mpfr_complex endtime_highest_precision_;
 
+			mutable bool have_measured_error_ = false; ///< Whether measured_config_ holds Phi and Psi measured at the current point.  See MeasureEvaluationError.
+			mutable AdaptiveMultiplePrecisionConfig measured_config_; ///< The AMP settings, with Phi and Psi as measured.
+
 		public:
 
 			unsigned CurrentPrecision() const override
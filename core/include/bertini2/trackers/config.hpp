@@ -173,6 +173,8 @@ namespace tracking{
 		unsigned consecutive_successful_steps_before_precision_decrease = 10;
 
 		unsigned max_num_precision_decreases = 10; ///< The maximum number of times precision can be lowered during tracking of a segment of path.
+
+		bool use_evaluation_error_bounds = false; ///< Whether to replace Phi and Psi, at every step, with bounds on the error measured by evaluating the system in double precision at the current point.  See System::EvalErrorBounds.  Only for systems evaluated with a straight line program; otherwise Phi and Psi are used as set.
 		
 
 		/**
@@ -231,6 +233,7 @@ namespace tracking{
 		out << "safety_digits_1: " << AMP.safety_digits_1 << "\n";
 		out << "safety_digits_2: " << AMP.safety_digits_2 << "\n";
 		out << "consecutive_successful_steps_before_precision_decrease" << AMP.consecutive_successful_steps_before_precision_decrease << "\n";
+		out << "use_evaluation_error_bounds: " << AMP.use_evaluation_error_bounds << "\n";
 		return out;
 	}
 
@@ -0,0 +1,289 @@
+//This file is part of Bertini 2.
+//
+//b2/core/src/function_tree/factory.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//b2/core/src/function_tree/factory.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with b2/core/src/function_tree/factory.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2021 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+//  silviana amethyst, university of wisconsin-eau claire
+
+
+
+#include "bertini2/function_tree/factory.hpp"
+
+#include <functional>
+#include <sstream>
+#include <typeinfo>
+
+namespace bertini {
+namespace node {
+
+	namespace {
+
+		// the nodes are visited as const, but they're the non-const nodes handed to Intern
+		std::shared_ptr<Node> Self(Node const& n)
+		{
+			return std::const_pointer_cast<Node>(n.shared_from_this());
+		}
+
+		/**
+		 \brief The type and exact value of a number, so that equal numbers are interned together.
+		 */
+		std::string NumberKind(Node const& n)
+		{
+			std::stringstream kind;
+			kind.precision(0); // Boost.Multiprecision prints every digit needed to reconstruct a value when asked for 0 digits
+			kind << typeid(n).name() << ':' << n;
+			return kind.str();
+		}
+	}
+
+
+	size_t NodeFactory::KeyHash::operator()(Key const& k) const
+	{
+		size_t h = std::hash<std::string>()(k.kind);
+		for (auto c : k.children)
+			h ^= std::hash<Node const*>()(c) + 0x9e3779b97f4a7c15ull + (h<<6) + (h>>2);
+		return h;
+	}
+
+
+	std::shared_ptr<Node> NodeFactory::Intern(std::shared_ptr<Node> const& n)
+	{
+		auto found = canonical_.find(n);
+		if (found!=canonical_.end())
+			return found->second;
+
+		n->Accept(*this);
+		return canonical_.at(n);
+	}
+
+
+	void NodeFactory::Keep(Node const& n)
+	{
+		auto self = Self(n);
+		canonical_[self] = self;
+	}
+
+
+	void NodeFactory::Record(Node const& n, Key key)
+	{
+		auto self = Self(n);
+
+		auto found = interned_.find(key);
+		if (found==interned_.end())
+		{
+			interned_.emplace(std::move(key), self);
+			canonical_[self] = self;
+		}
+		else
+		{
+			canonical_[self] = found->second;
+			++num_shared_;
+		}
+	}
+
+
+	void NodeFactory::VisitUnary(UnaryOperator const& n, std::string kind)
+	{
+		auto operand = n.Operand();
+		auto interned = Intern(operand);
+		if (interned!=operand)
+			const_cast<UnaryOperator&>(n).SetOperand(interned);
+
+		Record(n, Key{std::move(kind), {interned.get()}});
+	}
+
+
+	void NodeFactory::VisitNary(NaryOperator const& n, std::vector<bool> const& flags)
+	{
+		Key key{typeid(n).name(), {}};
+		key.kind.push_back(':');
+		for (bool f : flags)
+			key.kind.push_back(f ? '+' : '-');
+
+		for (size_t ii{0}; ii<n.NumOperands(); ++ii)
+		{
+			auto operand = n.Operands()[ii];
+			auto interned = Intern(operand);
+			if (interned!=operand)
+				const_cast<NaryOperator&>(n).SetOperand(ii, interned);
+			key.children.push_back(interned.get());
+		}
+
+		Record(n, std::move(key));
+	}
+
+
+
+	// symbols and roots
+
+	void NodeFactory::Visit(Variable const& n)
+	{
+		Keep(n);
+	}
+
+	void NodeFactory::Visit(Integer const& n)
+	{
+		Record(n, Key{NumberKind(n), {}});
+	}
+
+	void NodeFactory::Visit(Float const& n)
+	{
+		Record(n, Key{NumberKind(n), {}});
+	}
+
+	void NodeFactory::Visit(Rational const& n)
+	{
+		Record(n, Key{NumberKind(n), {}});
+	}
+
+	void NodeFactory::Visit(special_number::Pi const& n)
+	{
+		Record(n, Key{typeid(n).name(), {}});
+	}
+
+	void NodeFactory::Visit(special_number::E const& n)
+	{
+		Record(n, Key{typeid(n).name(), {}});
+	}
+
+	void NodeFactory::Visit(Function const& n)
+	{
+		auto entry = n.EntryNode();
+		auto interned = Intern(entry);
+		if (interned!=entry)
+			const_cast<Function&>(n).SetRoot(interned);
+		Keep(n);
+	}
+
+	void NodeFactory::Visit(Jacobian const& n)
+	{
+		auto entry = n.EntryNode();
+		auto interned = Intern(entry);
+		if (interned!=entry)
+			const_cast<Jacobian&>(n).SetRoot(interned);
+		Keep(n);
+	}
+
+	void NodeFactory::Visit(Differential const& n)
+	{
+		// variables are never merged, so the address of the variable is as good as the variable
+		Record(n, Key{typeid(n).name(), {n.GetVariable().get()}});
+	}
+
+	void NodeFactory::Visit(LinearProduct const& n)
+	{
+		Keep(n);
+	}
+
+	void NodeFactory::Visit(DiffLinear const& n)
+	{
+		Keep(n);
+	}
+
+
+
+	// arithmetic
+
+	void NodeFactory::Visit(SumOperator const& n)
+	{
+		VisitNary(n, n.GetSigns());
+	}
+
+	void NodeFactory::Visit(MultOperator const& n)
+	{
+		VisitNary(n, n.GetMultOrDiv());
+	}
+
+	void NodeFactory::Visit(IntegerPowerOperator const& n)
+	{
+		VisitUnary(n, std::string(typeid(n).name()) + '^' + std::to_string(n.exponent()));
+	}
+
+	void NodeFactory::Visit(PowerOperator const& n)
+	{
+		auto base = n.GetBase();
+		auto interned_base = Intern(base);
+		if (interned_base!=base)
+			const_cast<PowerOperator&>(n).SetBase(interned_base);
+
+		auto exponent = n.GetExponent();
+		auto interned_exponent = Intern(exponent);
+		if (interned_exponent!=exponent)
+			const_cast<PowerOperator&>(n).SetExponent(interned_exponent);
+
+		Record(n, Key{typeid(n).name(), {interned_base.get(), interned_exponent.get()}});
+	}
+
+	void NodeFactory::Visit(ExpOperator const& n)
+	{
+		VisitUnary(n, typeid(n).name());
+	}
+
+	void NodeFactory::Visit(LogOperator const& n)
+	{
+		VisitUnary(n, typeid(n).name());
+	}
+
+	void NodeFactory::Visit(NegateOperator const& n)
+	{
+		VisitUnary(n, typeid(n).name());
+	}
+
+	void NodeFactory::Visit(SqrtOperator const& n)
+	{
+		VisitUnary(n, typeid(n).name());
+	}
+
+
+
+	// the trig operators
+
+	void NodeFactory::Visit(SinOperator const& n)
+	{
+		VisitUnary(n, typeid(n).name());
+	}
+
+	void NodeFactory::Visit(ArcSinOperator const& n)
+	{
+		VisitUnary(n, typeid(n).name());
+	}
+
+	void NodeFactory::Visit(CosOperator const& n)
+	{
+		VisitUnary(n, typeid(n).name());
+	}
+
+	void NodeFactory::Visit(ArcCosOperator const& n)
+	{
+		VisitUnary(n, typeid(n).name());
+	}
+
+	void NodeFactory::Visit(TanOperator const& n)
+	{
+		VisitUnary(n, typeid(n).name());
+	}
+
+	void NodeFactory::Visit(ArcTanOperator const& n)
+	{
+		VisitUnary(n, typeid(n).name());
+	}
+
+} // namespace node
+} // namespace bertini
@@ -0,0 +1,482 @@
+//This file is part of Bertini 2.
+//
+//b2/core/src/function_tree/flat_tree.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//b2/core/src/function_tree/flat_tree.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with b2/core/src/function_tree/flat_tree.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2021 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+//  silviana amethyst, university of wisconsin-eau claire
+
+
+
+#include "bertini2/function_tree/flat_tree.hpp"
+#include "bertini2/function_tree.hpp"
+
+#include <algorithm>
+
+#include "bertini2/detail/visitor.hpp"
+
+namespace bertini {
+namespace node {
+
+namespace detail{
+
+	/**
+	 \brief Appends the entries for trees to a FlatTree, visiting each node once, children first.
+	 */
+	class FlatTreeBuilder : public VisitorBase,
+
+			// symbols and roots
+			public Visitor<Variable>,
+			public Visitor<Integer>,
+			public Visitor<Float>,
+			public Visitor<Rational>,
+			public Visitor<Function>,
+			public Visitor<Jacobian>,
+			public Visitor<Differential>,
+			public Visitor<LinearProduct>,
+			public Visitor<DiffLinear>,
+
+			// arithmetic
+			public Visitor<SumOperator>,
+			public Visitor<MultOperator>,
+			public Visitor<IntegerPowerOperator>,
+			public Visitor<PowerOperator>,
+			public Visitor<ExpOperator>,
+			public Visitor<LogOperator>,
+			public Visitor<NegateOperator>,
+			public Visitor<SqrtOperator>,
+
+			// the trig operators
+			public Visitor<SinOperator>,
+			public Visitor<ArcSinOperator>,
+			public Visitor<CosOperator>,
+			public Visitor<ArcCosOperator>,
+			public Visitor<TanOperator>,
+			public Visitor<ArcTanOperator>,
+
+			public Visitor<special_number::Pi>,
+			public Visitor<special_number::E>
+	{
+		using Kind = FlatTree::Kind;
+		using Location = std::uint32_t;
+
+	public:
+
+		FlatTreeBuilder(FlatTree & tree, std::shared_ptr<const Variable> const& diff_variable) : tree_(tree), diff_variable_(diff_variable)
+		{}
+
+		/**
+		 \brief The entry for a node, flattening it first if it hasn't been.
+		 */
+		Location LocationOf(std::shared_ptr<const Node> const& n)
+		{
+			auto found = tree_.locations_.find(n);
+			if (found!=tree_.locations_.end())
+				return found->second;
+
+			std::const_pointer_cast<Node>(n)->Accept(*this); // accepting doesn't change the node
+			return tree_.locations_.at(n);
+		}
+
+
+		// symbols and roots
+
+		void Visit(Variable const& n) override
+		{
+			throw std::runtime_error("flattening a tree with variable " + n.name() + ", which isn't an input of the FlatTree");
+		}
+
+		void Visit(Integer const& n) override
+		{
+			SetLocation(n, Constant(n.shared_from_this()));
+		}
+
+		void Visit(Float const& n) override
+		{
+			SetLocation(n, Constant(n.shared_from_this()));
+		}
+
+		void Visit(Rational const& n) override
+		{
+			SetLocation(n, Constant(n.shared_from_this()));
+		}
+
+		void Visit(special_number::Pi const& n) override
+		{
+			SetLocation(n, Constant(n.shared_from_this()));
+		}
+
+		void Visit(special_number::E const& n) override
+		{
+			SetLocation(n, Constant(n.shared_from_this()));
+		}
+
+		void Visit(Function const& n) override
+		{
+			SetLocation(n, LocationOf(n.EntryNode()));
+		}
+
+		void Visit(Jacobian const& n) override
+		{
+			SetLocation(n, LocationOf(n.EntryNode()));
+		}
+
+		void Visit(Differential const& n) override
+		{
+			// 1 for the variable of differentiation, 0 for every other
+			const bool is_current = diff_variable_ && n.GetVariable()==diff_variable_;
+			SetLocation(n, IntegerConstant(is_current ? 1 : 0));
+		}
+
+		void Visit(LinearProduct const& n) override
+		{
+			VariableGroup vars;
+			n.GetVariables(vars);
+			std::shared_ptr<Node> hom_var;
+			n.GetHomVariable(hom_var);
+
+			// each factor is c_0*x_0 + ... + c_{n-1}*x_{n-1} + c_n*h, where h is the homogenizing variable, or the integer 1 if there isn't one
+			std::vector<Location> factors;
+			for (size_t ii{0}; ii<n.NumFactors(); ++ii)
+			{
+				std::vector<Location> terms;
+				for (size_t jj{0}; jj<=vars.size(); ++jj)
+				{
+					const std::shared_ptr<Node> variable = jj<vars.size() ? vars[jj] : hom_var;
+					terms.push_back(Add(Kind::Product, {LocationOf(n.GetCoefficientNode(ii,jj)), LocationOf(variable)}));
+				}
+				factors.push_back(Add(Kind::Sum, terms));
+			}
+
+			SetLocation(n, factors.empty() ? IntegerConstant(1) : Add(Kind::Product, factors));
+		}
+
+		void Visit(DiffLinear const& n) override
+		{
+			// the coefficient of the variable of differentiation, or 0 if it's not in the linear
+			VariableGroup vars;
+			n.GetVariables(vars);
+			std::shared_ptr<Node> hom_var;
+			n.GetHomVariable(hom_var);
+
+			const std::shared_ptr<const Node> diff_variable = diff_variable_;
+			std::shared_ptr<Node> coefficient;
+			if (diff_variable)
+			{
+				auto found = std::find_if(vars.begin(), vars.end(), [&](auto const& v){ return v==diff_variable;});
+				if (found != vars.end())
+					coefficient = n.GetCoefficientNode(found - vars.begin());
+				else if (hom_var==diff_variable)
+					coefficient = n.GetCoefficientNode(vars.size());
+			}
+
+			SetLocation(n, coefficient ? LocationOf(coefficient) : IntegerConstant(0));
+		}
+
+
+		// arithmetic
+
+		void Visit(SumOperator const& n) override
+		{
+			VisitNary(n, n.GetSigns(), Kind::Sum, 0);
+		}
+
+		void Visit(MultOperator const& n) override
+		{
+			VisitNary(n, n.GetMultOrDiv(), Kind::Product, 1);
+		}
+
+		void Visit(IntegerPowerOperator const& n) override
+		{
+			SetLocation(n, Add(Kind::IntPower, {LocationOf(n.Operand())}, {}, n.exponent()));
+		}
+
+		void Visit(PowerOperator const& n) override
+		{
+			SetLocation(n, Add(Kind::Power, {LocationOf(n.GetBase()), LocationOf(n.GetExponent())}));
+		}
+
+		void Visit(ExpOperator const& n) override
+		{
+			VisitUnary(n, Kind::Exp);
+		}
+
+		void Visit(LogOperator const& n) override
+		{
+			VisitUnary(n, Kind::Log);
+		}
+
+		void Visit(NegateOperator const& n) override
+		{
+			VisitUnary(n, Kind::Negate);
+		}
+
+		void Visit(SqrtOperator const& n) override
+		{
+			VisitUnary(n, Kind::Sqrt);
+		}
+
+
+		// the trig operators
+
+		void Visit(SinOperator const& n) override
+		{
+			VisitUnary(n, Kind::Sin);
+		}
+
+		void Visit(ArcSinOperator const& n) override
+		{
+			VisitUnary(n, Kind::ArcSin);
+		}
+
+		void Visit(CosOperator const& n) override
+		{
+			VisitUnary(n, Kind::Cos);
+		}
+
+		void Visit(ArcCosOperator const& n) override
+		{
+			VisitUnary(n, Kind::ArcCos);
+		}
+
+		void Visit(TanOperator const& n) override
+		{
+			VisitUnary(n, Kind::Tan);
+		}
+
+		void Visit(ArcTanOperator const& n) override
+		{
+			VisitUnary(n, Kind::ArcTan);
+		}
+
+	private:
+
+		/**
+		 \brief Append an entry, whose children have already been flattened.
+
+		 \param adds Whether each child is added or multiplied.  Empty for all of them.
+		 */
+		Location Add(Kind kind, std::vector<Location> const& children = {}, std::vector<std::uint8_t> const& adds = {}, int exponent = 0)
+		{
+			tree_.entries_.push_back(FlatTree::Entry{kind, static_cast<Location>(tree_.children_.size()), static_cast<Location>(children.size()), exponent});
+			tree_.children_.insert(tree_.children_.end(), children.begin(), children.end());
+			if (adds.empty())
+				tree_.adds_.insert(tree_.adds_.end(), children.size(), 1);
+			else
+				tree_.adds_.insert(tree_.adds_.end(), adds.begin(), adds.end());
+			return static_cast<Location>(tree_.entries_.size()-1);
+		}
+
+		void SetLocation(Node const& n, Location location)
+		{
+			tree_.locations_[n.shared_from_this()] = location;
+		}
+
+		Location Constant(std::shared_ptr<const Node> const& n)
+		{
+			auto location = Add(Kind::Constant);
+			tree_.constants_.emplace_back(location, n);
+			return location;
+		}
+
+		Location IntegerConstant(int value)
+		{
+			auto found = tree_.integer_locations_.find(value);
+			if (found!=tree_.integer_locations_.end())
+				return found->second;
+
+			return tree_.integer_locations_[value] = Constant(Integer::Make(value));
+		}
+
+		void VisitUnary(UnaryOperator const& n, Kind kind)
+		{
+			SetLocation(n, Add(kind, {LocationOf(n.Operand())}));
+		}
+
+		/**
+		 \brief Flatten a sum or product.  The first child of the entry is always added or multiplied, so if the first operand isn't, the identity goes first.
+		 */
+		void VisitNary(NaryOperator const& n, std::vector<bool> const& flags, Kind kind, int identity)
+		{
+			std::vector<Location> children;
+			std::vector<std::uint8_t> adds;
+
+			if (flags.empty() || !flags[0])
+			{
+				children.push_back(IntegerConstant(identity));
+				adds.push_back(1);
+			}
+
+			for (size_t ii{0}; ii<n.NumOperands(); ++ii)
+			{
+				children.push_back(LocationOf(n.Operands()[ii]));
+				adds.push_back(flags[ii]);
+			}
+
+			SetLocation(n, Add(kind, children, adds));
+		}
+
+		FlatTree & tree_;
+		std::shared_ptr<const Variable> diff_variable_;
+	};
+
+} // namespace detail
+
+
+
+	void FlatTree::AddInput(std::shared_ptr<const Variable> const& v)
+	{
+		const auto location = static_cast<std::uint32_t>(entries_.size());
+		entries_.push_back(Entry{Kind::Input, static_cast<std::uint32_t>(children_.size()), 0, 0});
+		inputs_.push_back(location);
+		locations_[v] = location;
+
+		Grow();
+	}
+
+
+	void FlatTree::AddOutputs(std::vector<std::shared_ptr<Node>> const& roots, std::shared_ptr<const Variable> const& diff_variable)
+	{
+		// derivatives can depend on the variable of differentiation, through Differential and DiffLinear nodes, so the entries of their nodes aren't shared with trees added later
+		auto locations = diff_variable ? locations_ : decltype(locations_)();
+
+		detail::FlatTreeBuilder builder(*this, diff_variable);
+		for (auto const& r : roots)
+			outputs_.push_back(builder.LocationOf(r));
+
+		if (diff_variable)
+			locations_ = std::move(locations);
+
+		Grow();
+	}
+
+
+	void FlatTree::Grow()
+	{
+		auto& values_d = std::get< std::vector<dbl> >(values_);
+		auto& values_mp = std::get< std::vector<mpfr_complex> >(values_);
+
+		const auto old_size = values_d.size();
+		values_d.resize(entries_.size());
+		values_mp.resize(entries_.size());
+		for (auto ii = old_size; ii<values_mp.size(); ++ii)
+			values_mp[ii].precision(precision_);
+
+		for (auto const& c : constants_)
+			if (c.first >= old_size)
+			{
+				values_d[c.first] = c.second->Eval<dbl>();
+				inplace::Assign(values_mp[c.first], c.second->Eval<mpfr_complex>());
+			}
+	}
+
+
+	void FlatTree::precision(unsigned prec)
+	{
+		precision_ = prec;
+
+		auto& values_mp = std::get< std::vector<mpfr_complex> >(values_);
+		for (auto& v : values_mp)
+			v.precision(prec);
+		std::get<mpfr_complex>(scratch_).precision(prec);
+
+		for (auto const& c : constants_)
+			inplace::Assign(values_mp[c.first], c.second->Eval<mpfr_complex>());
+
+		num_evaluated_[TypeIndex<mpfr_complex>()] = 0;
+	}
+
+
+	template<typename T>
+	void FlatTree::EvalUpTo(size_t end) const
+	{
+		auto& num_evaluated = num_evaluated_[TypeIndex<T>()];
+		if (num_evaluated >= end)
+			return;
+
+		auto& values = std::get< std::vector<T> >(values_);
+		auto& scratch = std::get<T>(scratch_);
+		using std::swap;
+
+		for (size_t ii{num_evaluated}; ii<end; ++ii)
+		{
+			auto const& e = entries_[ii];
+			auto const* c = children_.data() + e.first_child;
+			auto& out = values[ii];
+
+			// every child comes before its parent, so out is never an operand
+			switch (e.kind)
+			{
+				case Kind::Input:
+				case Kind::Constant:
+					break;
+
+				case Kind::Sum:
+				{
+					auto const* adds = adds_.data() + e.first_child;
+					inplace::Assign(out, values[c[0]]);
+					for (std::uint32_t jj{1}; jj<e.num_children; ++jj)
+					{
+						if (adds[jj])
+							inplace::Add(scratch, out, values[c[jj]]);
+						else
+							inplace::Subtract(scratch, out, values[c[jj]]);
+						swap(out, scratch);
+					}
+					break;
+				}
+
+				case Kind::Product:
+				{
+					auto const* adds = adds_.data() + e.first_child;
+					inplace::Assign(out, values[c[0]]);
+					for (std::uint32_t jj{1}; jj<e.num_children; ++jj)
+					{
+						if (adds[jj])
+							inplace::Multiply(scratch, out, values[c[jj]]);
+						else
+							inplace::Divide(scratch, out, values[c[jj]]);
+						swap(out, scratch);
+					}
+					break;
+				}
+
+				case Kind::IntPower: inplace::IntPower(out, values[c[0]], e.exponent); break;
+				case Kind::Power: inplace::Power(out, values[c[0]], values[c[1]]); break;
+				case Kind::Negate: inplace::Negate(out, values[c[0]]); break;
+				case Kind::Sqrt: inplace::Sqrt(out, values[c[0]]); break;
+				case Kind::Exp: inplace::Exp(out, values[c[0]]); break;
+				case Kind::Log: inplace::Log(out, values[c[0]]); break;
+				case Kind::Sin: inplace::Sin(out, values[c[0]]); break;
+				case Kind::Cos: inplace::Cos(out, values[c[0]]); break;
+				case Kind::Tan: inplace::Tan(out, values[c[0]]); break;
+				case Kind::ArcSin: inplace::Asin(out, values[c[0]]); break;
+				case Kind::ArcCos: inplace::Acos(out, values[c[0]]); break;
+				case Kind::ArcTan: inplace::Atan(out, values[c[0]]); break;
+			}
+		}
+
+		num_evaluated = end;
+	}
+
+	template void FlatTree::EvalUpTo<dbl>(size_t) const;
+	template void FlatTree::EvalUpTo<mpfr_complex>(size_t) const;
+
+} // namespace node
+} // namespace bertini
@@ -388,6 +388,16 @@ namespace  bertini {
 
 		
 		
+		std::shared_ptr<Node> LinearProduct::GetCoefficientNode(size_t factor, size_t term) const
+		{
+			if(is_rational_coeffs_)
+				return Rational::Make(coeffs_rat_real_(factor,term), coeffs_rat_imag_(factor,term));
+			else
+				return Float::Make(std::get<Mat<mpfr_complex>>(coeffs_)(factor,term));
+		}
+		
+		
+		
 		void LinearProduct::print(std::ostream & target) const
 		{
 			auto& coeff_ref = std::get<Mat<dbl>>(coeffs_);
@@ -454,6 +464,7 @@ namespace  bertini {
 				coeffs_rat_real_.resize(1, num_variables_+1);
 				coeffs_rat_real_.resize(1, num_variables_+1);
 				linear->GetRatCoeffs(coeffs_rat_real_, coeffs_rat_imag_);
+				is_rational_coeffs_ = true;
 				for(int jj = 0; jj < num_variables_+1; ++jj)
 				{
 					coeffs_dbl_ref(0,jj).real( static_cast<double>(coeffs_rat_real_(0,jj)) );
@@ -479,6 +490,17 @@ namespace  bertini {
 		
 		
 		
+		std::shared_ptr<Node> DiffLinear::GetCoefficientNode(size_t term) const
+		{
+			if(is_rational_coeffs_)
+				return Rational::Make(coeffs_rat_real_(0,term), coeffs_rat_imag_(0,term));
+			else
+				return Float::Make(std::get<Mat<mpfr_complex>>(coeffs_)(0,term));
+		}
+		
+		
+		
+		
 		void DiffLinear::print(std::ostream & target) const
 		{
 			auto& coeff_ref = std::get<Mat<dbl>>(coeffs_);
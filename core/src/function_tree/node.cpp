@@ -61,6 +61,53 @@ BOOST_CLASS_EXPORT_IMPLEMENT(bertini::node::ExpOperator)
 namespace bertini{
 namespace node{
 
+	namespace detail{
+		std::atomic<std::uint64_t> last_evaluation_epoch{0};
+		thread_local std::uint64_t evaluation_epoch = 0;
+	}
+
+	void NewEvaluationEpoch()
+	{
+		detail::evaluation_epoch = detail::last_evaluation_epoch.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+
+	namespace {
+		// the arena a node came from, or nullptr for the heap, is stored in front of the node, with room enough to keep the node aligned
+		constexpr std::size_t node_prefix = alignof(std::max_align_t);
+		static_assert(sizeof(NodeArena*) <= node_prefix, "a pointer must fit in front of a node");
+	}
+
+	void* Node::operator new(std::size_t num_bytes)
+	{
+		auto arena = NodeArena::Current();
+
+		void* block;
+		if (arena)
+		{
+			block = arena->Allocate(node_prefix + num_bytes, node_prefix);
+			arena->Retain();
+		}
+		else
+			block = ::operator new(node_prefix + num_bytes);
+
+		*static_cast<NodeArena**>(block) = arena;
+		return static_cast<char*>(block) + node_prefix;
+	}
+
+	void Node::operator delete(void* n) noexcept
+	{
+		if (!n)
+			return;
+
+		void* block = static_cast<char*>(n) - node_prefix;
+		auto arena = *static_cast<NodeArena**>(block);
+		if (arena)
+			arena->Release();
+		else
+			::operator delete(block);
+	}
+
+
 	unsigned Node::ReduceDepth()
 	{
 		return 0;
@@ -71,10 +118,10 @@ namespace node{
 	void Node::EvalInPlace(T& eval_value, std::shared_ptr<Variable> const& diff_variable) const
 	{
 		auto& val_pair = std::get< std::pair<T,bool> >(current_value_);
-		if(!val_pair.second)
+		if(!HaveStoredValue<T>())
 		{
 			detail::FreshEvalSelector<T>::RunInPlace(val_pair.first, *this,diff_variable);
-			val_pair.second = true;
+			MarkStoredValue<T>();
 		}
 		eval_value = val_pair.first;
 	}
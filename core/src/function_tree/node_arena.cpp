@@ -0,0 +1,84 @@
+//This file is part of Bertini 2.
+//
+//b2/core/src/function_tree/node_arena.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//b2/core/src/function_tree/node_arena.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with b2/core/src/function_tree/node_arena.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2021 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+//  silviana amethyst, university of wisconsin-eau claire
+
+
+
+#include "bertini2/function_tree/node_arena.hpp"
+
+namespace bertini {
+namespace node {
+
+	namespace {
+		thread_local NodeArena* current_arena = nullptr;
+	}
+
+
+	std::shared_ptr<NodeArena> NodeArena::Make(std::size_t initial_block_size)
+	{
+		// the shared_ptr is one owner among the nodes made in the arena, so it releases rather than deletes
+		return std::shared_ptr<NodeArena>(new NodeArena(initial_block_size), [](NodeArena* a){ a->Release(); });
+	}
+
+	NodeArena::NodeArena(std::size_t initial_block_size) : resource_(initial_block_size)
+	{}
+
+
+	NodeArena* NodeArena::Current()
+	{
+		return current_arena;
+	}
+
+	NodeArena::Scope::Scope(std::shared_ptr<NodeArena> const& arena) : previous_(current_arena)
+	{
+		if (arena)
+			current_arena = arena.get();
+	}
+
+	NodeArena::Scope::~Scope()
+	{
+		current_arena = previous_;
+	}
+
+
+	void* NodeArena::Allocate(std::size_t num_bytes, std::size_t alignment)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		++num_allocations_;
+		num_bytes_ += num_bytes;
+		return resource_.allocate(num_bytes, alignment);
+	}
+
+	void NodeArena::Retain()
+	{
+		num_references_.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void NodeArena::Release()
+	{
+		if (num_references_.fetch_sub(1, std::memory_order_acq_rel)==1)
+			delete this; // all the blocks go back at once
+	}
+
+} // namespace node
+} // namespace bertini
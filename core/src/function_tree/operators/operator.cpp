@@ -149,6 +149,11 @@ void NaryOperator::AddOperand(std::shared_ptr<Node> n)
 	operands_.push_back(std::move(n));
 }
 
+void NaryOperator::SetOperand(size_t index, std::shared_ptr<Node> n)
+{
+	operands_.at(index) = std::move(n);
+}
+
 
 
 
@@ -44,14 +44,14 @@ T Jacobian::EvalJ(std::shared_ptr<Variable> const& diff_variable) const
 {
 		auto& val_pair = std::get< std::pair<T,bool> >(current_value_);
 
-		if(diff_variable == current_diff_variable_ && val_pair.second)
+		if(diff_variable == current_diff_variable_ && HaveStoredValue<T>())
 			return val_pair.first;
 		else
 		{
 			current_diff_variable_ = diff_variable;
 			Reset();
 			detail::FreshEvalSelector<T>::RunInPlace(val_pair.first, *this, diff_variable);
-			val_pair.second = true;
+			MarkStoredValue<T>();
 			return val_pair.first;
 		}						
 }
@@ -66,14 +66,14 @@ void Jacobian::EvalJInPlace(T& eval_value, std::shared_ptr<Variable> const& diff
 {
 		auto& val_pair = std::get< std::pair<T,bool> >(current_value_);
 
-		if(diff_variable == current_diff_variable_ && val_pair.second)
+		if(diff_variable == current_diff_variable_ && HaveStoredValue<T>())
 			eval_value = val_pair.first;
 		else
 		{
 			current_diff_variable_ = diff_variable;
 			Reset();
 			detail::FreshEvalSelector<T>::RunInPlace(val_pair.first,*this,diff_variable);
-			val_pair.second = true;
+			MarkStoredValue<T>();
 			eval_value = val_pair.first;
 		}						
 }
@@ -0,0 +1,591 @@
+//This file is part of Bertini 2.
+//
+//slp_binary.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//slp_binary.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with slp_binary.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2021 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// silviana amethyst, university of wisconsin eau claire
+
+#include "bertini2/system/slp_binary.hpp"
+#include "bertini2/system/straight_line_program.hpp"
+#include "bertini2/system/system.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <typeinfo>
+
+#include <boost/filesystem.hpp>
+
+
+namespace bertini{
+
+	namespace {
+
+		const std::string Magic = "B2SLPBIN";
+		constexpr size_t ChecksumSize = 8;
+
+		// FNV-1a
+		std::uint64_t HashBytes(std::string const& bytes, size_t begin, size_t end)
+		{
+			std::uint64_t hash = 14695981039346656037ull;
+			for (auto ii=begin; ii<end; ++ii){
+				hash ^= static_cast<unsigned char>(bytes[ii]);
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+
+		// how each node in the tree of a number is written.  the numbers in a program are the ones in the system, and the ones the optimizer folded together from them, so these are all the kinds there are.
+		enum class NodeTag : unsigned char
+		{
+			Reference, // a node already written, by its index in the order written
+			Integer, Rational, Float, Pi, E,
+			Sum, Mult, Negate, IntegerPower, Power,
+			Sqrt, Exp, Log, Sin, Cos, Tan, ArcSin, ArcCos, ArcTan
+		};
+
+
+		// "(re,im)", as the complex numbers print, into its two parts
+		void SplitComplex(std::string const& printed, std::string & real, std::string & imag)
+		{
+			auto comma = printed.find(',');
+			if (printed.empty() || printed.front()!='(' || printed.back()!=')' || comma==std::string::npos){
+				real = printed;
+				imag = "0";
+				return;
+			}
+			real = printed.substr(1, comma-1);
+			imag = printed.substr(comma+1, printed.size()-comma-2);
+		}
+
+
+
+		/**
+		 Everything is written as bytes, with integers in base 128, low digits first, so that the format doesn't depend on the byte order or word size of the machine.
+		 */
+		class Writer{
+		public:
+
+			std::string const& Bytes() const{ return bytes_;}
+
+			void Byte(unsigned char b)
+			{
+				bytes_.push_back(static_cast<char>(b));
+			}
+
+			void Fixed(std::uint64_t x, unsigned num_bytes)
+			{
+				for (unsigned ii=0; ii<num_bytes; ++ii)
+					Byte(static_cast<unsigned char>(x >> (8*ii)));
+			}
+
+			void Unsigned(std::uint64_t x)
+			{
+				while (x>=0x80){
+					Byte(static_cast<unsigned char>(x | 0x80));
+					x >>= 7;
+				}
+				Byte(static_cast<unsigned char>(x));
+			}
+
+			// zigzag, so that small negative numbers are short too
+			void Signed(std::int64_t x)
+			{
+				Unsigned((static_cast<std::uint64_t>(x) << 1) ^ static_cast<std::uint64_t>(x >> 63));
+			}
+
+			void String(std::string const& s)
+			{
+				Unsigned(s.size());
+				bytes_ += s;
+			}
+
+			void Tag(NodeTag t)
+			{
+				Byte(static_cast<unsigned char>(t));
+			}
+
+			/**
+			 \brief Write the tree of a number.  Nodes appearing more than once are written once, and referred back to after that.
+
+			 \throws std::runtime_error for a kind of node that can't be in a number.
+			 */
+			void Number(std::shared_ptr<const node::Node> const& n)
+			{
+				using namespace node;
+
+				auto found = written_.find(n.get());
+				if (found!=written_.end()){
+					Tag(NodeTag::Reference);
+					Unsigned(found->second);
+					return;
+				}
+
+				if (std::dynamic_pointer_cast<const Integer>(n)){
+					Tag(NodeTag::Integer);
+					String(Printed(n));
+				}
+				else if (std::dynamic_pointer_cast<const Rational>(n) || std::dynamic_pointer_cast<const Float>(n)){
+					std::string real, imag;
+					SplitComplex(Printed(n), real, imag);
+					Tag(std::dynamic_pointer_cast<const Rational>(n) ? NodeTag::Rational : NodeTag::Float);
+					String(real);
+					String(imag);
+				}
+				else if (std::dynamic_pointer_cast<const special_number::Pi>(n))
+					Tag(NodeTag::Pi);
+				else if (std::dynamic_pointer_cast<const special_number::E>(n))
+					Tag(NodeTag::E);
+				else if (auto s = std::dynamic_pointer_cast<const SumOperator>(n)){
+					Tag(NodeTag::Sum);
+					Operands(s->Operands(), s->GetSigns());
+				}
+				else if (auto m = std::dynamic_pointer_cast<const MultOperator>(n)){
+					Tag(NodeTag::Mult);
+					Operands(m->Operands(), m->GetMultOrDiv());
+				}
+				else if (auto p = std::dynamic_pointer_cast<const IntegerPowerOperator>(n)){
+					Tag(NodeTag::IntegerPower);
+					Signed(p->exponent());
+					Number(p->Operand());
+				}
+				else if (auto p = std::dynamic_pointer_cast<const PowerOperator>(n)){
+					Tag(NodeTag::Power);
+					Number(p->GetBase());
+					Number(p->GetExponent());
+				}
+				else if (auto u = std::dynamic_pointer_cast<const UnaryOperator>(n)){
+					Tag(UnaryTag(n));
+					Number(u->Operand());
+				}
+				else
+					throw std::runtime_error("unable to write a number node of type " + std::string(typeid(*n).name()));
+
+				auto index = written_.size();
+				written_[n.get()] = index;
+			}
+
+		private:
+
+			template<typename OperandsT, typename FlagsT>
+			void Operands(OperandsT const& operands, FlagsT const& flags)
+			{
+				Unsigned(operands.size());
+				for (size_t ii{0}; ii<operands.size(); ++ii){
+					Byte(flags[ii] ? 1 : 0);
+					Number(operands[ii]);
+				}
+			}
+
+			static NodeTag UnaryTag(std::shared_ptr<const node::Node> const& n)
+			{
+				using namespace node;
+				if (std::dynamic_pointer_cast<const NegateOperator>(n)) return NodeTag::Negate;
+				if (std::dynamic_pointer_cast<const SqrtOperator>(n)) return NodeTag::Sqrt;
+				if (std::dynamic_pointer_cast<const ExpOperator>(n)) return NodeTag::Exp;
+				if (std::dynamic_pointer_cast<const LogOperator>(n)) return NodeTag::Log;
+				if (std::dynamic_pointer_cast<const SinOperator>(n)) return NodeTag::Sin;
+				if (std::dynamic_pointer_cast<const CosOperator>(n)) return NodeTag::Cos;
+				if (std::dynamic_pointer_cast<const TanOperator>(n)) return NodeTag::Tan;
+				if (std::dynamic_pointer_cast<const ArcSinOperator>(n)) return NodeTag::ArcSin;
+				if (std::dynamic_pointer_cast<const ArcCosOperator>(n)) return NodeTag::ArcCos;
+				if (std::dynamic_pointer_cast<const ArcTanOperator>(n)) return NodeTag::ArcTan;
+				throw std::runtime_error("unable to write a number node of type " + std::string(typeid(*n).name()));
+			}
+
+			static std::string Printed(std::shared_ptr<const node::Node> const& n)
+			{
+				std::stringstream ss;
+				ss.precision(0); // Boost.Multiprecision prints every digit needed to reconstruct a value when asked for 0 digits
+				ss << *n;
+				return ss.str();
+			}
+
+			std::string bytes_;
+			std::map<node::Node const*, size_t> written_;
+		};
+
+
+
+		/**
+		 Reads what a Writer wrote.  Throws std::runtime_error on running off the end, or on anything not in the format.
+		 */
+		class Reader{
+		public:
+
+			Reader(std::string const& bytes, size_t begin, size_t end) : bytes_(bytes), position_(begin), end_(end)
+			{}
+
+			bool AtEnd() const{ return position_==end_;}
+
+			unsigned char Byte()
+			{
+				if (position_>=end_)
+					throw std::runtime_error("binary straight line program ends early");
+				return static_cast<unsigned char>(bytes_[position_++]);
+			}
+
+			std::uint64_t Fixed(unsigned num_bytes)
+			{
+				std::uint64_t x = 0;
+				for (unsigned ii=0; ii<num_bytes; ++ii)
+					x |= static_cast<std::uint64_t>(Byte()) << (8*ii);
+				return x;
+			}
+
+			std::uint64_t Unsigned()
+			{
+				std::uint64_t x = 0;
+				for (unsigned shift=0; shift<64; shift+=7){
+					auto b = Byte();
+					x |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+					if (!(b & 0x80))
+						return x;
+				}
+				throw std::runtime_error("malformed integer in binary straight line program");
+			}
+
+			std::int64_t Signed()
+			{
+				auto x = Unsigned();
+				return static_cast<std::int64_t>(x >> 1) ^ -static_cast<std::int64_t>(x & 1);
+			}
+
+			// for sizes of things about to be read.  each takes at least a byte, so a bigger count can't be right.
+			size_t Count()
+			{
+				auto n = Unsigned();
+				if (n > end_-position_)
+					throw std::runtime_error("binary straight line program ends early");
+				return static_cast<size_t>(n);
+			}
+
+			std::string String()
+			{
+				auto n = Count();
+				std::string s = bytes_.substr(position_, n);
+				position_ += n;
+				return s;
+			}
+
+			std::shared_ptr<node::Node> Number()
+			{
+				using namespace node;
+
+				auto tag = static_cast<NodeTag>(Byte());
+				if (tag==NodeTag::Reference){
+					auto index = Unsigned();
+					if (index>=read_.size())
+						throw std::runtime_error("bad reference to a number node in binary straight line program");
+					return read_[index];
+				}
+
+				std::shared_ptr<Node> n;
+				switch (tag){
+					case NodeTag::Integer: n = Integer::Make(String()); break;
+					case NodeTag::Rational:{
+						auto real = String();
+						n = Rational::Make(real, String());
+						break;
+					}
+					case NodeTag::Float:{
+						auto real = String();
+						auto imag = String();
+						// every digit that was written is kept, even if the current default precision is lower
+						const auto previous_precision = DefaultPrecision();
+						DefaultPrecision(std::max<unsigned>(previous_precision, std::max(real.size(), imag.size())));
+						n = Float::Make(real, imag);
+						DefaultPrecision(previous_precision);
+						break;
+					}
+					case NodeTag::Pi: n = special_number::Pi::Make(); break;
+					case NodeTag::E: n = special_number::E::Make(); break;
+					case NodeTag::Sum:{
+						auto operands = Operands();
+						auto s = SumOperator::Make(operands[0].first, operands[0].second);
+						for (size_t ii{1}; ii<operands.size(); ++ii)
+							s->AddOperand(operands[ii].first, operands[ii].second);
+						n = s;
+						break;
+					}
+					case NodeTag::Mult:{
+						auto operands = Operands();
+						if (operands.size()==1 && operands[0].second){
+							n = MultOperator::Make(operands[0].first);
+							break;
+						}
+						if (operands.size()==1) // there's no constructor for a single divided-by factor
+							operands.insert(operands.begin(), std::make_pair(std::shared_ptr<Node>(Integer::Make(1)), true));
+						auto m = MultOperator::Make(operands[0].first, operands[0].second, operands[1].first, operands[1].second);
+						for (size_t ii{2}; ii<operands.size(); ++ii)
+							m->AddOperand(operands[ii].first, operands[ii].second);
+						n = m;
+						break;
+					}
+					case NodeTag::IntegerPower:{
+						auto exponent = static_cast<int>(Signed());
+						n = IntegerPowerOperator::Make(Number(), exponent);
+						break;
+					}
+					case NodeTag::Power:{
+						auto base = Number();
+						n = PowerOperator::Make(base, Number());
+						break;
+					}
+					case NodeTag::Negate: n = NegateOperator::Make(Number()); break;
+					case NodeTag::Sqrt: n = SqrtOperator::Make(Number()); break;
+					case NodeTag::Exp: n = ExpOperator::Make(Number()); break;
+					case NodeTag::Log: n = LogOperator::Make(Number()); break;
+					case NodeTag::Sin: n = SinOperator::Make(Number()); break;
+					case NodeTag::Cos: n = CosOperator::Make(Number()); break;
+					case NodeTag::Tan: n = TanOperator::Make(Number()); break;
+					case NodeTag::ArcSin: n = ArcSinOperator::Make(Number()); break;
+					case NodeTag::ArcCos: n = ArcCosOperator::Make(Number()); break;
+					case NodeTag::ArcTan: n = ArcTanOperator::Make(Number()); break;
+					default:
+						throw std::runtime_error("unknown kind of number node in binary straight line program");
+				}
+
+				read_.push_back(n);
+				return n;
+			}
+
+		private:
+
+			std::vector<std::pair<std::shared_ptr<node::Node>, bool>> Operands()
+			{
+				auto num_operands = Count();
+				if (num_operands==0)
+					throw std::runtime_error("operator without operands in binary straight line program");
+
+				std::vector<std::pair<std::shared_ptr<node::Node>, bool>> operands;
+				for (size_t ii{0}; ii<num_operands; ++ii){
+					bool flag = Byte()!=0;
+					operands.emplace_back(Number(), flag);
+				}
+				return operands;
+			}
+
+			std::string const& bytes_;
+			size_t position_;
+			size_t end_;
+			std::vector<std::shared_ptr<node::Node>> read_;
+		};
+
+	} // namespace
+
+
+
+	namespace slp_binary {
+
+		std::string Hash(std::string const& text)
+		{
+			std::stringstream ss;
+			ss << std::hex << std::setw(16) << std::setfill('0') << HashBytes(text, 0, text.size());
+			return ss.str();
+		}
+
+	} // namespace slp_binary
+
+
+
+	void StraightLineProgram::WriteBinary(std::ostream & out) const
+	{
+		Writer w;
+
+		w.Unsigned(memory_size_);
+		w.Byte(has_path_variable_ ? 1 : 0);
+
+		for (auto x : {number_of_.Functions, number_of_.Variables, number_of_.Jacobian, number_of_.TimeDeriv,
+		               output_locations_.Functions, output_locations_.Jacobian, output_locations_.TimeDeriv,
+		               input_locations_.Variables, input_locations_.Time,
+		               instruction_ranges_.ConstantEnd, instruction_ranges_.TimeOnlyEnd, instruction_ranges_.FunctionsEnd, instruction_ranges_.SharedDerivativesEnd, instruction_ranges_.JacobianEnd, instruction_ranges_.TimeDerivEnd,
+		               optimization_statistics_.InstructionsBefore, optimization_statistics_.InstructionsAfter, optimization_statistics_.MemoryBefore, optimization_statistics_.MemoryAfter})
+			w.Unsigned(x);
+
+		w.Unsigned(integers_.size());
+		for (auto x : integers_)
+			w.Signed(x);
+
+		w.Unsigned(instructions_.size());
+		for (auto x : instructions_)
+			w.Unsigned(x);
+
+		w.Byte(static_cast<unsigned char>(dispatch_method_));
+
+		w.Unsigned(true_values_of_numbers_.size());
+		for (auto const& x : true_values_of_numbers_){
+			w.Unsigned(x.second);
+			w.Number(x.first);
+		}
+
+		Writer header;
+		for (auto c : Magic)
+			header.Byte(static_cast<unsigned char>(c));
+		header.Fixed(slp_binary::FormatVersion, 4);
+
+		Writer checksum;
+		checksum.Fixed(HashBytes(w.Bytes(), 0, w.Bytes().size()), ChecksumSize);
+
+		out << header.Bytes() << w.Bytes() << checksum.Bytes();
+		if (!out)
+			throw std::runtime_error("unable to write binary straight line program");
+	}
+
+
+
+	void StraightLineProgram::ReadBinary(std::istream & in)
+	{
+		const std::string bytes{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+
+		const size_t header_size = Magic.size() + 4;
+		if (bytes.size() < header_size + ChecksumSize || bytes.compare(0, Magic.size(), Magic)!=0)
+			throw std::runtime_error("not a binary straight line program");
+
+		Reader header(bytes, Magic.size(), header_size);
+		auto version = header.Fixed(4);
+		if (version!=slp_binary::FormatVersion)
+			throw std::runtime_error("binary straight line program is version " + std::to_string(version) + ", but only version " + std::to_string(slp_binary::FormatVersion) + " can be read");
+
+		const size_t end = bytes.size() - ChecksumSize;
+		Reader checksum(bytes, end, bytes.size());
+		if (checksum.Fixed(ChecksumSize)!=HashBytes(bytes, header_size, end))
+			throw std::runtime_error("binary straight line program is corrupt: its checksum doesn't match");
+
+		Reader r(bytes, header_size, end);
+		StraightLineProgram slp;
+
+		slp.memory_size_ = r.Unsigned();
+		slp.has_path_variable_ = r.Byte()!=0;
+
+		for (auto x : {&slp.number_of_.Functions, &slp.number_of_.Variables, &slp.number_of_.Jacobian, &slp.number_of_.TimeDeriv,
+		               &slp.output_locations_.Functions, &slp.output_locations_.Jacobian, &slp.output_locations_.TimeDeriv,
+		               &slp.input_locations_.Variables, &slp.input_locations_.Time,
+		               &slp.instruction_ranges_.ConstantEnd, &slp.instruction_ranges_.TimeOnlyEnd, &slp.instruction_ranges_.FunctionsEnd, &slp.instruction_ranges_.SharedDerivativesEnd, &slp.instruction_ranges_.JacobianEnd, &slp.instruction_ranges_.TimeDerivEnd,
+		               &slp.optimization_statistics_.InstructionsBefore, &slp.optimization_statistics_.InstructionsAfter, &slp.optimization_statistics_.MemoryBefore, &slp.optimization_statistics_.MemoryAfter})
+			*x = r.Unsigned();
+
+		slp.integers_.resize(r.Count());
+		for (auto& x : slp.integers_)
+			x = static_cast<IntT>(r.Signed());
+
+		slp.instructions_.resize(r.Count());
+		for (auto& x : slp.instructions_)
+			x = r.Unsigned();
+
+		auto dispatch = r.Byte();
+		if (dispatch > static_cast<unsigned char>(DispatchMethod::JIT))
+			throw std::runtime_error("unknown dispatch method in binary straight line program");
+		slp.dispatch_method_ = static_cast<DispatchMethod>(dispatch);
+
+		auto num_numbers = r.Count();
+		for (size_t ii{0}; ii<num_numbers; ++ii){
+			auto loc = r.Unsigned();
+			if (loc>=slp.memory_size_)
+				throw std::runtime_error("number outside of memory in binary straight line program");
+			slp.AddNumber(r.Number(), loc);
+		}
+
+		if (!r.AtEnd())
+			throw std::runtime_error("binary straight line program has extra bytes at the end");
+
+		slp.DecodeInstructions();
+		auto bounds = slp.instruction_ranges_.Bounds();
+		if (!std::is_sorted(bounds.begin(), bounds.end()) || bounds.back()!=slp.decoded_instructions_.size())
+			throw std::runtime_error("instruction blocks don't match the instructions in binary straight line program");
+		slp.CompileJIT();
+		slp.workspace_ = slp.MakeWorkspace(DefaultPrecision());
+
+		*this = slp;
+	}
+
+
+
+	namespace {
+
+		// what's hashed for the key, and stored at the start of the entry
+		std::string EntryDescription(std::string const& description)
+		{
+			return "straight line program, binary format version " + std::to_string(slp_binary::FormatVersion) + "\n" + description;
+		}
+
+	} // namespace
+
+	std::string SLPCache::Key(std::string const& description)
+	{
+		return slp_binary::Hash(EntryDescription(description));
+	}
+
+	std::string SLPCache::PathFor(std::string const& key) const
+	{
+		return (boost::filesystem::path(directory_) / (key + ".slp")).string();
+	}
+
+	bool SLPCache::Load(std::string const& description, StraightLineProgram & slp) const
+	{
+		std::ifstream in(PathFor(Key(description)), std::ios::binary);
+		if (!in)
+			return false;
+
+		// the key is only a hash, so the entry has to be for this very description
+		const auto expected = EntryDescription(description);
+		size_t size;
+		if (!(in >> size) || in.get()!='\n' || size!=expected.size())
+			return false;
+		std::string stored(size, '\0');
+		if (!in.read(&stored[0], size) || stored!=expected)
+			return false;
+
+		try{
+			StraightLineProgram loaded;
+			loaded.ReadBinary(in);
+			slp = loaded;
+			return true;
+		}
+		catch (std::runtime_error const&){
+			return false;
+		}
+	}
+
+	void SLPCache::Store(std::string const& description, StraightLineProgram const& slp) const
+	{
+		namespace fs = boost::filesystem;
+
+		fs::create_directories(directory_);
+
+		// written beside the entry, then moved into place, so that no one ever reads half a program
+		const auto path = PathFor(Key(description));
+		const auto temporary = path + "." + fs::unique_path().string();
+		{
+			std::ofstream out(temporary, std::ios::binary);
+			if (!out)
+				throw std::runtime_error("unable to write to straight line program cache at " + temporary);
+			const auto entry_description = EntryDescription(description);
+			out << entry_description.size() << '\n' << entry_description;
+			slp.WriteBinary(out);
+		}
+		fs::rename(temporary, path);
+	}
+
+} // namespace bertini
@@ -0,0 +1,242 @@
+//This file is part of Bertini 2.
+//
+//slp_codegen.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//slp_codegen.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with slp_codegen.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2021 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// silviana amethyst, university of wisconsin eau claire
+
+#include "bertini2/system/slp_codegen.hpp"
+#include "bertini2/system/straight_line_program.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+
+#if !defined(_WIN32)
+	#include <dlfcn.h>
+#endif
+
+
+namespace bertini{
+
+	namespace {
+
+		constexpr size_t NumBlocks = 6; // see StraightLineProgram::InstructionRanges
+
+		// FNV-1a, a word at a time.  it doesn't need to be cryptographic, just to tell programs apart.
+		void HashInto(std::uint64_t & hash, size_t value)
+		{
+			for (unsigned ii=0; ii<sizeof(size_t); ++ii){
+				hash ^= (value >> (8*ii)) & 0xff;
+				hash *= 1099511628211ull;
+			}
+		}
+
+		// one statement, in the same terms as the interpreter, so the same overloads get picked.
+		void WriteStatement(std::ostream & out, Instruction const& instr, std::vector<StraightLineProgram::IntT> const& integers)
+		{
+			auto m = [](size_t loc){ return "m[" + std::to_string(loc) + "]";};
+
+			out << "\t\tinplace::" << OpcodeToString(instr.op) << "(" << m(instr.out) << ", " << m(instr.in1);
+			if (SecondOperandInMemory(instr.op))
+				out << ", " << m(instr.in2);
+			else if (!IsUnary(instr.op))
+				out << ", " << integers[instr.in2];
+			if (IsTernary(instr.op))
+				out << ", " << m(instr.in3);
+			out << ");\n";
+		}
+
+	} // namespace
+
+
+	namespace slp_codegen {
+
+		std::string FingerprintSymbol()
+		{
+			return "bertini_slp_fingerprint";
+		}
+
+		std::string BlockSymbol(bool multiple_precision, size_t block)
+		{
+			return std::string("bertini_slp_") + (multiple_precision ? "mpfr" : "dbl") + "_block_" + std::to_string(block);
+		}
+
+		bool BlocksSpanning(std::vector<size_t> const& block_bounds, size_t begin, size_t end, size_t & first_block, size_t & end_block)
+		{
+			// empty blocks make repeated bounds, so take the first block starting at `begin` and the last ending at `end`.
+			auto first = std::find(block_bounds.begin(), block_bounds.end(), begin);
+			auto last = std::find(block_bounds.rbegin(), block_bounds.rend(), end);
+			if (first==block_bounds.end() || last==block_bounds.rend())
+				return false;
+
+			first_block = static_cast<size_t>(first - block_bounds.begin());
+			end_block = static_cast<size_t>(block_bounds.rend() - last) - 1;
+			return first_block <= end_block;
+		}
+
+	} // namespace slp_codegen
+
+
+
+
+	std::string StraightLineProgram::Fingerprint() const
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+
+		HashInto(hash, memory_size_);
+		HashInto(hash, has_path_variable_);
+		for (auto x : instruction_ranges_.Bounds())
+			HashInto(hash, x);
+		for (auto x : instructions_)
+			HashInto(hash, x);
+		for (auto x : integers_)
+			HashInto(hash, static_cast<size_t>(x));
+
+		std::stringstream ss;
+		ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+		return ss.str();
+	}
+
+
+
+	void StraightLineProgram::GenerateCpp(std::ostream & out, bool multiple_precision) const
+	{
+		auto const fingerprint = Fingerprint();
+		auto const bounds = instruction_ranges_.Bounds();
+
+		out << "// generated by Bertini2 from a straight-line program.  don't edit it, regenerate it.\n";
+		out << "// fingerprint " << fingerprint << ", " << decoded_instructions_.size() << " instructions, memory for " << memory_size_ << " numbers\n\n";
+
+		out << "#include \"bertini2/double_extensions.hpp\"\n";
+		if (multiple_precision){
+			out << "#include \"bertini2/mpfr_complex.hpp\"\n";
+			out << "#include \"bertini2/mpfr_extensions.hpp\"\n";
+		}
+		out << "\n";
+
+		// the blocks are templates, so the double and multiple precision versions are written once.  they live in namespace bertini so that calls find the same overloads the interpreter does.
+		out << "namespace bertini{\nnamespace generated_slp{\n\n";
+		for (size_t block=0; block<NumBlocks; ++block){
+			out << "\ttemplate<typename NumT>\n";
+			out << "\tvoid Block" << block << "(NumT* m)\n\t{\n";
+			for (size_t ii=bounds[block]; ii<bounds[block+1]; ++ii)
+				WriteStatement(out, decoded_instructions_[ii], integers_);
+			out << "\t}\n\n";
+		}
+		out << "} // namespace generated_slp\n} // namespace bertini\n\n\n";
+
+		out << "extern \"C\" {\n\n";
+		out << "\tconst char* " << slp_codegen::FingerprintSymbol() << "()\n\t{\n\t\treturn \"" << fingerprint << "\";\n\t}\n\n";
+		for (size_t block=0; block<NumBlocks; ++block){
+			out << "\tvoid " << slp_codegen::BlockSymbol(false, block) << "(void* memory)\n\t{\n";
+			out << "\t\tbertini::generated_slp::Block" << block << "(static_cast<bertini::dbl_complex*>(memory));\n\t}\n\n";
+		}
+		if (multiple_precision)
+			for (size_t block=0; block<NumBlocks; ++block){
+				out << "\tvoid " << slp_codegen::BlockSymbol(true, block) << "(void* memory)\n\t{\n";
+				out << "\t\tbertini::generated_slp::Block" << block << "(static_cast<bertini::mpfr_complex*>(memory));\n\t}\n\n";
+			}
+		out << "} // extern \"C\"\n";
+	}
+
+
+
+	void StraightLineProgram::LoadNativeEvaluator(std::string const& library)
+	{
+		native_evaluator_ = NativeEvaluator::Load(library, Fingerprint(), instruction_ranges_.Bounds());
+	}
+
+	void StraightLineProgram::UnloadNativeEvaluator()
+	{
+		native_evaluator_.reset();
+	}
+
+
+
+
+	std::shared_ptr<const NativeEvaluator> NativeEvaluator::Load(std::string const& library, std::string const& fingerprint, std::vector<size_t> const& block_bounds)
+	{
+#if defined(_WIN32)
+		throw std::runtime_error("loading compiled straight-line programs needs dlopen, which this platform doesn't have");
+#else
+		void* handle = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+		if (!handle)
+			throw std::runtime_error("failed to load compiled straight-line program " + library + ": " + dlerror());
+
+		auto evaluator = std::make_shared<NativeEvaluator>();
+		evaluator->handle_ = std::shared_ptr<void>(handle, [](void* h){ dlclose(h);});
+		evaluator->library_ = library;
+		evaluator->block_bounds_ = block_bounds;
+
+		auto get_fingerprint = reinterpret_cast<const char* (*)()>(dlsym(handle, slp_codegen::FingerprintSymbol().c_str()));
+		if (!get_fingerprint)
+			throw std::runtime_error(library + " is not a compiled straight-line program: it has no " + slp_codegen::FingerprintSymbol());
+		if (fingerprint != get_fingerprint())
+			throw std::runtime_error(library + " was generated from a different straight-line program.  fingerprint of library: " + get_fingerprint() + ", of program: " + fingerprint);
+
+		for (size_t block=0; block<NumBlocks; ++block){
+			auto f = reinterpret_cast<BlockFunction>(dlsym(handle, slp_codegen::BlockSymbol(false, block).c_str()));
+			if (!f)
+				throw std::runtime_error(library + " is missing " + slp_codegen::BlockSymbol(false, block));
+			evaluator->double_blocks_.push_back(f);
+		}
+
+		// the multiple precision functions are optional, but it's all or nothing.
+		for (size_t block=0; block<NumBlocks; ++block){
+			auto f = reinterpret_cast<BlockFunction>(dlsym(handle, slp_codegen::BlockSymbol(true, block).c_str()));
+			if (!f){
+				evaluator->multiple_blocks_.clear();
+				break;
+			}
+			evaluator->multiple_blocks_.push_back(f);
+		}
+
+		return evaluator;
+#endif
+	}
+
+
+	bool NativeEvaluator::Run(dbl_complex* memory, size_t begin, size_t end) const
+	{
+		return Run(double_blocks_, memory, begin, end);
+	}
+
+	bool NativeEvaluator::Run(mpfr_complex* memory, size_t begin, size_t end) const
+	{
+		return Run(multiple_blocks_, memory, begin, end);
+	}
+
+	bool NativeEvaluator::Run(std::vector<BlockFunction> const& blocks, void* memory, size_t begin, size_t end) const
+	{
+		if (blocks.empty())
+			return false;
+
+		size_t first_block, end_block;
+		if (!slp_codegen::BlocksSpanning(block_bounds_, begin, end, first_block, end_block))
+			return false;
+
+		for (auto block = first_block; block<end_block; ++block)
+			blocks[block](memory);
+		return true;
+	}
+
+} // namespace bertini
@@ -0,0 +1,395 @@
+//This file is part of Bertini 2.
+//
+//slp_jit.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//slp_jit.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with slp_jit.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2021 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// silviana amethyst, university of wisconsin eau claire
+
+#include "bertini2/system/slp_jit.hpp"
+#include "bertini2/system/slp_codegen.hpp"
+#include "bertini2/system/straight_line_program.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if BERTINI_SLP_JIT_AVAILABLE
+	#include <sys/mman.h>
+#endif
+
+
+namespace bertini{
+
+#if BERTINI_SLP_JIT_AVAILABLE
+
+	namespace {
+
+		using UnaryHelper = void (*)(dbl_complex* out, dbl_complex const* a);
+		using BinaryHelper = void (*)(dbl_complex* out, dbl_complex const* a, dbl_complex const* b);
+
+		// the operations that aren't done inline.  each does exactly what the interpreter does.
+		UnaryHelper GetUnaryHelper(Operation op)
+		{
+			switch (op){
+				case Exp: return [](dbl_complex* out, dbl_complex const* a){ *out = exp(*a);};
+				case Log: return [](dbl_complex* out, dbl_complex const* a){ *out = log(*a);};
+				case Sqrt: return [](dbl_complex* out, dbl_complex const* a){ *out = sqrt(*a);};
+				case Sin: return [](dbl_complex* out, dbl_complex const* a){ *out = sin(*a);};
+				case Cos: return [](dbl_complex* out, dbl_complex const* a){ *out = cos(*a);};
+				case Tan: return [](dbl_complex* out, dbl_complex const* a){ *out = tan(*a);};
+				case Asin: return [](dbl_complex* out, dbl_complex const* a){ *out = asin(*a);};
+				case Acos: return [](dbl_complex* out, dbl_complex const* a){ *out = acos(*a);};
+				case Atan: return [](dbl_complex* out, dbl_complex const* a){ *out = atan(*a);};
+				default: return nullptr;
+			}
+		}
+
+		BinaryHelper GetBinaryHelper(Operation op)
+		{
+			switch (op){
+				case Divide: return [](dbl_complex* out, dbl_complex const* a, dbl_complex const* b){ *out = *a / *b;};
+				case Power: return [](dbl_complex* out, dbl_complex const* a, dbl_complex const* b){ *out = pow(*a, *b);};
+				default: return nullptr;
+			}
+		}
+
+		void IntPowerFunction(dbl_complex* out, dbl_complex const* a, int exponent)
+		{
+			*out = pow(*a, exponent);
+		}
+
+
+
+		/**
+		 Just enough of an x86-64 assembler to write out straight-line programs.
+
+		 While a block runs, rbx holds the address of the SLP's memory, so each number is at a fixed offset from it.
+		 */
+		class Assembler{
+		public:
+
+			enum Register : unsigned char { rax = 0, rdx = 2, rbx = 3, rsi = 6, rdi = 7};
+
+			std::vector<unsigned char> const& Code() const{ return code_;}
+
+			void Prologue()
+			{
+				Bytes({0x53}); // push rbx, which also aligns the stack for calls
+				Bytes({0x48, 0x89, 0xfb}); // mov rbx, rdi
+			}
+
+			void Epilogue()
+			{
+				Bytes({0x5b}); // pop rbx
+				Bytes({0xc3}); // ret
+			}
+
+			// movupd xmm, [rbx + 16*loc]
+			void Load(unsigned char xmm, size_t loc)
+			{
+				Bytes({0x66, 0x0f, 0x10, RbxRelative(xmm)});
+				Displacement(loc);
+			}
+
+			// movupd [rbx + 16*loc], xmm
+			void Store(size_t loc, unsigned char xmm)
+			{
+				Bytes({0x66, 0x0f, 0x11, RbxRelative(xmm)});
+				Displacement(loc);
+			}
+
+			// one of the packed double instructions, xmm to xmm.  they're all 66 0f, then the opcode.
+			void Packed(unsigned char opcode, unsigned char dst, unsigned char src)
+			{
+				Bytes({0x66, 0x0f, opcode, static_cast<unsigned char>(0xc0 | (dst << 3) | src)});
+			}
+
+			void MovAPD(unsigned char dst, unsigned char src){ Packed(0x28, dst, src);}
+			void AddPD(unsigned char dst, unsigned char src){ Packed(0x58, dst, src);}
+			void SubPD(unsigned char dst, unsigned char src){ Packed(0x5c, dst, src);}
+			void MulPD(unsigned char dst, unsigned char src){ Packed(0x59, dst, src);}
+			void XorPD(unsigned char dst, unsigned char src){ Packed(0x57, dst, src);}
+			void UnpckLPD(unsigned char dst, unsigned char src){ Packed(0x14, dst, src);}
+			void UnpckHPD(unsigned char dst, unsigned char src){ Packed(0x15, dst, src);}
+
+			// swaps the two halves when dst==src
+			void ShufPDSwap(unsigned char dst, unsigned char src)
+			{
+				Packed(0xc6, dst, src);
+				Bytes({0x01});
+			}
+
+			// xmm = [sign bit, 0].  the top half is zeroed by movq.
+			void SignMaskLow(unsigned char xmm)
+			{
+				MovImmediate(0x8000000000000000ull);
+				MovQFromRax(xmm);
+			}
+
+			// xmm = [value, value]
+			void Broadcast(unsigned char xmm, double value)
+			{
+				std::uint64_t bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+				MovImmediate(bits);
+				MovQFromRax(xmm);
+				UnpckLPD(xmm, xmm);
+			}
+
+			// lea reg, [rbx + 16*loc]
+			void Address(Register reg, size_t loc)
+			{
+				Bytes({0x48, 0x8d, RbxRelative(reg)});
+				Displacement(loc);
+			}
+
+			// mov edx, imm32
+			void ThirdArgument(int value)
+			{
+				Bytes({0xba});
+				Immediate32(static_cast<std::uint32_t>(value));
+			}
+
+			// mov rax, imm64; call rax
+			void Call(void const* function)
+			{
+				MovImmediate(reinterpret_cast<std::uintptr_t>(function));
+				Bytes({0xff, 0xd0});
+			}
+
+		private:
+
+			void Bytes(std::initializer_list<unsigned char> bytes)
+			{
+				code_.insert(code_.end(), bytes);
+			}
+
+			// movq xmm, rax
+			void MovQFromRax(unsigned char xmm)
+			{
+				Bytes({0x66, 0x48, 0x0f, 0x6e, static_cast<unsigned char>(0xc0 | (xmm << 3) | rax)});
+			}
+
+			// mod=10 (32 bit displacement), rm=rbx
+			static unsigned char RbxRelative(unsigned char reg)
+			{
+				return static_cast<unsigned char>(0x80 | (reg << 3) | rbx);
+			}
+
+			void Displacement(size_t loc)
+			{
+				Immediate32(static_cast<std::uint32_t>(loc*sizeof(dbl_complex)));
+			}
+
+			void Immediate32(std::uint32_t value)
+			{
+				for (unsigned ii=0; ii<4; ++ii)
+					code_.push_back(static_cast<unsigned char>(value >> (8*ii)));
+			}
+
+			void MovImmediate(std::uint64_t value)
+			{
+				Bytes({0x48, 0xb8}); // mov rax, imm64
+				for (unsigned ii=0; ii<8; ++ii)
+					code_.push_back(static_cast<unsigned char>(value >> (8*ii)));
+			}
+
+			std::vector<unsigned char> code_;
+		};
+
+
+
+		// the product of the numbers at two locations, left in xmm3.  (ar*br - ai*bi, ar*bi + ai*br), the same products and sums as the interpreter's
+		void EmitProduct(Assembler & a, size_t in1, size_t in2)
+		{
+			a.Load(0, in1);  // [ar, ai]
+			a.Load(1, in2);  // [br, bi]
+			a.MovAPD(3, 0);
+			a.UnpckLPD(3, 3);      // [ar, ar]
+			a.UnpckHPD(0, 0);      // [ai, ai]
+			a.MulPD(3, 1);         // [ar*br, ar*bi]
+			a.ShufPDSwap(1, 1);    // [bi, br]
+			a.MulPD(0, 1);         // [ai*bi, ai*br]
+			a.SignMaskLow(2);
+			a.XorPD(0, 2);         // [-ai*bi, ai*br]
+			a.AddPD(3, 0);
+		}
+
+		// the number at a location times an integer, left in xmm0.  the interpreter multiplies by the integer as a real double, so this is (ar*k, ai*k)
+		void EmitScaled(Assembler & a, size_t in, int k)
+		{
+			a.Load(0, in);
+			a.Broadcast(1, static_cast<double>(k));
+			a.MulPD(0, 1);
+		}
+
+		void Emit(Assembler & a, Instruction const& instr, std::vector<int> const& integers)
+		{
+			switch (instr.op){
+				case Add:
+				case Subtract:
+					a.Load(0, instr.in1);
+					a.Load(1, instr.in2);
+					if (instr.op==Add)
+						a.AddPD(0, 1);
+					else
+						a.SubPD(0, 1);
+					a.Store(instr.out, 0);
+					return;
+
+				case Multiply:
+					EmitProduct(a, instr.in1, instr.in2);
+					a.Store(instr.out, 3);
+					return;
+
+				case Square:
+					EmitProduct(a, instr.in1, instr.in1);
+					a.Store(instr.out, 3);
+					return;
+
+				case FMA:
+					// in double precision the interpreter rounds the product, then the sum, so this does too
+					EmitProduct(a, instr.in1, instr.in2);
+					a.Load(1, instr.in3);
+					a.AddPD(3, 1);
+					a.Store(instr.out, 3);
+					return;
+
+				case ScaleByInt:
+					EmitScaled(a, instr.in1, integers[instr.in2]);
+					a.Store(instr.out, 0);
+					return;
+
+				case MulAddConst:
+					EmitScaled(a, instr.in1, integers[instr.in2]);
+					a.Load(1, instr.in3);
+					a.AddPD(0, 1);
+					a.Store(instr.out, 0);
+					return;
+
+				case Negate:
+					a.Load(0, instr.in1);
+					a.SignMaskLow(2);
+					a.UnpckLPD(2, 2);
+					a.XorPD(0, 2);
+					a.Store(instr.out, 0);
+					return;
+
+				case Assign:
+					a.Load(0, instr.in1);
+					a.Store(instr.out, 0);
+					return;
+
+				case IntPower:
+					a.Address(Assembler::rdi, instr.out);
+					a.Address(Assembler::rsi, instr.in1);
+					a.ThirdArgument(integers[instr.in2]);
+					a.Call(reinterpret_cast<void const*>(&IntPowerFunction));
+					return;
+
+				default:
+					break;
+			}
+
+			if (auto f = GetBinaryHelper(instr.op)){
+				a.Address(Assembler::rdi, instr.out);
+				a.Address(Assembler::rsi, instr.in1);
+				a.Address(Assembler::rdx, instr.in2);
+				a.Call(reinterpret_cast<void const*>(f));
+			}
+			else{
+				a.Address(Assembler::rdi, instr.out);
+				a.Address(Assembler::rsi, instr.in1);
+				a.Call(reinterpret_cast<void const*>(GetUnaryHelper(instr.op)));
+			}
+		}
+
+	} // namespace
+
+#endif // BERTINI_SLP_JIT_AVAILABLE
+
+
+
+	std::shared_ptr<const JITEvaluator> JITEvaluator::Compile(std::vector<Instruction> const& instructions, std::vector<int> const& integers, std::vector<size_t> const& block_bounds)
+	{
+#if BERTINI_SLP_JIT_AVAILABLE
+
+		// locations are 32 bit displacements from the start of memory
+		size_t largest_location = 0;
+		for (auto const& instr : instructions){
+			largest_location = std::max({largest_location, instr.in1, instr.out});
+			if (SecondOperandInMemory(instr.op))
+				largest_location = std::max(largest_location, instr.in2);
+			if (IsTernary(instr.op))
+				largest_location = std::max(largest_location, instr.in3);
+		}
+		if (largest_location >= std::numeric_limits<std::int32_t>::max() / sizeof(dbl_complex))
+			return nullptr;
+
+		Assembler a;
+		std::vector<size_t> block_starts;
+		for (size_t block=0; block+1<block_bounds.size(); ++block){
+			block_starts.push_back(a.Code().size());
+			a.Prologue();
+			for (auto ii=block_bounds[block]; ii<block_bounds[block+1]; ++ii)
+				Emit(a, instructions[ii], integers);
+			a.Epilogue();
+		}
+
+		auto const& code = a.Code();
+		void* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (memory==MAP_FAILED)
+			return nullptr;
+
+		auto size = code.size();
+		std::shared_ptr<void> mapped(memory, [size](void* m){ munmap(m, size);});
+
+		std::memcpy(memory, code.data(), size);
+		if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0)
+			return nullptr; // some systems forbid executable mappings.  then there's just the interpreter.
+
+		auto evaluator = std::make_shared<JITEvaluator>();
+		evaluator->code_ = mapped;
+		evaluator->code_size_ = size;
+		evaluator->block_bounds_ = block_bounds;
+		for (auto start : block_starts)
+			evaluator->blocks_.push_back(reinterpret_cast<BlockFunction>(static_cast<unsigned char*>(memory) + start));
+		return evaluator;
+
+#else
+		return nullptr;
+#endif
+	}
+
+
+
+	bool JITEvaluator::Run(dbl_complex* memory, size_t begin, size_t end) const
+	{
+		size_t first_block, end_block;
+		if (!slp_codegen::BlocksSpanning(block_bounds_, begin, end, first_block, end_block))
+			return false;
+
+		for (auto block = first_block; block<end_block; ++block)
+			blocks_[block](memory);
+		return true;
+	}
+
+} // namespace bertini
@@ -0,0 +1,350 @@
+//This file is part of Bertini 2.
+//
+//slp_kernels.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//slp_kernels.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with slp_kernels.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2021 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// silviana amethyst, university of wisconsin eau claire
+
+#include "bertini2/system/slp_kernels.hpp"
+
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(BERTINI_DISABLE_SIMD_KERNELS)
+	#define BERTINI_HAVE_X86_SIMD_KERNELS
+	#include <immintrin.h>
+#endif
+
+
+namespace bertini {
+	namespace slp_kernels {
+
+		std::string SIMDLevelToString(SIMDLevel level)
+		{
+			switch (level){
+				case SIMDLevel::Scalar: return "Scalar";
+				case SIMDLevel::AVX2: return "AVX2";
+				case SIMDLevel::AVX512: return "AVX512";
+			}
+			return "unknown";
+		}
+
+
+		namespace scalar {
+
+			void Add(double* o_re, double* o_im, const double* a_re, const double* a_im, const double* b_re, const double* b_im, std::size_t n){
+				for (std::size_t p = 0; p<n; ++p){
+					o_re[p] = a_re[p] + b_re[p];
+					o_im[p] = a_im[p] + b_im[p];
+				}
+			}
+
+			void Subtract(double* o_re, double* o_im, const double* a_re, const double* a_im, const double* b_re, const double* b_im, std::size_t n){
+				for (std::size_t p = 0; p<n; ++p){
+					o_re[p] = a_re[p] - b_re[p];
+					o_im[p] = a_im[p] - b_im[p];
+				}
+			}
+
+			void Multiply(double* o_re, double* o_im, const double* a_re, const double* a_im, const double* b_re, const double* b_im, std::size_t n){
+				for (std::size_t p = 0; p<n; ++p){
+					o_re[p] = a_re[p]*b_re[p] - a_im[p]*b_im[p];
+					o_im[p] = a_re[p]*b_im[p] + a_im[p]*b_re[p];
+				}
+			}
+
+			void Divide(double* o_re, double* o_im, const double* a_re, const double* a_im, const double* b_re, const double* b_im, std::size_t n){
+				for (std::size_t p = 0; p<n; ++p){
+					const double d = b_re[p]*b_re[p] + b_im[p]*b_im[p];
+					o_re[p] = (a_re[p]*b_re[p] + a_im[p]*b_im[p])/d;
+					o_im[p] = (a_im[p]*b_re[p] - a_re[p]*b_im[p])/d;
+				}
+			}
+
+			void Negate(double* o_re, double* o_im, const double* a_re, const double* a_im, std::size_t n){
+				for (std::size_t p = 0; p<n; ++p){
+					o_re[p] = -1.0*a_re[p];
+					o_im[p] = -1.0*a_im[p];
+				}
+			}
+
+			void Assign(double* o_re, double* o_im, const double* a_re, const double* a_im, std::size_t n){
+				for (std::size_t p = 0; p<n; ++p){
+					o_re[p] = a_re[p];
+					o_im[p] = a_im[p];
+				}
+			}
+
+			void Reciprocal(double* o_re, double* o_im, const double* a_re, const double* a_im, std::size_t n){
+				for (std::size_t p = 0; p<n; ++p){
+					const double d = a_re[p]*a_re[p] + a_im[p]*a_im[p];
+					o_re[p] = a_re[p]/d;
+					o_im[p] = (-1.0*a_im[p])/d;
+				}
+			}
+
+			void One(double* o_re, double* o_im, std::size_t n){
+				for (std::size_t p = 0; p<n; ++p){
+					o_re[p] = 1;
+					o_im[p] = 0;
+				}
+			}
+
+			void MultiplyInPlace(double* o_re, double* o_im, const double* z_re, const double* z_im, std::size_t n){
+				for (std::size_t p = 0; p<n; ++p){
+					const double r = o_re[p]*z_re[p] - o_im[p]*z_im[p];
+					o_im[p] = o_re[p]*z_im[p] + o_im[p]*z_re[p];
+					o_re[p] = r;
+				}
+			}
+
+			void SquareInPlace(double* z_re, double* z_im, std::size_t n){
+				for (std::size_t p = 0; p<n; ++p){
+					const double r = z_re[p]*z_re[p] - z_im[p]*z_im[p];
+					z_im[p] = 2.0*z_re[p]*z_im[p];
+					z_re[p] = r;
+				}
+			}
+
+		} // namespace scalar
+
+
+/**
+ The body of IntPower is the same at every level, given the level's helpers.  Square-and-multiply, on all the points at once.
+*/
+#define BERTINI_SLP_INTPOWER_BODY(NS) \
+	if (exponent<0){ \
+		NS::Reciprocal(z_re, z_im, a_re, a_im, n); \
+		exponent = -exponent; \
+	} \
+	else \
+		NS::Assign(z_re, z_im, a_re, a_im, n); \
+	NS::One(o_re, o_im, n); \
+	for (unsigned e = exponent; e>0; e >>= 1){ \
+		if (e & 1) \
+			NS::MultiplyInPlace(o_re, o_im, z_re, z_im, n); \
+		if (e > 1) \
+			NS::SquareInPlace(z_re, z_im, n); \
+	}
+
+		namespace scalar {
+			void IntPower(double* o_re, double* o_im, const double* a_re, const double* a_im, double* z_re, double* z_im, int exponent, std::size_t n){
+				BERTINI_SLP_INTPOWER_BODY(scalar)
+			}
+		}
+
+
+
+#ifdef BERTINI_HAVE_X86_SIMD_KERNELS
+
+/**
+ Defines the kernels for one x86 level, in namespace NS, compiled for TARGET, using vectors of type V holding W doubles, and the intrinsics PREFIX##_loadu_pd etc.  The points left over after the last full vector are done by the scalar kernels.
+
+ The AVX2 and AVX-512 kernels differ only in these, so they're written once, here.
+*/
+#define BERTINI_SLP_SIMD_KERNELS(NS, TARGET, V, W, PREFIX) \
+		namespace NS { \
+			__attribute__((target(TARGET))) \
+			void Add(double* o_re, double* o_im, const double* a_re, const double* a_im, const double* b_re, const double* b_im, std::size_t n){ \
+				std::size_t p = 0; \
+				for (; p+W<=n; p+=W){ \
+					PREFIX##_storeu_pd(o_re+p, PREFIX##_add_pd(PREFIX##_loadu_pd(a_re+p), PREFIX##_loadu_pd(b_re+p))); \
+					PREFIX##_storeu_pd(o_im+p, PREFIX##_add_pd(PREFIX##_loadu_pd(a_im+p), PREFIX##_loadu_pd(b_im+p))); \
+				} \
+				scalar::Add(o_re+p, o_im+p, a_re+p, a_im+p, b_re+p, b_im+p, n-p); \
+			} \
+			\
+			__attribute__((target(TARGET))) \
+			void Subtract(double* o_re, double* o_im, const double* a_re, const double* a_im, const double* b_re, const double* b_im, std::size_t n){ \
+				std::size_t p = 0; \
+				for (; p+W<=n; p+=W){ \
+					PREFIX##_storeu_pd(o_re+p, PREFIX##_sub_pd(PREFIX##_loadu_pd(a_re+p), PREFIX##_loadu_pd(b_re+p))); \
+					PREFIX##_storeu_pd(o_im+p, PREFIX##_sub_pd(PREFIX##_loadu_pd(a_im+p), PREFIX##_loadu_pd(b_im+p))); \
+				} \
+				scalar::Subtract(o_re+p, o_im+p, a_re+p, a_im+p, b_re+p, b_im+p, n-p); \
+			} \
+			\
+			__attribute__((target(TARGET))) \
+			void Multiply(double* o_re, double* o_im, const double* a_re, const double* a_im, const double* b_re, const double* b_im, std::size_t n){ \
+				std::size_t p = 0; \
+				for (; p+W<=n; p+=W){ \
+					const V ar = PREFIX##_loadu_pd(a_re+p), ai = PREFIX##_loadu_pd(a_im+p); \
+					const V br = PREFIX##_loadu_pd(b_re+p), bi = PREFIX##_loadu_pd(b_im+p); \
+					PREFIX##_storeu_pd(o_re+p, PREFIX##_sub_pd(PREFIX##_mul_pd(ar,br), PREFIX##_mul_pd(ai,bi))); \
+					PREFIX##_storeu_pd(o_im+p, PREFIX##_add_pd(PREFIX##_mul_pd(ar,bi), PREFIX##_mul_pd(ai,br))); \
+				} \
+				scalar::Multiply(o_re+p, o_im+p, a_re+p, a_im+p, b_re+p, b_im+p, n-p); \
+			} \
+			\
+			__attribute__((target(TARGET))) \
+			void Divide(double* o_re, double* o_im, const double* a_re, const double* a_im, const double* b_re, const double* b_im, std::size_t n){ \
+				std::size_t p = 0; \
+				for (; p+W<=n; p+=W){ \
+					const V ar = PREFIX##_loadu_pd(a_re+p), ai = PREFIX##_loadu_pd(a_im+p); \
+					const V br = PREFIX##_loadu_pd(b_re+p), bi = PREFIX##_loadu_pd(b_im+p); \
+					const V d = PREFIX##_add_pd(PREFIX##_mul_pd(br,br), PREFIX##_mul_pd(bi,bi)); \
+					PREFIX##_storeu_pd(o_re+p, PREFIX##_div_pd(PREFIX##_add_pd(PREFIX##_mul_pd(ar,br), PREFIX##_mul_pd(ai,bi)), d)); \
+					PREFIX##_storeu_pd(o_im+p, PREFIX##_div_pd(PREFIX##_sub_pd(PREFIX##_mul_pd(ai,br), PREFIX##_mul_pd(ar,bi)), d)); \
+				} \
+				scalar::Divide(o_re+p, o_im+p, a_re+p, a_im+p, b_re+p, b_im+p, n-p); \
+			} \
+			\
+			__attribute__((target(TARGET))) \
+			void Negate(double* o_re, double* o_im, const double* a_re, const double* a_im, std::size_t n){ \
+				const V minus_one = PREFIX##_set1_pd(-1.0); \
+				std::size_t p = 0; \
+				for (; p+W<=n; p+=W){ \
+					PREFIX##_storeu_pd(o_re+p, PREFIX##_mul_pd(minus_one, PREFIX##_loadu_pd(a_re+p))); \
+					PREFIX##_storeu_pd(o_im+p, PREFIX##_mul_pd(minus_one, PREFIX##_loadu_pd(a_im+p))); \
+				} \
+				scalar::Negate(o_re+p, o_im+p, a_re+p, a_im+p, n-p); \
+			} \
+			\
+			__attribute__((target(TARGET))) \
+			void Assign(double* o_re, double* o_im, const double* a_re, const double* a_im, std::size_t n){ \
+				std::size_t p = 0; \
+				for (; p+W<=n; p+=W){ \
+					PREFIX##_storeu_pd(o_re+p, PREFIX##_loadu_pd(a_re+p)); \
+					PREFIX##_storeu_pd(o_im+p, PREFIX##_loadu_pd(a_im+p)); \
+				} \
+				scalar::Assign(o_re+p, o_im+p, a_re+p, a_im+p, n-p); \
+			} \
+			\
+			__attribute__((target(TARGET))) \
+			void Reciprocal(double* o_re, double* o_im, const double* a_re, const double* a_im, std::size_t n){ \
+				const V minus_one = PREFIX##_set1_pd(-1.0); \
+				std::size_t p = 0; \
+				for (; p+W<=n; p+=W){ \
+					const V ar = PREFIX##_loadu_pd(a_re+p), ai = PREFIX##_loadu_pd(a_im+p); \
+					const V d = PREFIX##_add_pd(PREFIX##_mul_pd(ar,ar), PREFIX##_mul_pd(ai,ai)); \
+					PREFIX##_storeu_pd(o_re+p, PREFIX##_div_pd(ar, d)); \
+					PREFIX##_storeu_pd(o_im+p, PREFIX##_div_pd(PREFIX##_mul_pd(minus_one, ai), d)); \
+				} \
+				scalar::Reciprocal(o_re+p, o_im+p, a_re+p, a_im+p, n-p); \
+			} \
+			\
+			__attribute__((target(TARGET))) \
+			void One(double* o_re, double* o_im, std::size_t n){ \
+				const V one = PREFIX##_set1_pd(1.0), zero = PREFIX##_setzero_pd(); \
+				std::size_t p = 0; \
+				for (; p+W<=n; p+=W){ \
+					PREFIX##_storeu_pd(o_re+p, one); \
+					PREFIX##_storeu_pd(o_im+p, zero); \
+				} \
+				scalar::One(o_re+p, o_im+p, n-p); \
+			} \
+			\
+			__attribute__((target(TARGET))) \
+			void MultiplyInPlace(double* o_re, double* o_im, const double* z_re, const double* z_im, std::size_t n){ \
+				std::size_t p = 0; \
+				for (; p+W<=n; p+=W){ \
+					const V orr = PREFIX##_loadu_pd(o_re+p), oi = PREFIX##_loadu_pd(o_im+p); \
+					const V zr = PREFIX##_loadu_pd(z_re+p), zi = PREFIX##_loadu_pd(z_im+p); \
+					PREFIX##_storeu_pd(o_re+p, PREFIX##_sub_pd(PREFIX##_mul_pd(orr,zr), PREFIX##_mul_pd(oi,zi))); \
+					PREFIX##_storeu_pd(o_im+p, PREFIX##_add_pd(PREFIX##_mul_pd(orr,zi), PREFIX##_mul_pd(oi,zr))); \
+				} \
+				scalar::MultiplyInPlace(o_re+p, o_im+p, z_re+p, z_im+p, n-p); \
+			} \
+			\
+			__attribute__((target(TARGET))) \
+			void SquareInPlace(double* z_re, double* z_im, std::size_t n){ \
+				const V two = PREFIX##_set1_pd(2.0); \
+				std::size_t p = 0; \
+				for (; p+W<=n; p+=W){ \
+					const V zr = PREFIX##_loadu_pd(z_re+p), zi = PREFIX##_loadu_pd(z_im+p); \
+					PREFIX##_storeu_pd(z_re+p, PREFIX##_sub_pd(PREFIX##_mul_pd(zr,zr), PREFIX##_mul_pd(zi,zi))); \
+					PREFIX##_storeu_pd(z_im+p, PREFIX##_mul_pd(PREFIX##_mul_pd(two,zr), zi)); \
+				} \
+				scalar::SquareInPlace(z_re+p, z_im+p, n-p); \
+			} \
+			\
+			__attribute__((target(TARGET))) \
+			void IntPower(double* o_re, double* o_im, const double* a_re, const double* a_im, double* z_re, double* z_im, int exponent, std::size_t n){ \
+				BERTINI_SLP_INTPOWER_BODY(NS) \
+			} \
+		}
+
+		BERTINI_SLP_SIMD_KERNELS(avx2, "avx2", __m256d, 4, _mm256)
+		BERTINI_SLP_SIMD_KERNELS(avx512, "avx512f", __m512d, 8, _mm512)
+
+#undef BERTINI_SLP_SIMD_KERNELS
+
+#endif // BERTINI_HAVE_X86_SIMD_KERNELS
+
+#undef BERTINI_SLP_INTPOWER_BODY
+
+
+
+		bool Supported(SIMDLevel level)
+		{
+			switch (level){
+				case SIMDLevel::Scalar:
+					return true;
+
+#ifdef BERTINI_HAVE_X86_SIMD_KERNELS
+				case SIMDLevel::AVX2:
+					return __builtin_cpu_supports("avx2");
+				case SIMDLevel::AVX512:
+					return __builtin_cpu_supports("avx512f");
+#endif
+				default:
+					return false;
+			}
+		}
+
+
+		SIMDLevel BestSupportedLevel()
+		{
+			if (Supported(SIMDLevel::AVX512))
+				return SIMDLevel::AVX512;
+			if (Supported(SIMDLevel::AVX2))
+				return SIMDLevel::AVX2;
+			return SIMDLevel::Scalar;
+		}
+
+
+		KernelTable const& Kernels(SIMDLevel level)
+		{
+			static const KernelTable scalar_kernels{scalar::Add, scalar::Subtract, scalar::Multiply, scalar::Divide, scalar::Negate, scalar::Assign, scalar::IntPower};
+#ifdef BERTINI_HAVE_X86_SIMD_KERNELS
+			static const KernelTable avx2_kernels{avx2::Add, avx2::Subtract, avx2::Multiply, avx2::Divide, avx2::Negate, avx2::Assign, avx2::IntPower};
+			static const KernelTable avx512_kernels{avx512::Add, avx512::Subtract, avx512::Multiply, avx512::Divide, avx512::Negate, avx512::Assign, avx512::IntPower};
+#endif
+
+			if (!Supported(level))
+				throw std::runtime_error("SLP kernels for " + SIMDLevelToString(level) + " are not supported on this CPU");
+
+			switch (level){
+#ifdef BERTINI_HAVE_X86_SIMD_KERNELS
+				case SIMDLevel::AVX2: return avx2_kernels;
+				case SIMDLevel::AVX512: return avx512_kernels;
+#endif
+				default: return scalar_kernels;
+			}
+		}
+
+
+		KernelTable const& Kernels()
+		{
+			static KernelTable const& best = Kernels(BestSupportedLevel());
+			return best;
+		}
+
+	} // namespace slp_kernels
+} // namespace bertini
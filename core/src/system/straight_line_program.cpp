@@ -25,6 +25,21 @@
 
 #include "bertini2/system/straight_line_program.hpp"
 #include "bertini2/system/system.hpp"
+#include "bertini2/system/slp_kernels.hpp"
+#include "bertini2/system/slp_codegen.hpp"
+#include "bertini2/system/slp_jit.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <tuple>
+#include <typeinfo>
 
 
 
@@ -54,6 +69,10 @@ namespace bertini{
 		case Atan: return "Atan";
 		case Assign: return "Assign";
 		case IntPower: return "IntPower";
+		case FMA: return "FMA";
+		case Square: return "Square";
+		case ScaleByInt: return "ScaleByInt";
+		case MulAddConst: return "MulAddConst";
 		}
 	}
 
@@ -65,26 +84,34 @@ namespace bertini{
 		*this = compiler.Compile(sys);
 	}
 
-	void StraightLineProgram::precision(unsigned new_precision) const{
+	StraightLineProgram::Workspace StraightLineProgram::MakeWorkspace(unsigned precision) const{
+		Workspace w;
+		w.Precision = precision;
 
-		if (new_precision==this->precision_){
-			return;
-		}
-		else{
-			auto& mem = std::get<std::vector<mpfr_complex>>(memory_);
+		w.GetMemory<dbl_complex>().resize(memory_size_);
+		w.GetMemory<mpfr_complex>().resize(memory_size_);
+		for (auto& n : w.GetMemory<mpfr_complex>())
+			Precision(n, precision);
 
-			for (auto& p: true_values_of_numbers_)
-			{
-				auto& n = std::get<Nd>(p);
-				auto& loc = std::get<size_t>(p);
+		CopyNumbersIntoMemory<dbl_complex>(w);
+		CopyNumbersIntoMemory<mpfr_complex>(w);
+		return w;
+	}
 
-				mem[loc] = n->Eval<mpfr_complex>();
-			}
 
-			for (auto& n : mem)
-				Precision(n, new_precision);
+	void StraightLineProgram::precision(Workspace & w, unsigned new_precision) const{
+
+		if (new_precision==w.Precision){
+			return;
+		}
+		else{
+			// everything but the numbers and what's computed from them alone is overwritten before it's read, so only the precision matters.  those are redone by CopyNumbersIntoMemory.
+			for (auto& n : w.GetMemory<mpfr_complex>())
+				if (Precision(n)!=new_precision)
+					Precision(n, new_precision);
 
-			this->precision_ = new_precision;
+			w.Precision = new_precision;
+			CopyNumbersIntoMemory<mpfr_complex>(w);
 		}
 
 
@@ -149,22 +176,41 @@ namespace bertini{
 		out << std::endl << std::endl;
 
 
+		out << std::endl << "optimization:" << std::endl;
+		out << "instructions " << s.optimization_statistics_.InstructionsBefore << " --> " << s.optimization_statistics_.InstructionsAfter << std::endl;
+		out << "memory " << s.optimization_statistics_.MemoryBefore << " --> " << s.optimization_statistics_.MemoryAfter << std::endl;
+
+		out << std::endl << "instruction blocks (indices of instructions):" << std::endl;
+		out << "Constant [0," << s.instruction_ranges_.ConstantEnd << ")" << std::endl;
+		if (s.HavePathVariable())
+			out << "TimeOnly [" << s.instruction_ranges_.ConstantEnd << "," << s.instruction_ranges_.TimeOnlyEnd << ")" << std::endl;
+		out << "Functions [" << s.instruction_ranges_.TimeOnlyEnd << "," << s.instruction_ranges_.FunctionsEnd << ")" << std::endl;
+		out << "SharedDerivatives [" << s.instruction_ranges_.FunctionsEnd << "," << s.instruction_ranges_.SharedDerivativesEnd << ")" << std::endl;
+		out << "Jacobian [" << s.instruction_ranges_.SharedDerivativesEnd << "," << s.instruction_ranges_.JacobianEnd << ")" << std::endl;
+		if (s.HavePathVariable())
+			out << "TimeDeriv [" << s.instruction_ranges_.JacobianEnd << "," << s.instruction_ranges_.TimeDerivEnd << ")" << std::endl;
+
+		if (s.HasJIT())
+			out << std::endl << "machine code for double precision: " << s.jit_evaluator_->CodeSize() << " bytes" << std::endl;
+
+		if (s.HasNativeEvaluator())
+			out << std::endl << "native evaluator: " << s.native_evaluator_->Library() << std::endl;
+
 		out << std::endl << "instructions: " << std::endl;
 		for (size_t ii(0); ii<s.instructions_.size(); /*it's in the loop at access time*/){
 			auto op = static_cast<Operation>(s.instructions_[ii++]);
 			out << OpcodeToString(op) << "(";
-			if (IsUnary(op))
-				out << s.instructions_[ii++] << ") --> " << s.instructions_[ii++] << std::endl;
-
-			else
-				out << s.instructions_[ii++] << "," << s.instructions_[ii++] << ") --> " << s.instructions_[ii++] << std::endl;
+			const auto num_operands = InstructionLength(op)-2;
+			for (size_t jj(0); jj<num_operands; ++jj)
+				out << (jj>0 ? "," : "") << s.instructions_[ii++];
+			out << ") --> " << s.instructions_[ii++] << std::endl;
 		}
 
 
 
 
-		auto& memory_dbl =  std::get<std::vector<dbl_complex>>(s.memory_);
-		auto& memory_mpfr =  std::get<std::vector<mpfr_complex>>(s.memory_);
+		auto& memory_dbl =  s.workspace_.GetMemory<dbl_complex>();
+		auto& memory_mpfr =  s.workspace_.GetMemory<mpfr_complex>();
 
 		out << "\nvariable values in dbl memory:\n";
 		for (unsigned ii=0; ii<s.number_of_.Variables; ++ii){
@@ -204,129 +250,867 @@ namespace bertini{
 
 
 	template<typename NumT>
-	void StraightLineProgram::Eval() const{
+	void StraightLineProgram::Eval(Workspace & w) const{
 
-		auto& memory =  std::get<std::vector<NumT>>(memory_);
+		if (w.Evaluated.All())
+			return;
+
+		EvalTimeStage<NumT>(w);
+		EvalRange<NumT>(w, instruction_ranges_.TimeOnlyEnd, decoded_instructions_.size());
+
+		w.Evaluated.SetAll();
+	}
+
+	template void StraightLineProgram::Eval<dbl_complex>(Workspace &) const;
+	template void StraightLineProgram::Eval<mpfr_complex>(Workspace &) const;
 
 
+
+
+	template<typename NumT>
+	void StraightLineProgram::EvalRange(Workspace & w, size_t begin, size_t end) const{
+
+		if (begin==end)
+			return;
+
 #ifndef BERTINI_DISABLE_PRECISION_CHECKS
-		if (! std::is_same<NumT,dbl_complex>::value && Precision(memory[0])!=this->precision_){
+		if (! std::is_same<NumT,dbl_complex>::value && Precision(w.GetMemory<NumT>()[0])!=w.Precision){
 			throw std::runtime_error("memory and SLP are out-of-sync WRT precision");
 		}
 #endif
 
+		if (w.Profiling){
+			EvalRangeProfiled<NumT>(w, begin, end);
+			return;
+		}
 
-		if (is_evaluated_)
+		if (native_evaluator_ && native_evaluator_->Run(w.GetMemory<NumT>().data(), begin, end))
 			return;
 
-		for (int ii = 0; ii<instructions_.size();/*the increment is done at end of loop depending on arity */) {
+		switch (dispatch_method_){
+			case DispatchMethod::Switch:
+				EvalRangeSwitch<NumT>(w, instruction_offsets_[begin], instruction_offsets_[end]);
+				break;
+			case DispatchMethod::Threaded:
+				EvalRangeThreaded<NumT>(w, begin, end);
+				break;
+			case DispatchMethod::JIT:
+				if constexpr (std::is_same<NumT,dbl_complex>::value)
+					if (jit_evaluator_ && jit_evaluator_->Run(w.GetMemory<NumT>().data(), begin, end))
+						break;
+				EvalRangeThreaded<NumT>(w, begin, end);
+				break;
+		}
+	}
+
+	template void StraightLineProgram::EvalRange<dbl_complex>(Workspace &, size_t, size_t) const;
+	template void StraightLineProgram::EvalRange<mpfr_complex>(Workspace &, size_t, size_t) const;
+
+
+
+
+
+	template<typename NumT>
+	void StraightLineProgram::EvalRangeSwitch(Workspace & w, size_t begin, size_t end) const{
+
+		auto& memory = w.GetMemory<NumT>();
+
+		for (size_t ii = begin; ii<end;/*the increment is done at end of loop depending on arity */) {
 			//in the unary case the loop will increment by 3
 			//binary: by 4
+			//ternary: by 5
 
 			switch (instructions_[ii]) {
 
 				case Add:
-					memory[this->instructions_[ii+3]] = memory[instructions_[ii+1]] + memory[instructions_[ii+2]];
+					inplace::Add(memory[this->instructions_[ii+3]], memory[instructions_[ii+1]], memory[instructions_[ii+2]]);
 					break;
 
 				case Subtract:
-					memory[this->instructions_[ii+3]] = memory[instructions_[ii+1]] - memory[instructions_[ii+2]];
+					inplace::Subtract(memory[this->instructions_[ii+3]], memory[instructions_[ii+1]], memory[instructions_[ii+2]]);
 					break;
 
 				case Multiply:
-					memory[this->instructions_[ii+3]] = memory[instructions_[ii+1]] * memory[instructions_[ii+2]];
+					inplace::Multiply(memory[this->instructions_[ii+3]], memory[instructions_[ii+1]], memory[instructions_[ii+2]]);
 					break;
 
 				case Divide:
-					memory[this->instructions_[ii+3]] = memory[instructions_[ii+1]] / memory[instructions_[ii+2]];
+					inplace::Divide(memory[this->instructions_[ii+3]], memory[instructions_[ii+1]], memory[instructions_[ii+2]]);
 					break;
 
 				case Power:
-					memory[this->instructions_[ii+3]] = pow(memory[instructions_[ii+1]], memory[instructions_[ii+2]]);
+					inplace::Power(memory[this->instructions_[ii+3]], memory[instructions_[ii+1]], memory[instructions_[ii+2]]);
 					break;
 
 				case IntPower:
 					{
-					memory[this->instructions_[ii+3]] = pow(memory[instructions_[ii+1]], this->integers_[instructions_[ii+2]]);
+					inplace::IntPower(memory[this->instructions_[ii+3]], memory[instructions_[ii+1]], this->integers_[instructions_[ii+2]]);
 					break;
 					}
 
 				case Assign:
-					memory[this->instructions_[ii+2]] = memory[instructions_[ii+1]];
+					inplace::Assign(memory[this->instructions_[ii+2]], memory[instructions_[ii+1]]);
 					break;
 
 				case Negate:
-					memory[this->instructions_[ii+2]] = -(memory[instructions_[ii+1]]);
+					inplace::Negate(memory[this->instructions_[ii+2]], memory[instructions_[ii+1]]);
 					break;
 
 				case Sqrt:
-					memory[this->instructions_[ii+2]] = sqrt(memory[instructions_[ii+1]]);
+					inplace::Sqrt(memory[this->instructions_[ii+2]], memory[instructions_[ii+1]]);
 					break;
 
 				case Log:
-					memory[this->instructions_[ii+2]] = log(memory[instructions_[ii+1]]);
+					inplace::Log(memory[this->instructions_[ii+2]], memory[instructions_[ii+1]]);
 					break;
 
 				case Exp:
-					memory[this->instructions_[ii+2]] = exp(memory[instructions_[ii+1]]);
+					inplace::Exp(memory[this->instructions_[ii+2]], memory[instructions_[ii+1]]);
 					break;
 
 				case Sin:
-					memory[this->instructions_[ii+2]] = sin(memory[instructions_[ii+1]]);
+					inplace::Sin(memory[this->instructions_[ii+2]], memory[instructions_[ii+1]]);
 					break;
 
 				case Cos:
-					memory[this->instructions_[ii+2]] = cos(memory[instructions_[ii+1]]);
+					inplace::Cos(memory[this->instructions_[ii+2]], memory[instructions_[ii+1]]);
 					break;
 
 				case Tan:
-					memory[this->instructions_[ii+2]] = tan(memory[instructions_[ii+1]]);
+					inplace::Tan(memory[this->instructions_[ii+2]], memory[instructions_[ii+1]]);
 					break;
 
 				case Asin:
-					memory[this->instructions_[ii+2]] = asin(memory[instructions_[ii+1]]);
+					inplace::Asin(memory[this->instructions_[ii+2]], memory[instructions_[ii+1]]);
 					break;
 
 				case Acos:
-					memory[this->instructions_[ii+2]] = acos(memory[instructions_[ii+1]]);
+					inplace::Acos(memory[this->instructions_[ii+2]], memory[instructions_[ii+1]]);
 					break;
 
 				case Atan:
-					memory[this->instructions_[ii+2]] = atan(memory[instructions_[ii+1]]);
+					inplace::Atan(memory[this->instructions_[ii+2]], memory[instructions_[ii+1]]);
+					break;
+
+				case Square:
+					inplace::Square(memory[this->instructions_[ii+2]], memory[instructions_[ii+1]]);
+					break;
+
+				case ScaleByInt:
+					inplace::ScaleByInt(memory[this->instructions_[ii+3]], memory[instructions_[ii+1]], this->integers_[instructions_[ii+2]]);
+					break;
+
+				case FMA:
+					inplace::FMA(memory[this->instructions_[ii+4]], memory[instructions_[ii+1]], memory[instructions_[ii+2]], memory[instructions_[ii+3]]);
+					break;
+
+				case MulAddConst:
+					inplace::MulAddConst(memory[this->instructions_[ii+4]], memory[instructions_[ii+1]], this->integers_[instructions_[ii+2]], memory[instructions_[ii+3]]);
 					break;
 
 			} // switch for operation
 
 
-			if (IsUnary(static_cast<Operation>(instructions_[ii]))) {
-				ii = ii+3;
+			ii += InstructionLength(static_cast<Operation>(instructions_[ii]));
+		} // for loop around operations
+	}
+
+	template void StraightLineProgram::EvalRangeSwitch<dbl_complex>(Workspace &, size_t, size_t) const;
+	template void StraightLineProgram::EvalRangeSwitch<mpfr_complex>(Workspace &, size_t, size_t) const;
+
+
+
+
+	template<typename NumT>
+	void StraightLineProgram::EvalRangeThreaded(Workspace & w, size_t begin, size_t end) const{
+
+		if (begin==end)
+			return;
+
+		auto& memory = w.GetMemory<NumT>();
+		Instruction const* instr = decoded_instructions_.data() + begin;
+		Instruction const* const stop = decoded_instructions_.data() + end;
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(BERTINI_DISABLE_COMPUTED_GOTO)
+
+		// token-threaded code.  each opcode is a single bit, so its position is its index in this table.  each handler jumps straight to the next one, so there's no loop and no switch, and the branch predictor gets one indirect jump per handler to learn.
+		static void* const handlers[] = {
+			&&do_add, &&do_subtract, &&do_multiply, &&do_divide, &&do_power, &&do_exp, &&do_log, &&do_negate, &&do_sqrt,
+			&&do_sin, &&do_cos, &&do_tan, &&do_asin, &&do_acos, &&do_atan, &&do_assign, &&do_int_power,
+			&&do_fma, &&do_square, &&do_scale_by_int, &&do_mul_add_const
+		};
+
+#define BERTINI_SLP_NEXT_INSTRUCTION if (++instr==stop) return; goto *handlers[__builtin_ctz(instr->op)];
+
+		goto *handlers[__builtin_ctz(instr->op)];
+
+		do_add: inplace::Add(memory[instr->out], memory[instr->in1], memory[instr->in2]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_subtract: inplace::Subtract(memory[instr->out], memory[instr->in1], memory[instr->in2]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_multiply: inplace::Multiply(memory[instr->out], memory[instr->in1], memory[instr->in2]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_divide: inplace::Divide(memory[instr->out], memory[instr->in1], memory[instr->in2]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_power: inplace::Power(memory[instr->out], memory[instr->in1], memory[instr->in2]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_exp: inplace::Exp(memory[instr->out], memory[instr->in1]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_log: inplace::Log(memory[instr->out], memory[instr->in1]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_negate: inplace::Negate(memory[instr->out], memory[instr->in1]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_sqrt: inplace::Sqrt(memory[instr->out], memory[instr->in1]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_sin: inplace::Sin(memory[instr->out], memory[instr->in1]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_cos: inplace::Cos(memory[instr->out], memory[instr->in1]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_tan: inplace::Tan(memory[instr->out], memory[instr->in1]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_asin: inplace::Asin(memory[instr->out], memory[instr->in1]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_acos: inplace::Acos(memory[instr->out], memory[instr->in1]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_atan: inplace::Atan(memory[instr->out], memory[instr->in1]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_assign: inplace::Assign(memory[instr->out], memory[instr->in1]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_int_power: inplace::IntPower(memory[instr->out], memory[instr->in1], integers_[instr->in2]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_fma: inplace::FMA(memory[instr->out], memory[instr->in1], memory[instr->in2], memory[instr->in3]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_square: inplace::Square(memory[instr->out], memory[instr->in1]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_scale_by_int: inplace::ScaleByInt(memory[instr->out], memory[instr->in1], integers_[instr->in2]); BERTINI_SLP_NEXT_INSTRUCTION
+		do_mul_add_const: inplace::MulAddConst(memory[instr->out], memory[instr->in1], integers_[instr->in2], memory[instr->in3]); BERTINI_SLP_NEXT_INSTRUCTION
+
+#undef BERTINI_SLP_NEXT_INSTRUCTION
+
+#else
+		// no computed goto with this compiler.  at least the instructions are decoded already.
+		for (; instr!=stop; ++instr){
+			switch (instr->op){
+				case Add: inplace::Add(memory[instr->out], memory[instr->in1], memory[instr->in2]); break;
+				case Subtract: inplace::Subtract(memory[instr->out], memory[instr->in1], memory[instr->in2]); break;
+				case Multiply: inplace::Multiply(memory[instr->out], memory[instr->in1], memory[instr->in2]); break;
+				case Divide: inplace::Divide(memory[instr->out], memory[instr->in1], memory[instr->in2]); break;
+				case Power: inplace::Power(memory[instr->out], memory[instr->in1], memory[instr->in2]); break;
+				case Exp: inplace::Exp(memory[instr->out], memory[instr->in1]); break;
+				case Log: inplace::Log(memory[instr->out], memory[instr->in1]); break;
+				case Negate: inplace::Negate(memory[instr->out], memory[instr->in1]); break;
+				case Sqrt: inplace::Sqrt(memory[instr->out], memory[instr->in1]); break;
+				case Sin: inplace::Sin(memory[instr->out], memory[instr->in1]); break;
+				case Cos: inplace::Cos(memory[instr->out], memory[instr->in1]); break;
+				case Tan: inplace::Tan(memory[instr->out], memory[instr->in1]); break;
+				case Asin: inplace::Asin(memory[instr->out], memory[instr->in1]); break;
+				case Acos: inplace::Acos(memory[instr->out], memory[instr->in1]); break;
+				case Atan: inplace::Atan(memory[instr->out], memory[instr->in1]); break;
+				case Assign: inplace::Assign(memory[instr->out], memory[instr->in1]); break;
+				case IntPower: inplace::IntPower(memory[instr->out], memory[instr->in1], integers_[instr->in2]); break;
+				case FMA: inplace::FMA(memory[instr->out], memory[instr->in1], memory[instr->in2], memory[instr->in3]); break;
+				case Square: inplace::Square(memory[instr->out], memory[instr->in1]); break;
+				case ScaleByInt: inplace::ScaleByInt(memory[instr->out], memory[instr->in1], integers_[instr->in2]); break;
+				case MulAddConst: inplace::MulAddConst(memory[instr->out], memory[instr->in1], integers_[instr->in2], memory[instr->in3]); break;
+			}
+		}
+#endif
+	}
+
+	template void StraightLineProgram::EvalRangeThreaded<dbl_complex>(Workspace &, size_t, size_t) const;
+	template void StraightLineProgram::EvalRangeThreaded<mpfr_complex>(Workspace &, size_t, size_t) const;
+
+
+
+
+	template<typename NumT>
+	void StraightLineProgram::EvalRangeProfiled(Workspace & w, size_t begin, size_t end) const{
+
+		auto& entries = w.Profile.For<NumT>();
+		for (auto ii = begin; ii<end; ++ii){
+			const auto start = std::chrono::steady_clock::now();
+			EvalRangeThreaded<NumT>(w, ii, ii+1);
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+			auto& entry = entries[OpcodeIndex(decoded_instructions_[ii].op)];
+			++entry.Count;
+			entry.Seconds += elapsed.count();
+		}
+	}
+
+	template void StraightLineProgram::EvalRangeProfiled<dbl_complex>(Workspace &, size_t, size_t) const;
+	template void StraightLineProgram::EvalRangeProfiled<mpfr_complex>(Workspace &, size_t, size_t) const;
+
+
+
+	StraightLineProgram::ProgramStatistics StraightLineProgram::GetProgramStatistics() const{
+		ProgramStatistics stats;
+		stats.Instructions = decoded_instructions_.size();
+		stats.Memory = memory_size_;
+		stats.ConstantStage = instruction_ranges_.ConstantEnd;
+		stats.TimeStage = instruction_ranges_.TimeOnlyEnd - instruction_ranges_.ConstantEnd;
+
+		// the length of the chain ending at the value in each location.  memory is reused, but each instruction reads the values written most recently, so going in order gets the right ones.
+		std::vector<size_t> chain(memory_size_, 0);
+		for (auto const& instr : decoded_instructions_){
+			auto longest = chain[instr.in1];
+			if (SecondOperandInMemory(instr.op))
+				longest = std::max(longest, chain[instr.in2]);
+			if (IsTernary(instr.op))
+				longest = std::max(longest, chain[instr.in3]);
+			chain[instr.out] = longest + 1;
+			stats.LongestChain = std::max(stats.LongestChain, chain[instr.out]);
+		}
+		return stats;
+	}
+
+	StraightLineProgram::EvaluationProfile StraightLineProgram::GetProfile(Workspace const& w) const{
+		auto profile = w.Profile;
+		profile.Program = GetProgramStatistics();
+		return profile;
+	}
+
+	void StraightLineProgram::EvaluationProfile::WriteJSON(std::ostream & out) const{
+		out << "{\n";
+		out << "  \"program\": {\"instructions\": " << Program.Instructions << ", \"memory\": " << Program.Memory << ", \"longest_chain\": " << Program.LongestChain << "},\n";
+		out << "  \"opcodes\": [\n";
+		for (unsigned ii = 0; ii<NumOperations; ++ii){
+			out << "    {\"opcode\": \"" << OpcodeToString(static_cast<Operation>(1u << ii)) << "\", "
+			    << "\"dbl_complex\": {\"count\": " << Double[ii].Count << ", \"seconds\": " << Double[ii].Seconds << "}, "
+			    << "\"mpfr_complex\": {\"count\": " << Multiple[ii].Count << ", \"seconds\": " << Multiple[ii].Seconds << "}}"
+			    << (ii+1<NumOperations ? ",\n" : "\n");
+		}
+		out << "  ]\n}\n";
+	}
+
+	std::ostream& operator<<(std::ostream & out, StraightLineProgram::EvaluationProfile const& p){
+		out << p.Program.Instructions << " instructions, memory for " << p.Program.Memory << " numbers, longest chain of dependent instructions " << p.Program.LongestChain << "\n\n";
+
+		out << std::left << std::setw(10) << "opcode" << std::right
+		    << std::setw(14) << "dbl count" << std::setw(14) << "dbl seconds"
+		    << std::setw(14) << "mpfr count" << std::setw(14) << "mpfr seconds" << "\n";
+		for (unsigned ii = 0; ii<NumOperations; ++ii){
+			if (p.Double[ii].Count==0 && p.Multiple[ii].Count==0)
+				continue;
+			out << std::left << std::setw(10) << OpcodeToString(static_cast<Operation>(1u << ii)) << std::right
+			    << std::setw(14) << p.Double[ii].Count << std::setw(14) << p.Double[ii].Seconds
+			    << std::setw(14) << p.Multiple[ii].Count << std::setw(14) << p.Multiple[ii].Seconds << "\n";
+		}
+		return out;
+	}
+
+
+
 
+	void StraightLineProgram::DecodeInstructions(){
+		decoded_instructions_.clear();
+		instruction_offsets_.clear();
+
+		for (size_t ii(0); ii<instructions_.size(); ){
+			auto op = static_cast<Operation>(instructions_[ii]);
+			instruction_offsets_.push_back(ii);
+			if (IsUnary(op))
+				decoded_instructions_.push_back({op, instructions_[ii+1], 0, instructions_[ii+2]});
+			else if (IsTernary(op))
+				decoded_instructions_.push_back({op, instructions_[ii+1], instructions_[ii+2], instructions_[ii+4], instructions_[ii+3]});
+			else
+				decoded_instructions_.push_back({op, instructions_[ii+1], instructions_[ii+2], instructions_[ii+3]});
+			ii += InstructionLength(op);
+		}
+		instruction_offsets_.push_back(instructions_.size());
+	}
+
+
+	void StraightLineProgram::CompileJIT(){
+		jit_evaluator_ = JITEvaluator::Compile(decoded_instructions_, integers_, instruction_ranges_.Bounds());
+	}
+
+
+	template<>
+	void StraightLineProgram::CopyNumbersIntoMemory<dbl_complex>(Workspace & w) const
+	{
+		std::lock_guard<std::mutex> lock(numbers_->Mutex);
+
+		auto& values = numbers_->Double;
+		if (values.size()!=true_values_of_numbers_.size()){
+			values.clear();
+			for (auto const& x: true_values_of_numbers_)
+				values.push_back(x.first->Eval<dbl_complex>());
+		}
+
+		for (size_t ii{0}; ii<true_values_of_numbers_.size(); ++ii)
+			w.GetMemory<dbl_complex>()[true_values_of_numbers_[ii].second] = values[ii];
+
+		EvalConstantStage<dbl_complex>(w);
+	}
+
+	template<>
+	void StraightLineProgram::CopyNumbersIntoMemory<mpfr_complex>(Workspace & w) const
+	{
+		std::lock_guard<std::mutex> lock(numbers_->Mutex);
+
+		// the numbers are only evaluated from their nodes when going higher than ever before.  otherwise they're rounded from the ones already made.
+		auto& values = numbers_->Multiple;
+		if (values.size()!=true_values_of_numbers_.size() || w.Precision>numbers_->HighestPrecision){
+			values.resize(true_values_of_numbers_.size());
+			for (size_t ii{0}; ii<true_values_of_numbers_.size(); ++ii){
+				values[ii] = true_values_of_numbers_[ii].first->Eval<mpfr_complex>();
+				Precision(values[ii], w.Precision);
 			}
-			//in the binary case the loop will increment by 4
-			else {
-				ii = ii+4;
+			numbers_->HighestPrecision = w.Precision;
+		}
+
+		auto& mem = w.GetMemory<mpfr_complex>();
+		for (size_t ii{0}; ii<true_values_of_numbers_.size(); ++ii){
+			auto& n = mem[true_values_of_numbers_[ii].second];
+			n = values[ii];
+			Precision(n, w.Precision);
+		}
+
+		EvalConstantStage<mpfr_complex>(w);
+	}
+
+
+
+
+	namespace {
+		/**
+		 \brief Apply one operation to one point.  For the operations with no vectorizable form.
+
+		 \param b The second operand.  Ignored for unary operations, and those whose second operand is an integer.
+		 \param c The third operand.  Only used for the ternary operations.
+		 \param integer The exponent for IntPower, or the factor for ScaleByInt and MulAddConst.
+		 */
+		template<typename NumT>
+		void ApplyOperation(Operation op, NumT & result, NumT const& a, NumT const& b, NumT const& c, int integer){
+			switch (op){
+				case Add: inplace::Add(result, a, b); break;
+				case Subtract: inplace::Subtract(result, a, b); break;
+				case Multiply: inplace::Multiply(result, a, b); break;
+				case Divide: inplace::Divide(result, a, b); break;
+				case Power: inplace::Power(result, a, b); break;
+				case IntPower: inplace::IntPower(result, a, integer); break;
+				case FMA: inplace::FMA(result, a, b, c); break;
+				case Square: inplace::Square(result, a); break;
+				case ScaleByInt: inplace::ScaleByInt(result, a, integer); break;
+				case MulAddConst: inplace::MulAddConst(result, a, integer, c); break;
+				case Assign: inplace::Assign(result, a); break;
+				case Negate: inplace::Negate(result, a); break;
+				case Sqrt: inplace::Sqrt(result, a); break;
+				case Log: inplace::Log(result, a); break;
+				case Exp: inplace::Exp(result, a); break;
+				case Sin: inplace::Sin(result, a); break;
+				case Cos: inplace::Cos(result, a); break;
+				case Tan: inplace::Tan(result, a); break;
+				case Asin: inplace::Asin(result, a); break;
+				case Acos: inplace::Acos(result, a); break;
+				case Atan: inplace::Atan(result, a); break;
 			}
-		} // for loop around operations
+		}
+	} // namespace
+
+
+	template<>
+	void StraightLineProgram::SetBatchValue<dbl_complex>(BatchMemory & batch, size_t loc, size_t point, dbl_complex const& value){
+		batch.Real[loc*batch.NumPoints + point] = value.real();
+		batch.Imag[loc*batch.NumPoints + point] = value.imag();
+	}
+
+	template<>
+	void StraightLineProgram::SetBatchValue<mpfr_complex>(BatchMemory & batch, size_t loc, size_t point, mpfr_complex const& value){
+		batch.Multiple[loc*batch.NumPoints + point] = value;
+	}
+
+
+	template<>
+	dbl_complex StraightLineProgram::GetBatchValue<dbl_complex>(BatchMemory const& batch, size_t loc, size_t point){
+		return dbl_complex(batch.Real[loc*batch.NumPoints + point], batch.Imag[loc*batch.NumPoints + point]);
+	}
 
-		is_evaluated_ = true;
+	template<>
+	mpfr_complex StraightLineProgram::GetBatchValue<mpfr_complex>(BatchMemory const& batch, size_t loc, size_t point){
+		return batch.Multiple[loc*batch.NumPoints + point];
 	}
 
-	template void StraightLineProgram::Eval<dbl_complex>() const;
-	template void StraightLineProgram::Eval<mpfr_complex>() const;
+
+	template<>
+	void StraightLineProgram::PrepareBatch<dbl_complex>(Workspace & w, size_t num_points) const{
+		auto& batch = w.Batch;
+		const auto num_locations = w.GetMemory<dbl_complex>().size();
+
+		batch.NumPoints = num_points;
+		batch.Real.resize(num_locations*num_points);
+		batch.Imag.resize(num_locations*num_points);
+		batch.ScratchReal.resize(num_points);
+		batch.ScratchImag.resize(num_points);
+
+		for (auto const& x: true_values_of_numbers_)
+			for (size_t p{0}; p<num_points; ++p)
+				SetBatchValue(batch, x.second, p, w.GetMemory<dbl_complex>()[x.second]);
+	}
+
+	template<>
+	void StraightLineProgram::PrepareBatch<mpfr_complex>(Workspace & w, size_t num_points) const{
+		auto& batch = w.Batch;
+		const auto num_locations = w.GetMemory<mpfr_complex>().size();
+
+		batch.NumPoints = num_points;
+		if (batch.Multiple.size()!=num_locations*num_points || batch.Precision!=w.Precision){
+			batch.Multiple.resize(num_locations*num_points);
+			for (auto& v : batch.Multiple)
+				Precision(v, w.Precision);
+			batch.Precision = w.Precision;
+		}
+
+		for (auto const& x: true_values_of_numbers_)
+			for (size_t p{0}; p<num_points; ++p)
+				SetBatchValue(batch, x.second, p, w.GetMemory<mpfr_complex>()[x.second]);
+	}
+
+
+	template<>
+	void StraightLineProgram::EvalBatchRange<dbl_complex>(BatchMemory & batch, size_t begin, size_t end) const{
+		const size_t N = batch.NumPoints;
+		double* re = batch.Real.data();
+		double* im = batch.Imag.data();
+
+		auto const& kernels = slp_kernels::Kernels(); // picked once, for the best instruction set this CPU has
+
+		for (size_t ii = begin; ii<end; ++ii){
+			auto const& instr = decoded_instructions_[ii];
+			const auto op = instr.op;
+
+			// the compiler never gives a result the same location as an operand, so these don't alias
+			double* o_re = re + instr.out*N;
+			double* o_im = im + instr.out*N;
+			const double* a_re = re + instr.in1*N;
+			const double* a_im = im + instr.in1*N;
+			const double* b_re = re + instr.in2*N; // only meaningful if the second operand is in memory
+			const double* b_im = im + instr.in2*N;
+
+			switch (op){
+				case Add:
+					kernels.Add(o_re, o_im, a_re, a_im, b_re, b_im, N);
+					break;
+
+				case Subtract:
+					kernels.Subtract(o_re, o_im, a_re, a_im, b_re, b_im, N);
+					break;
+
+				case Multiply:
+					kernels.Multiply(o_re, o_im, a_re, a_im, b_re, b_im, N);
+					break;
+
+				case Divide:
+					kernels.Divide(o_re, o_im, a_re, a_im, b_re, b_im, N);
+					break;
+
+				case IntPower:
+					kernels.IntPower(o_re, o_im, a_re, a_im, batch.ScratchReal.data(), batch.ScratchImag.data(), integers_[instr.in2], N);
+					break;
+
+				case Assign:
+					kernels.Assign(o_re, o_im, a_re, a_im, N);
+					break;
+
+				case Negate:
+					kernels.Negate(o_re, o_im, a_re, a_im, N);
+					break;
+
+				default:
+				{
+					// Power, the fused operations and the transcendental functions have no vectorized form here, so go point by point
+					const size_t b = SecondOperandInMemory(op) ? instr.in2 : instr.in1;
+					const size_t c = IsTernary(op) ? instr.in3 : instr.in1;
+					const int integer = (op & IntegerOperandOperations) ? integers_[instr.in2] : 0;
+					for (size_t p = 0; p<N; ++p){
+						dbl_complex result;
+						ApplyOperation(op, result, dbl_complex(a_re[p], a_im[p]), dbl_complex(re[b*N+p], im[b*N+p]), dbl_complex(re[c*N+p], im[c*N+p]), integer);
+						o_re[p] = result.real();
+						o_im[p] = result.imag();
+					}
+					break;
+				}
+			}
+		}
+	}
+
+
+	template<>
+	void StraightLineProgram::EvalBatchRange<mpfr_complex>(BatchMemory & batch, size_t begin, size_t end) const{
+		const size_t N = batch.NumPoints;
+		auto& memory = batch.Multiple;
+
+		for (size_t ii = begin; ii<end; ++ii){
+			auto const& instr = decoded_instructions_[ii];
+			const auto op = instr.op;
+
+			const int integer = (op & IntegerOperandOperations) ? integers_[instr.in2] : 0;
+			const size_t b = SecondOperandInMemory(op) ? instr.in2 : instr.in1;
+			const size_t c = IsTernary(op) ? instr.in3 : instr.in1;
+
+			for (size_t p = 0; p<N; ++p)
+				ApplyOperation(op, memory[instr.out*N+p], memory[instr.in1*N+p], memory[b*N+p], memory[c*N+p], integer);
+		}
+	}
 
 
 	template<typename NumT>
-	void StraightLineProgram::CopyNumbersIntoMemory() const
-	{
-		for (auto const& x: true_values_of_numbers_){
-			GetMemory<NumT>()[x.second] = (x.first)->Eval<NumT>();
-			if (std::is_same<NumT,mpfr_complex>::value)
-				Precision(GetMemory<NumT>()[x.second], this->precision_);
+	void StraightLineProgram::EvalBatch(Workspace & w, Mat<NumT> const& variable_values) const{
+
+		if (variable_values.rows()!=number_of_.Variables)
+			throw std::runtime_error("batch of variable values has the wrong number of rows for this SLP");
+
+#ifndef BERTINI_DISABLE_PRECISION_CHECKS
+		if (!std::is_same<NumT,dbl_complex>::value && variable_values.size()>0 && Precision(variable_values(0,0))!=w.Precision){
+			std::stringstream err_msg;
+			err_msg << "variable_values and SLP must be of same precision.  respective precisions: " << Precision(variable_values(0,0)) << " " << w.Precision << std::endl;
+			throw std::runtime_error(err_msg.str());
+		}
+#endif
+
+		const size_t num_points = variable_values.cols();
+		PrepareBatch<NumT>(w, num_points);
+
+		for (size_t p{0}; p<num_points; ++p)
+			for (size_t ii{0}; ii<number_of_.Variables; ++ii)
+				SetBatchValue(w.Batch, ii + input_locations_.Variables, p, variable_values(ii,p));
+
+		EvalBatchRange<NumT>(w.Batch, 0, decoded_instructions_.size());
+	}
+
+	template void StraightLineProgram::EvalBatch<dbl_complex>(Workspace &, Mat<dbl_complex> const&) const;
+	template void StraightLineProgram::EvalBatch<mpfr_complex>(Workspace &, Mat<mpfr_complex> const&) const;
+
+
+	template<typename NumT>
+	void StraightLineProgram::EvalBatch(Workspace & w, Mat<NumT> const& variable_values, Vec<NumT> const& times) const{
+
+		if (!this->HavePathVariable())
+			throw std::runtime_error("calling EvalBatch with path variable, but this StraightLineProgram doesn't have one.");
+
+		if (times.size()!=variable_values.cols())
+			throw std::runtime_error("batch of variable values and batch of times have different numbers of points");
+
+		if (variable_values.rows()!=number_of_.Variables)
+			throw std::runtime_error("batch of variable values has the wrong number of rows for this SLP");
+
+#ifndef BERTINI_DISABLE_PRECISION_CHECKS
+		if (!std::is_same<NumT,dbl_complex>::value && variable_values.size()>0 && (Precision(variable_values(0,0))!=w.Precision || Precision(times(0))!=w.Precision)){
+			std::stringstream err_msg;
+			err_msg << "variable_values, time values and SLP must be of same precision.  respective precisions: " << Precision(variable_values(0,0)) << " " << Precision(times(0)) << " " << w.Precision << std::endl;
+			throw std::runtime_error(err_msg.str());
+		}
+#endif
+
+		const size_t num_points = variable_values.cols();
+		PrepareBatch<NumT>(w, num_points);
+
+		for (size_t p{0}; p<num_points; ++p){
+			for (size_t ii{0}; ii<number_of_.Variables; ++ii)
+				SetBatchValue(w.Batch, ii + input_locations_.Variables, p, variable_values(ii,p));
+			SetBatchValue(w.Batch, input_locations_.Time, p, times(p));
 		}
+
+		EvalBatchRange<NumT>(w.Batch, 0, decoded_instructions_.size());
+	}
+
+	template void StraightLineProgram::EvalBatch<dbl_complex>(Workspace &, Mat<dbl_complex> const&, Vec<dbl_complex> const&) const;
+	template void StraightLineProgram::EvalBatch<mpfr_complex>(Workspace &, Mat<mpfr_complex> const&, Vec<mpfr_complex> const&) const;
+
+
+	template<typename NumT>
+	void StraightLineProgram::GetFuncValsBatchInPlace(Workspace const& w, Mat<NumT> & result) const{
+		for (size_t p{0}; p<w.Batch.NumPoints; ++p)
+			for (size_t ii{0}; ii<number_of_.Functions; ++ii)
+				result(ii,p) = GetBatchValue<NumT>(w.Batch, ii + output_locations_.Functions, p);
+	}
+
+	template void StraightLineProgram::GetFuncValsBatchInPlace<dbl_complex>(Workspace const&, Mat<dbl_complex> &) const;
+	template void StraightLineProgram::GetFuncValsBatchInPlace<mpfr_complex>(Workspace const&, Mat<mpfr_complex> &) const;
+
+
+	template<typename NumT>
+	void StraightLineProgram::GetJacobianBatchInPlace(Workspace const& w, std::vector<Mat<NumT>> & result) const{
+		for (size_t p{0}; p<w.Batch.NumPoints; ++p)
+			for (size_t jj{0}; jj<number_of_.Variables; ++jj)
+				for (size_t ii{0}; ii<number_of_.Functions; ++ii)
+					result[p](ii,jj) = GetBatchValue<NumT>(w.Batch, ii + jj*number_of_.Functions + output_locations_.Jacobian, p);
 	}
 
-	template void StraightLineProgram::CopyNumbersIntoMemory<dbl_complex>() const;
-	template void StraightLineProgram::CopyNumbersIntoMemory<mpfr_complex>() const;
+	template void StraightLineProgram::GetJacobianBatchInPlace<dbl_complex>(Workspace const&, std::vector<Mat<dbl_complex>> &) const;
+	template void StraightLineProgram::GetJacobianBatchInPlace<mpfr_complex>(Workspace const&, std::vector<Mat<mpfr_complex>> &) const;
+
+
+	template<typename NumT>
+	void StraightLineProgram::GetTimeDerivBatchInPlace(Workspace const& w, Mat<NumT> & result) const{
+		for (size_t p{0}; p<w.Batch.NumPoints; ++p)
+			for (size_t ii{0}; ii<number_of_.Functions; ++ii)
+				result(ii,p) = GetBatchValue<NumT>(w.Batch, ii + output_locations_.TimeDeriv, p);
+	}
+
+	template void StraightLineProgram::GetTimeDerivBatchInPlace<dbl_complex>(Workspace const&, Mat<dbl_complex> &) const;
+	template void StraightLineProgram::GetTimeDerivBatchInPlace<mpfr_complex>(Workspace const&, Mat<mpfr_complex> &) const;
+
+
+
+
+	namespace {
+
+		constexpr double UnitRoundoff = std::numeric_limits<double>::epsilon()/2;
+
+		// how many unit roundoffs an operation's own rounding can cost, relative to the size of its result.  sums are correctly rounded in each part, and products are within sqrt(5) (Brent, Percival and Zimmermann).  division and the functions from the standard library aren't correctly rounded, so they get more room.
+		constexpr double AddRounding = 1;
+		constexpr double MultiplyRounding = 3;
+		constexpr double DivideRounding = 8;
+		constexpr double FunctionRounding = 16;
+
+		// an error, amplified by a factor.  no error stays none, even if the factor is infinite.
+		double Amplify(double factor, double error){
+			return error==0 ? 0 : factor*error;
+		}
+
+		// a bound on the error in the result of an operation, given the bounds on its operands.
+		double RunningErrorBound(Operation op, dbl_complex const& r, dbl_complex const& a, dbl_complex const& b, double ea, double eb, double ec, int integer){
+			using std::abs;
+			constexpr double infinity = std::numeric_limits<double>::infinity();
+			constexpr double u = UnitRoundoff;
+			const double abs_r = abs(r), abs_a = abs(a), abs_b = abs(b);
+
+			switch (op){
+				case Add:
+				case Subtract:
+					return ea + eb + AddRounding*u*abs_r;
+
+				case Multiply:
+					return abs_a*eb + abs_b*ea + ea*eb + MultiplyRounding*u*abs_r;
+
+				case Divide: // |a'/b' - a/b| = |(a'-a) - r(b'-b)|/|b'|
+					if (eb>=abs_b)
+						return infinity;
+					return (ea + abs_r*eb)/(abs_b - eb) + DivideRounding*u*abs_r;
+
+				case Square:
+					return 2*abs_a*ea + ea*ea + MultiplyRounding*u*abs_r;
+
+				case FMA:
+					return abs_a*eb + abs_b*ea + ea*eb + MultiplyRounding*u*abs(a*b) + ec + AddRounding*u*abs_r;
+
+				case ScaleByInt:
+					return std::abs(integer)*ea + AddRounding*u*abs_r;
+
+				case MulAddConst:
+					return std::abs(integer)*(ea + AddRounding*u*abs_a) + ec + AddRounding*u*abs_r;
+
+				case IntPower:{
+					// the power of something within ea of a is within the difference of the powers of |a|+ea and |a|, plus a rounding for each product
+					const unsigned n = std::abs(integer);
+					if (n==0)
+						return 0;
+					const double abs_power = std::pow(abs_a, n);
+					const double e_power = std::pow(abs_a + ea, n) - abs_power + n*MultiplyRounding*u*abs_power;
+					if (integer>0)
+						return e_power;
+					if (e_power>=abs_power)
+						return infinity;
+					return e_power/(abs_power*(abs_power - e_power)) + DivideRounding*u*abs_r;
+				}
+
+				case Power:{ // exp(b log(a))
+					if (ea==0 && eb==0 && abs_a==0)
+						return 0;
+					if (ea>=abs_a)
+						return infinity;
+					const double abs_log = abs(log(a));
+					const double e_log = ea/(abs_a - ea) + FunctionRounding*u*abs_log;
+					const double e_exponent = abs_b*e_log + (abs_log + e_log)*eb + MultiplyRounding*u*abs_b*abs_log;
+					return abs_r*std::expm1(e_exponent) + FunctionRounding*u*abs_r;
+				}
+
+				case Assign:
+				case Negate:
+					return ea;
+
+				case Sqrt: // |sqrt(a') - sqrt(a)| = |a'-a|/|sqrt(a') + sqrt(a)|, and the square roots are in the right half plane
+					return std::min(Amplify(1/abs_r, ea), std::sqrt(ea)) + FunctionRounding*u*abs_r;
+
+				case Exp: // |exp(a') - exp(a)| = |exp(a)| |exp(a'-a) - 1|
+					return abs_r*std::expm1(ea) + FunctionRounding*u*abs_r;
+
+				case Log:
+					if (ea>=abs_a)
+						return infinity;
+					return ea/(abs_a - ea) + FunctionRounding*u*abs_r;
+
+				case Sin: // the derivatives are bounded by cosh of the imaginary part, anywhere within ea of a
+				case Cos:
+					return Amplify(std::cosh(std::abs(a.imag()) + ea), ea) + FunctionRounding*u*abs_r;
+
+				// for the rest, only to first order
+				case Tan:
+					return Amplify(abs(1. + r*r), ea) + FunctionRounding*u*abs_r;
+
+				case Asin:
+				case Acos:
+					return Amplify(1/abs(sqrt(1. - a*a)), ea) + FunctionRounding*u*abs_r;
+
+				case Atan:
+					return Amplify(1/abs(1. + a*a), ea) + FunctionRounding*u*abs_r;
+			}
+			return infinity;
+		}
+
+		void TakeLarger(double & bound, double candidate){
+			bound = std::max(bound, candidate);
+		}
+	} // namespace
+
+
+	void StraightLineProgram::PrepareRunningError(Workspace & w, Vec<dbl_complex> const& variable_values) const{
+		if (variable_values.size()!=number_of_.Variables)
+			throw std::runtime_error("evaluating with error bounds, but the number of variable values doesn't match the number of variables in the SLP");
+
+		auto& memory = w.RunningError;
+		memory.Values = w.GetMemory<dbl_complex>(); // for the numbers.  everything else is written before it's read.
+		memory.Bounds.assign(memory.Values.size(), 0);
+
+		for (auto const& x : true_values_of_numbers_)
+			memory.Bounds[x.second] = UnitRoundoff*std::abs(memory.Values[x.second]);
+
+		for (size_t ii{0}; ii<number_of_.Variables; ++ii)
+			memory.Values[ii + input_locations_.Variables] = variable_values(ii);
+	}
+
+
+	StraightLineProgram::ErrorBounds StraightLineProgram::EvalRunningError(RunningErrorMemory & memory) const{
+		auto& values = memory.Values;
+		auto& bounds = memory.Bounds;
+
+		// all of it, constant and time-only blocks too, since their values carry errors as well
+		for (auto const& instr : decoded_instructions_){
+			const auto op = instr.op;
+
+			const int integer = (op & IntegerOperandOperations) ? integers_[instr.in2] : 0;
+			const size_t b = SecondOperandInMemory(op) ? instr.in2 : instr.in1;
+			const size_t c = IsTernary(op) ? instr.in3 : instr.in1;
+
+			dbl_complex result;
+			ApplyOperation(op, result, values[instr.in1], values[b], values[c], integer);
+
+			auto bound = RunningErrorBound(op, result, values[instr.in1], values[b], bounds[instr.in1], bounds[b], bounds[c], integer);
+			if (std::isnan(bound)) // from an infinite or undefined value somewhere.  nothing is known.
+				bound = std::numeric_limits<double>::infinity();
+
+			values[instr.out] = result;
+			bounds[instr.out] = bound;
+		}
+
+		ErrorBounds result;
+		for (size_t ii{0}; ii<number_of_.Functions; ++ii)
+			TakeLarger(result.Functions, bounds[ii + output_locations_.Functions]);
+		for (size_t ii{0}; ii<number_of_.Jacobian; ++ii)
+			TakeLarger(result.Jacobian, bounds[ii + output_locations_.Jacobian]);
+		if (HavePathVariable())
+			for (size_t ii{0}; ii<number_of_.TimeDeriv; ++ii)
+				TakeLarger(result.TimeDeriv, bounds[ii + output_locations_.TimeDeriv]);
+		return result;
+	}
+
+
+	StraightLineProgram::ErrorBounds StraightLineProgram::EvalErrorBounds(Workspace & w, Vec<dbl_complex> const& variable_values) const{
+		PrepareRunningError(w, variable_values);
+		return EvalRunningError(w.RunningError);
+	}
+
+	StraightLineProgram::ErrorBounds StraightLineProgram::EvalErrorBounds(Workspace & w, Vec<dbl_complex> const& variable_values, dbl_complex const& time) const{
+		if (!this->HavePathVariable())
+			throw std::runtime_error("calling EvalErrorBounds with path variable, but this StraightLineProgram doesn't have one.");
+
+		PrepareRunningError(w, variable_values);
+		w.RunningError.Values[input_locations_.Time] = time;
+		return EvalRunningError(w.RunningError);
+	}
 
 }
 
@@ -340,6 +1124,130 @@ namespace bertini{
 namespace bertini{
 	using SLP = StraightLineProgram;
 
+	namespace {
+
+		std::vector<Instruction> Decode(std::vector<size_t> const& instructions){
+			std::vector<Instruction> decoded;
+			for (size_t ii(0); ii<instructions.size(); ){
+				auto op = static_cast<Operation>(instructions[ii]);
+				if (IsUnary(op))
+					decoded.push_back({op, instructions[ii+1], 0, instructions[ii+2]});
+				else if (IsTernary(op))
+					decoded.push_back({op, instructions[ii+1], instructions[ii+2], instructions[ii+4], instructions[ii+3]});
+				else
+					decoded.push_back({op, instructions[ii+1], instructions[ii+2], instructions[ii+3]});
+				ii += InstructionLength(op);
+			}
+			return decoded;
+		}
+
+		void Encode(Instruction const& instr, std::vector<size_t> & instructions){
+			instructions.push_back(instr.op);
+			instructions.push_back(instr.in1);
+			if (!IsUnary(instr.op))
+				instructions.push_back(instr.in2);
+			if (IsTernary(instr.op))
+				instructions.push_back(instr.in3);
+			instructions.push_back(instr.out);
+		}
+
+
+		/**
+		 \brief Mark the instructions which the memory locations [first_output, first_output+num_outputs) depend on.
+
+		 Walks the program backwards, so that a location which is written more than once only depends on its last write.
+
+		 \return A vector of flags, one per instruction.
+		 */
+		std::vector<bool> DependencyClosure(std::vector<Instruction> const& program, size_t first_output, size_t num_outputs){
+			std::set<size_t> needed;
+			for (size_t ii{0}; ii<num_outputs; ++ii)
+				needed.insert(first_output+ii);
+
+			std::vector<bool> is_needed(program.size(), false);
+			for (size_t ii = program.size(); ii-- > 0; ){
+				auto const& instr = program[ii];
+				auto found = needed.find(instr.out);
+				if (found==needed.end())
+					continue;
+
+				is_needed[ii] = true;
+				needed.erase(found);
+				needed.insert(instr.in1);
+				if (SecondOperandInMemory(instr.op))
+					needed.insert(instr.in2);
+				if (IsTernary(instr.op))
+					needed.insert(instr.in3);
+			}
+			return is_needed;
+		}
+
+
+		/**
+		 \brief Which block each instruction is in.
+
+		 \param num_instructions How many instructions there are.
+		 \param block_ends The indices of the instructions at which each block ends, in increasing order.
+		 */
+		std::vector<size_t> BlockOfEachInstruction(size_t num_instructions, std::vector<size_t> const& block_ends){
+			std::vector<size_t> blocks;
+			size_t block{0};
+			for (size_t ii(0); ii<num_instructions; ++ii){
+				while (block<block_ends.size() && ii>=block_ends[block])
+					++block;
+				blocks.push_back(block);
+			}
+			return blocks;
+		}
+
+
+		/**
+		 \brief A key identifying a number by its type and exact value, so that equal numbers can share a location in memory.
+		 */
+		std::string NumberKey(std::shared_ptr<const node::Node> const& n){
+			std::stringstream key;
+			key.precision(0); // Boost.Multiprecision prints every digit needed to reconstruct a value when asked for 0 digits
+			key << typeid(*n).name() << ':' << *n;
+			return key.str();
+		}
+
+
+		/**
+		 \brief Make a node for the exact result of an instruction whose operands are all numbers.
+
+		 \param op The operation.  Must not be Assign.
+		 \param a The first operand.
+		 \param b The second operand, if the operation is binary and its second operand is in memory.
+		 \param exponent The exponent, if the operation is IntPower.
+		 */
+		std::shared_ptr<const node::Node> FoldConstants(Operation op, std::shared_ptr<const node::Node> const& a, std::shared_ptr<const node::Node> const& b, int exponent){
+			// the arithmetic for nodes is written for non-const nodes.  the result is only ever evaluated, so this is safe.
+			auto x = std::const_pointer_cast<node::Node>(a);
+			auto y = std::const_pointer_cast<node::Node>(b);
+
+			switch (op){
+				case Add: return x+y;
+				case Subtract: return x-y;
+				case Multiply: return x*y;
+				case Divide: return x/y;
+				case Power: return pow(x,y);
+				case IntPower: return pow(x,exponent);
+				case Negate: return -x;
+				case Sqrt: return sqrt(x);
+				case Log: return log(x);
+				case Exp: return exp(x);
+				case Sin: return sin(x);
+				case Cos: return cos(x);
+				case Tan: return tan(x);
+				case Asin: return asin(x);
+				case Acos: return acos(x);
+				case Atan: return atan(x);
+				default:
+					throw std::runtime_error("unable to fold constants for operation " + OpcodeToString(op));
+			}
+		}
+	} // namespace
+
 
 	void SLPCompiler::Visit(node::Variable const& n){
 
@@ -381,14 +1289,93 @@ namespace bertini{
 	}
 
 
-	void SLPCompiler::Visit(node::Jacobian const& n){
-		throw std::runtime_error("unimplemented visit to node of type Jacobian");
+	void SLPCompiler::Visit(node::Jacobian const& n){
+		// the derivative with respect to the current variable of differentiation is wherever the entry node's is.  no copy needed.
+		const std::shared_ptr<node::Node>& entry = n.EntryNode();
+
+		if (this->locations_encountered_nodes_.find(entry) == this->locations_encountered_nodes_.end())
+			entry->Accept(*this);
+
+		auto as_ptr = n.shared_from_this();
+		this->locations_encountered_nodes_[as_ptr] = this->locations_encountered_nodes_[entry];
+	}
+
+	void SLPCompiler::Visit(node::Differential const& n){
+		// 1 for the variable of differentiation, 0 for every other
+		auto as_ptr = n.shared_from_this();
+		const bool is_current = current_diff_variable_ && n.GetVariable()==current_diff_variable_;
+		this->locations_encountered_nodes_[as_ptr] = LocationOfInteger(is_current ? 1 : 0);
+	}
+
+	void SLPCompiler::Visit(node::LinearProduct const& n){
+		auto as_ptr = n.shared_from_this();
+
+		VariableGroup vars;
+		n.GetVariables(vars);
+		std::shared_ptr<node::Node> hom_var;
+		n.GetHomVariable(hom_var);
+
+		auto LocationOf = [this](std::shared_ptr<node::Node> const& m){
+			if (this->locations_encountered_nodes_.find(m) == this->locations_encountered_nodes_.end())
+				m->Accept(*this);
+			return this->locations_encountered_nodes_[m];
+		};
+
+		// each factor is c_0*x_0 + ... + c_{n-1}*x_{n-1} + c_n*h, where h is the homogenizing variable, or the integer 1 if there isn't one
+		size_t product_location = LocationOfInteger(1);
+		for (size_t ii{0}; ii<n.NumFactors(); ++ii){
+			size_t sum_location = 0;
+			for (size_t jj{0}; jj<=vars.size(); ++jj){
+				const std::shared_ptr<node::Node> term = jj<vars.size() ? vars[jj] : hom_var;
+
+				const auto coefficient_location = LocationOf(n.GetCoefficientNode(ii,jj));
+				const auto variable_location = LocationOf(term);
+				slp_under_construction_.AddInstruction(Multiply, coefficient_location, variable_location, next_available_complex_);
+				const auto term_location = next_available_complex_++;
+
+				if (jj==0)
+					sum_location = term_location;
+				else{
+					slp_under_construction_.AddInstruction(Add, sum_location, term_location, next_available_complex_);
+					sum_location = next_available_complex_++;
+				}
+			}
+
+			if (ii==0)
+				product_location = sum_location;
+			else{
+				slp_under_construction_.AddInstruction(Multiply, product_location, sum_location, next_available_complex_);
+				product_location = next_available_complex_++;
+			}
+		}
+
+		this->locations_encountered_nodes_[as_ptr] = product_location;
+	}
 
+	void SLPCompiler::Visit(node::DiffLinear const& n){
+		// the coefficient of the variable of differentiation, or 0 if it's not in the linear
+		auto as_ptr = n.shared_from_this();
 
-	}
+		VariableGroup vars;
+		n.GetVariables(vars);
+		std::shared_ptr<node::Node> hom_var;
+		n.GetHomVariable(hom_var);
+
+		std::shared_ptr<node::Node> coefficient;
+		if (current_diff_variable_){
+			auto found = std::find_if(vars.begin(), vars.end(), [this](auto const& v){ return v==current_diff_variable_;});
+			if (found != vars.end())
+				coefficient = n.GetCoefficientNode(found - vars.begin());
+			else if (hom_var==current_diff_variable_)
+				coefficient = n.GetCoefficientNode(vars.size());
+		}
 
-	void SLPCompiler::Visit(node::Differential const& n){
-		throw std::runtime_error("unimplemented visit to node of type Differential");
+		if (coefficient){
+			coefficient->Accept(*this);
+			this->locations_encountered_nodes_[as_ptr] = this->locations_encountered_nodes_[coefficient];
+		}
+		else
+			this->locations_encountered_nodes_[as_ptr] = LocationOfInteger(0);
 	}
 
 
@@ -428,6 +1415,18 @@ namespace bertini{
 	void SLPCompiler::Visit(node::SumOperator const & n){
 		const std::shared_ptr<const node::SumOperator> as_ptr = std::dynamic_pointer_cast<node::SumOperator const>(n.shared_from_this());
 
+		if (is_polynomial_ && polynomial_method_!=PolynomialMethod::Generic){
+			const auto& signs = n.GetSigns();
+			std::vector<Term> terms(n.Operands().size());
+			for (size_t ii{0}; ii<terms.size(); ++ii){
+				CollectFactors(n.Operands()[ii], terms[ii]);
+				terms[ii].is_subtracted = !signs[ii];
+			}
+
+			this->locations_encountered_nodes_[as_ptr] = polynomial_method_==PolynomialMethod::Horner ? Horner(terms) : SumOfTerms(terms);
+			return;
+		}
+
 		// this loop
 		// gets the locations of all the things we're going to add up.
 		std::vector<size_t> operand_locations;
@@ -441,34 +1440,11 @@ namespace bertini{
 
 		  
 		const auto& signs = n.GetSigns();
-		size_t prev_result_loc; // for tracking where the output of the previous iteration went
-
-		// seed the loop.
-		if (signs[0])
-			prev_result_loc = operand_locations[0];
-		else{
-			slp_under_construction_.AddInstruction(Negate, operand_locations[0], next_available_complex_);
-			prev_result_loc = next_available_complex_++;
-		}
-		
-
-		// this loop
-		// does the additions for the rest of the operands
-		for (size_t ii{1}; ii<n.Operands().size(); ++ii){
-			if (signs[ii])
-				slp_under_construction_.AddInstruction(Add,prev_result_loc,operand_locations[ii],next_available_complex_);
-			else
-				slp_under_construction_.AddInstruction(Subtract,prev_result_loc,operand_locations[ii],next_available_complex_);
-
-			prev_result_loc = next_available_complex_++;
-		}
+		std::vector<bool> is_subtracted;
+		for (auto s : signs)
+			is_subtracted.push_back(!s);
 
-		this->locations_encountered_nodes_[as_ptr] =  prev_result_loc;
-
-			// improved option?: we could do this in a way to minimize numerical error.  the obvious loop is not good for accumulation of error.  instead, use Pairwise summation
-			// do pairs (0,1), (2,3), etc,
-			// *then* add those temp vals together, until get to end.
-			// see https://en.wikipedia.org/wiki/Pairwise_summation
+		this->locations_encountered_nodes_[as_ptr] = Reduce(operand_locations, is_subtracted, Add, Subtract);
 	}
 
 
@@ -496,38 +1472,213 @@ namespace bertini{
 
 		  
 		const auto& mult_or_div = n.GetMultOrDiv();// true is multiply and false is divide
+		std::vector<bool> is_divisor;
+		for (auto m : mult_or_div)
+			is_divisor.push_back(!m);
+
+		this->locations_encountered_nodes_[as_ptr] = Reduce(operand_locations, is_divisor, Multiply, Divide);
+	}
+
+
+
+
+	size_t SLPCompiler::Reduce(std::vector<size_t> const& operands, std::vector<bool> const& is_inverted, Operation op, Operation inverse_op){
+		auto Binary = [this](Operation o, size_t a, size_t b){
+			slp_under_construction_.AddInstruction(o, a, b, next_available_complex_);
+			return next_available_complex_++;
+		};
+
+		// -a, or 1/a
+		auto Invert = [&](size_t a){
+			if (op==Add){
+				slp_under_construction_.AddInstruction(Negate, a, next_available_complex_);
+				return next_available_complex_++;
+			}
+			return Binary(Divide, LocationOfInteger(1), a);
+		};
 
-		size_t prev_result_loc; // for tracking where the output of the previous iteration went
+		switch (reduction_method_){
+			case ReductionMethod::Chain:
+			{
+				size_t result = is_inverted[0] ? Invert(operands[0]) : operands[0];
+				for (size_t ii{1}; ii<operands.size(); ++ii)
+					result = Binary(is_inverted[ii] ? inverse_op : op, result, operands[ii]);
+				return result;
+			}
 
-		// seed the loop.
-		if (mult_or_div[0])
-			prev_result_loc = operand_locations[0];
-		else{ 
-			// this case is reciprocation of the first operand
+			case ReductionMethod::Pairwise:
+			{
+				// combine neighbors, a level at a time.  two inverted operands make an inverted result, as -a-b is -(a+b), so there's at most one inversion, at the very end.
+				std::vector<std::pair<size_t,bool>> level;
+				for (size_t ii{0}; ii<operands.size(); ++ii)
+					level.emplace_back(operands[ii], is_inverted[ii]);
+
+				while (level.size()>1){
+					std::vector<std::pair<size_t,bool>> next_level;
+					for (size_t ii{0}; ii+1<level.size(); ii+=2){
+						auto const& [a, a_inverted] = level[ii];
+						auto const& [b, b_inverted] = level[ii+1];
+
+						if (a_inverted==b_inverted)
+							next_level.emplace_back(Binary(op, a, b), a_inverted);
+						else if (b_inverted)
+							next_level.emplace_back(Binary(inverse_op, a, b), false);
+						else
+							next_level.emplace_back(Binary(inverse_op, b, a), false);
+					}
+					if (level.size()%2)
+						next_level.push_back(level.back());
 
-			// this code sucks.  really, there should be a bank of integers that we pull from, instead of many copies of the same integer.
-			auto one = Integer::Make(1);
-			this->DealWithNumber(*one);
-			auto location_one  = locations_encountered_nodes_[one];
+					level = std::move(next_level);
+				}
 
-			slp_under_construction_.AddInstruction(Divide, location_one, operand_locations[0], next_available_complex_);
-			prev_result_loc = next_available_complex_++;
+				return level[0].second ? Invert(level[0].first) : level[0].first;
+			}
 		}
-		
 
-		// this loop
-		// does the additions for the rest of the operands
-		for (size_t ii{1}; ii<n.Operands().size(); ++ii){
-			if (mult_or_div[ii])
-				slp_under_construction_.AddInstruction(Multiply,prev_result_loc,operand_locations[ii],next_available_complex_);
-			else
-				slp_under_construction_.AddInstruction(Divide,prev_result_loc,operand_locations[ii],next_available_complex_);
+		throw std::runtime_error("unknown method of reduction");
+	}
+
+
+
+
+	void SLPCompiler::CollectFactors(Nd const& n, Term & term){
+		auto LocationOfVariable = [this](Nd const& v){
+			auto found = locations_encountered_nodes_.find(v);
+			return found==locations_encountered_nodes_.end() ? std::optional<size_t>() : found->second;
+		};
+
+		if (std::dynamic_pointer_cast<const node::Variable>(n)){
+			if (auto loc = LocationOfVariable(n)){
+				++term.powers[*loc];
+				return;
+			}
+		}
+		else if (auto as_power = std::dynamic_pointer_cast<const node::IntegerPowerOperator>(n)){
+			const auto& base = as_power->Operand();
+			if (as_power->exponent()>=0 && std::dynamic_pointer_cast<const node::Variable>(base)){
+				if (auto loc = LocationOfVariable(base)){
+					if (as_power->exponent()>0)
+						term.powers[*loc] += as_power->exponent();
+					return;
+				}
+			}
+		}
+		else if (auto as_product = std::dynamic_pointer_cast<const node::MultOperator>(n)){
+			const auto& mult_or_div = as_product->GetMultOrDiv();
+			if (std::all_of(mult_or_div.begin(), mult_or_div.end(), [](bool m){ return m;})){
+				for (auto const& operand : as_product->Operands())
+					CollectFactors(operand, term);
+				return;
+			}
+		}
+
+		term.coefficients.push_back(n);
+	}
+
+
+	size_t SLPCompiler::PowerOf(size_t base, IntT exponent){
+		if (exponent==0)
+			return LocationOfInteger(1);
+		if (exponent==1)
+			return base;
+
+		auto found = power_tables_[base].find(exponent);
+		if (found!=power_tables_[base].end())
+			return found->second;
+
+		auto half = PowerOf(base, exponent/2);
+		slp_under_construction_.AddInstruction(Multiply, half, half, next_available_complex_);
+		size_t result = next_available_complex_++;
+		if (exponent%2){
+			slp_under_construction_.AddInstruction(Multiply, result, base, next_available_complex_);
+			result = next_available_complex_++;
+		}
+
+		return power_tables_[base][exponent] = result;
+	}
+
+
+	size_t SLPCompiler::Monomial(std::map<size_t, IntT> powers){
+		if (powers.empty())
+			return LocationOfInteger(1);
+		if (powers.size()==1)
+			return PowerOf(powers.begin()->first, powers.begin()->second);
 
-			prev_result_loc = next_available_complex_++;
+		auto found = locations_monomials_.find(powers);
+		if (found!=locations_monomials_.end())
+			return found->second;
+
+		auto key = powers;
+		auto last = *powers.rbegin();
+		powers.erase(last.first);
+
+		auto rest = Monomial(powers);
+		auto power = PowerOf(last.first, last.second);
+		slp_under_construction_.AddInstruction(Multiply, rest, power, next_available_complex_);
+		return locations_monomials_[key] = next_available_complex_++;
+	}
+
+
+	size_t SLPCompiler::SumOfTerms(std::vector<Term> const& terms){
+		std::vector<size_t> values;
+		std::vector<bool> is_subtracted;
+		for (auto const& term : terms){
+			std::vector<size_t> factors;
+			for (auto const& c : term.coefficients){
+				if (locations_encountered_nodes_.find(c)==locations_encountered_nodes_.end())
+					c->Accept(*this);
+				factors.push_back(locations_encountered_nodes_[c]);
+			}
+			if (!term.powers.empty() || factors.empty())
+				factors.push_back(Monomial(term.powers));
+
+			values.push_back(Reduce(factors, std::vector<bool>(factors.size(), false), Multiply, Divide));
+			is_subtracted.push_back(term.is_subtracted);
+		}
+
+		return Reduce(values, is_subtracted, Add, Subtract);
+	}
+
+
+	size_t SLPCompiler::Horner(std::vector<Term> terms){
+		// the variable in the most terms.  ties go to the first variable, so the result doesn't depend on anything but the locations
+		std::map<size_t, size_t> num_terms_with;
+		for (auto const& term : terms)
+			for (auto const& p : term.powers)
+				++num_terms_with[p.first];
+
+		auto most = std::max_element(num_terms_with.begin(), num_terms_with.end(), [](auto const& a, auto const& b){ return a.second<b.second;});
+		if (most==num_terms_with.end() || most->second<2)
+			return SumOfTerms(terms);
+
+		const auto variable = most->first;
+		IntT lowest_power = std::numeric_limits<IntT>::max();
+		for (auto const& term : terms){
+			auto found = term.powers.find(variable);
+			if (found!=term.powers.end())
+				lowest_power = std::min(lowest_power, found->second);
+		}
+
+		std::vector<Term> with, without;
+		for (auto& term : terms){
+			auto found = term.powers.find(variable);
+			if (found==term.powers.end()){
+				without.push_back(std::move(term));
+				continue;
+			}
+
+			found->second -= lowest_power;
+			if (found->second==0)
+				term.powers.erase(found);
+			with.push_back(std::move(term));
 		}
 
-		this->locations_encountered_nodes_[as_ptr] =  prev_result_loc;
+		auto factored = Reduce({PowerOf(variable, lowest_power), Horner(std::move(with))}, {false, false}, Multiply, Divide);
+		if (without.empty())
+			return factored;
 
+		return Reduce({factored, Horner(std::move(without))}, {false, false}, Add, Subtract);
 	}
 
 
@@ -548,16 +1699,12 @@ namespace bertini{
 
 		auto location_operand = locations_encountered_nodes_[operand];
 
-
-
-		if (this->locations_integers_.find(expo) == this->locations_integers_.end())
-		{
-			locations_integers_[expo] = slp_under_construction_.integers_.size();
-			slp_under_construction_.integers_.push_back(expo);
+		if (is_polynomial_ && polynomial_method_!=PolynomialMethod::Generic && expo>=0){
+			this->locations_encountered_nodes_[as_ptr] = PowerOf(location_operand, expo);
+			return;
 		}
 
-
-		auto location_exponent  = locations_integers_[expo]; // this is a map lookup
+		auto location_exponent  = IndexOfExponent(expo);
 
 		
 		this->locations_encountered_nodes_[as_ptr] = next_available_complex_;
@@ -739,7 +1886,8 @@ namespace bertini{
 	SLP SLPCompiler::Compile(System const& sys){
 		this->Clear();
 
-		this->slp_under_construction_.precision_ = DefaultPrecision();
+		this->slp_under_construction_.workspace_.Precision = DefaultPrecision();
+		this->is_polynomial_ = polynomial_method_!=PolynomialMethod::Generic && sys.IsPolynomial();
 
 		// deal with variables
 		
@@ -792,33 +1940,53 @@ namespace bertini{
 
 
 		
+		// the derivatives are either compiled from the system's symbolic derivatives, or from its Jacobian nodes, or made here from the functions' instructions
+		auto jacobian_method = jacobian_method_;
+		if (jacobian_method==JacobianMethod::Automatic)
+			jacobian_method = ChooseAutomaticDifferentiationMode(sys.NumNaturalFunctions(), variable_ordering.size() + (sys.HavePathVariable() ? 1 : 0));
+		const bool use_jacobian_nodes = jacobian_method==JacobianMethod::Symbolic && sys.GetDerivMethod()==DerivMethod::JacobianNode;
+		const bool symbolic = jacobian_method==JacobianMethod::Symbolic && !use_jacobian_nodes;
+
+
 		// always have space derivatives
 
-		auto ds_dx = sys.GetSpaceDerivatives(); // a linear object, so can just run down the object
-		slp_under_construction_.number_of_.Jacobian = ds_dx.size();
+		decltype(sys.GetSpaceDerivatives()) ds_dx;
+		if (symbolic)
+			ds_dx = sys.GetSpaceDerivatives(); // a linear object, so can just run down the object
+		slp_under_construction_.number_of_.Jacobian = sys.NumNaturalFunctions() * variable_ordering.size();
 		slp_under_construction_.output_locations_.Jacobian = next_available_complex_;
-		for (auto n: ds_dx)
-		{
-			locations_top_level_functions_and_derivatives_[n] = next_available_complex_; // don't increment yet, we're listing it a few places. this is for an optimization that elides a copy for assignment.
-			locations_encountered_nodes_[n] = next_available_complex_++;
-		}
+		if (symbolic)
+			for (auto n: ds_dx)
+			{
+				locations_top_level_functions_and_derivatives_[n] = next_available_complex_; // don't increment yet, we're listing it a few places. this is for an optimization that elides a copy for assignment.
+				locations_encountered_nodes_[n] = next_available_complex_++;
+			}
+		else
+			next_available_complex_ += slp_under_construction_.number_of_.Jacobian;
 
 
 
 
 		// sometimes have time derivatives
+		decltype(sys.GetTimeDerivatives()) ds_dt;
 		if (sys.HavePathVariable()) {
 			
-			auto ds_dt = sys.GetTimeDerivatives();  // a linear object, so can just run down the object
-			slp_under_construction_.number_of_.TimeDeriv = ds_dt.size();
+			if (symbolic)
+				ds_dt = sys.GetTimeDerivatives();  // a linear object, so can just run down the object
+			slp_under_construction_.number_of_.TimeDeriv = sys.NumNaturalFunctions();
 			slp_under_construction_.output_locations_.TimeDeriv = next_available_complex_; // note the start of the block in memory.  the size was also recorded in the previous line.
-			for (auto n: ds_dt)
-			{
-				locations_top_level_functions_and_derivatives_[n] = next_available_complex_; // don't increment yet, we're listing it a few places. this is for an optimization that elides a copy for assignment.
-				locations_encountered_nodes_[n] = next_available_complex_++;
-			}
+			if (symbolic)
+				for (auto n: ds_dt)
+				{
+					locations_top_level_functions_and_derivatives_[n] = next_available_complex_; // don't increment yet, we're listing it a few places. this is for an optimization that elides a copy for assignment.
+					locations_encountered_nodes_[n] = next_available_complex_++;
+				}
+			else
+				next_available_complex_ += slp_under_construction_.number_of_.TimeDeriv;
 		}
 
+		first_temporary_location_ = next_available_complex_; // everything before here is an input or output, and must stay where it is.
+
 
 
 
@@ -836,42 +2004,752 @@ namespace bertini{
 
 
 
-		
-		// always do derivatives with respect to space variables
-		for (auto n: ds_dx)
-			n->Accept(*this);
-
-
-
+		const auto num_functions = sys.NumNaturalFunctions();
+		if (symbolic)
+		{
+			// always do derivatives with respect to space variables.  they're in column-major order, so one variable at a time.
+			for (size_t jj{0}; jj<variable_ordering.size(); ++jj)
+				WithRespectTo(variable_ordering[jj], [&](){
+					for (size_t ii{0}; ii<num_functions; ++ii)
+						ds_dx[ii + jj*num_functions]->Accept(*this);
+				});
+
+			// sometimes have time derivatives.  there are none in ds_dt if the system doesn't have a path variable
+			if (!ds_dt.empty())
+				WithRespectTo(sys.GetPathVariable(), [&](){
+					for (auto n: ds_dt)
+						n->Accept(*this);
+				});
+		}
+		else if (use_jacobian_nodes)
+		{
+			// each Jacobian node is every derivative of its function, depending on the variable of differentiation
+			const auto jacobians = sys.GetJacobianNodes();
+			auto CompileJacobians = [&](size_t first_output){
+				for (size_t ii{0}; ii<num_functions; ++ii){
+					jacobians[ii]->Accept(*this);
+					slp_under_construction_.AddInstruction(Assign, locations_encountered_nodes_[jacobians[ii]], first_output + ii);
+				}
+			};
+
+			for (size_t jj{0}; jj<variable_ordering.size(); ++jj)
+				WithRespectTo(variable_ordering[jj], [&](){ CompileJacobians(slp_under_construction_.output_locations_.Jacobian + jj*num_functions);});
+
+			if (sys.HavePathVariable())
+				WithRespectTo(sys.GetPathVariable(), [&](){ CompileJacobians(slp_under_construction_.output_locations_.TimeDeriv);});
+		}
+		else
+		{
+			std::vector<size_t> inputs;
+			for (auto const& v : variable_ordering)
+				inputs.push_back(locations_encountered_nodes_[v]);
+			if (sys.HavePathVariable())
+				inputs.push_back(slp_under_construction_.input_locations_.Time);
 
-		// sometimes have time derivatives
-		if (sys.HavePathVariable()) {
-			
-			// we need derivatives with respect to time only if the system has a path variable defined
-			auto ds_dt = sys.GetTimeDerivatives();  // a linear object, so can just run down the object
-			for (auto n: ds_dt)
-				n->Accept(*this);
+			DifferentiateAutomatically(jacobian_method, inputs);
 		}
 
 
+		Optimize();
+		if (fuse_instructions_)
+			FuseInstructions();
+		PartitionIntoBlocks();
+		ReuseMemory();
+		slp_under_construction_.DecodeInstructions();
+		slp_under_construction_.CompileJIT();
+
 		// adjust the sizes of the memory blocks to match the number expected via compilation
+		slp_under_construction_.memory_size_ = next_available_complex_;
 		slp_under_construction_.GetMemory<dbl_complex>().resize(next_available_complex_);
 		slp_under_construction_.GetMemory<mpfr_complex>().resize(next_available_complex_);
 
 
 		// downsample to get ready for evaluation
-		slp_under_construction_.CopyNumbersIntoMemory<dbl_complex>();
-		slp_under_construction_.CopyNumbersIntoMemory<mpfr_complex>();
+		slp_under_construction_.CopyNumbersIntoMemory<dbl_complex>(slp_under_construction_.workspace_);
+		slp_under_construction_.CopyNumbersIntoMemory<mpfr_complex>(slp_under_construction_.workspace_);
 
 
 		return slp_under_construction_;
 	}
 
+	namespace {
+
+		/**
+		 \brief A derivative, while differentiating automatically.  Most are in memory, but 0 and 1 and -1 are common enough, and simple enough, to track without any instructions.
+		 */
+		struct Derivative{
+			enum Kind {Zero, One, MinusOne, InMemory};
+
+			Kind kind;
+			size_t location;
+
+			static Derivative At(size_t loc){ return {InMemory, loc};}
+
+			bool IsZero() const{ return kind==Zero;}
+		};
+
+	} // namespace
+
+
+	JacobianMethod SLPCompiler::ChooseAutomaticDifferentiationMode(size_t num_functions, size_t num_inputs){
+		return num_inputs <= num_functions ? JacobianMethod::Forward : JacobianMethod::Reverse;
+	}
+
+
+	size_t SLPCompiler::LocationOfInteger(IntT value){
+		auto found = locations_integer_numbers_.find(value);
+		if (found!=locations_integer_numbers_.end())
+			return found->second;
+
+		auto n = Integer::Make(value);
+		this->DealWithNumber(*n);
+		return locations_integer_numbers_[value] = locations_encountered_nodes_[n];
+	}
+
+
+	size_t SLPCompiler::IndexOfExponent(IntT exponent){
+		if (this->locations_integers_.find(exponent) == this->locations_integers_.end())
+		{
+			locations_integers_[exponent] = slp_under_construction_.integers_.size();
+			slp_under_construction_.integers_.push_back(exponent);
+		}
+
+		return locations_integers_[exponent];
+	}
+
+
+	void SLPCompiler::DifferentiateAutomatically(JacobianMethod mode, std::vector<size_t> const& inputs){
+		auto& slp = slp_under_construction_;
+		const auto tape = Decode(slp.instructions_); // just the functions, so far
+		const size_t num_functions = slp.number_of_.Functions;
+		const size_t num_variables = slp.number_of_.Variables;
+
+		const Derivative zero{Derivative::Zero, 0}, one{Derivative::One, 0}, minus_one{Derivative::MinusOne, 0};
+
+
+		// making instructions, each into a new location
+		auto Unary = [this](Operation op, size_t a){
+			slp_under_construction_.AddInstruction(op, a, next_available_complex_);
+			return next_available_complex_++;
+		};
+		auto Binary = [this](Operation op, size_t a, size_t b){
+			slp_under_construction_.AddInstruction(op, a, b, next_available_complex_);
+			return next_available_complex_++;
+		};
+
+		auto InMemory = [this](Derivative d){
+			switch (d.kind){
+				case Derivative::Zero: return LocationOfInteger(0);
+				case Derivative::One: return LocationOfInteger(1);
+				case Derivative::MinusOne: return LocationOfInteger(-1);
+				default: return d.location;
+			}
+		};
+
+
+		// arithmetic on derivatives, making instructions only when needed
+		auto Negative = [&](Derivative d) -> Derivative{
+			switch (d.kind){
+				case Derivative::Zero: return zero;
+				case Derivative::One: return minus_one;
+				case Derivative::MinusOne: return one;
+				default: return Derivative::At(Unary(Negate, d.location));
+			}
+		};
+
+		auto Product = [&](Derivative a, Derivative b) -> Derivative{
+			if (a.IsZero() || b.IsZero())
+				return zero;
+			if (a.kind==Derivative::One)
+				return b;
+			if (b.kind==Derivative::One)
+				return a;
+			if (a.kind==Derivative::MinusOne)
+				return Negative(b);
+			if (b.kind==Derivative::MinusOne)
+				return Negative(a);
+			return Derivative::At(Binary(Multiply, a.location, b.location));
+		};
+
+		auto Sum = [&](Derivative a, Derivative b) -> Derivative{
+			if (a.IsZero())
+				return b;
+			if (b.IsZero())
+				return a;
+			if (b.kind==Derivative::MinusOne)
+				return Derivative::At(Binary(Subtract, InMemory(a), LocationOfInteger(1)));
+			if (a.kind==Derivative::MinusOne)
+				return Derivative::At(Binary(Subtract, InMemory(b), LocationOfInteger(1)));
+			return Derivative::At(Binary(Add, InMemory(a), InMemory(b)));
+		};
+
+		// acc + p*d.  a factor of -1 makes a subtraction instead of a negation and an addition.
+		auto MultiplyAdd = [&](Derivative acc, Derivative p, Derivative d) -> Derivative{
+			if (p.IsZero() || d.IsZero())
+				return acc;
+			if (acc.IsZero())
+				return Product(p, d);
+			if (p.kind==Derivative::MinusOne && d.kind!=Derivative::MinusOne)
+				return Derivative::At(Binary(Subtract, InMemory(acc), InMemory(d)));
+			if (d.kind==Derivative::MinusOne && p.kind!=Derivative::MinusOne)
+				return Derivative::At(Binary(Subtract, InMemory(acc), InMemory(p)));
+			return Sum(acc, Product(p, d));
+		};
+
+
+		// the partial derivative of an instruction's result with respect to one of its operands.  made the first time it's needed, then shared by every sweep.
+		auto LocalPartial = [&](Instruction const& instr, unsigned operand) -> Derivative{
+			const auto a = instr.in1, b = instr.in2, z = instr.out;
+
+			switch (instr.op){
+				case Add: return one;
+				case Subtract: return operand==0 ? one : minus_one;
+				case Multiply: return Derivative::At(operand==0 ? b : a);
+				case Divide: // z = a/b
+					if (operand==0)
+						return Derivative::At(Binary(Divide, LocationOfInteger(1), b));
+					return Negative(Derivative::At(Binary(Divide, z, b)));
+				case Power: // z = a^b
+					if (operand==0)
+						return Derivative::At(Binary(Multiply, b, Binary(Power, a, Binary(Subtract, b, LocationOfInteger(1)))));
+					return Derivative::At(Binary(Multiply, z, Unary(Log, a)));
+				case IntPower:{
+					const auto n = slp.integers_[b];
+					if (n==0)
+						return zero;
+					if (n==1)
+						return one;
+					if (n==2)
+						return Derivative::At(Binary(Multiply, LocationOfInteger(2), a));
+					return Derivative::At(Binary(Multiply, LocationOfInteger(n), Binary(IntPower, a, IndexOfExponent(n-1))));
+				}
+				case Exp: return Derivative::At(z);
+				case Log: return Derivative::At(Binary(Divide, LocationOfInteger(1), a));
+				case Negate: return minus_one;
+				case Sqrt: return Derivative::At(Binary(Divide, LocationOfInteger(1), Binary(Multiply, LocationOfInteger(2), z)));
+				case Sin: return Derivative::At(Unary(Cos, a));
+				case Cos: return Negative(Derivative::At(Unary(Sin, a)));
+				case Tan: return Derivative::At(Binary(Add, LocationOfInteger(1), Binary(Multiply, z, z)));
+				case Asin: return Derivative::At(Binary(Divide, LocationOfInteger(1), Unary(Sqrt, Binary(Subtract, LocationOfInteger(1), Binary(Multiply, a, a)))));
+				case Acos: return Negative(Derivative::At(Binary(Divide, LocationOfInteger(1), Unary(Sqrt, Binary(Subtract, LocationOfInteger(1), Binary(Multiply, a, a))))));
+				case Atan: return Derivative::At(Binary(Divide, LocationOfInteger(1), Binary(Add, LocationOfInteger(1), Binary(Multiply, a, a))));
+				case Assign: return one;
+				// differentiating comes before FuseInstructions, so the fused operations never get here
+				case FMA:
+				case Square:
+				case ScaleByInt:
+				case MulAddConst:
+					break;
+			}
+			throw std::runtime_error("unable to differentiate operation " + OpcodeToString(instr.op));
+		};
+
+		std::vector<std::array<std::optional<Derivative>,2>> partials(tape.size());
+		auto Partial = [&](size_t ii, unsigned operand){
+			auto& memo = partials[ii][operand];
+			if (!memo)
+				memo = LocalPartial(tape[ii], operand);
+			return *memo;
+		};
+
+
+		auto Lookup = [&zero](std::map<size_t, Derivative> const& derivatives, size_t loc){
+			auto found = derivatives.find(loc);
+			return found==derivatives.end() ? zero : found->second;
+		};
+
+		// where the derivative of function `f` with respect to input `jj` goes
+		auto OutputLocation = [&](size_t f, size_t jj){
+			return jj<num_variables ? slp.output_locations_.Jacobian + f + jj*num_functions : slp.output_locations_.TimeDeriv + f;
+		};
+
+		auto Store = [&](Derivative d, size_t loc){
+			slp_under_construction_.AddInstruction(Assign, InMemory(d), loc);
+		};
+
+
+		switch (mode){
+			case JacobianMethod::Forward:
+			{
+				// one sweep forward per input, carrying the derivative of everything with respect to it
+				for (size_t jj=0; jj<inputs.size(); ++jj){
+					std::map<size_t, Derivative> tangent{ {inputs[jj], one} };
+
+					for (size_t ii=0; ii<tape.size(); ++ii){
+						auto const& instr = tape[ii];
+						auto da = Lookup(tangent, instr.in1);
+						auto db = SecondOperandInMemory(instr.op) ? Lookup(tangent, instr.in2) : zero;
+						if (da.IsZero() && db.IsZero())
+							continue;
+
+						auto dz = zero;
+						if (!da.IsZero())
+							dz = MultiplyAdd(dz, Partial(ii,0), da);
+						if (!db.IsZero())
+							dz = MultiplyAdd(dz, Partial(ii,1), db);
+						tangent[instr.out] = dz;
+					}
+
+					for (size_t f=0; f<num_functions; ++f)
+						Store(Lookup(tangent, slp.output_locations_.Functions + f), OutputLocation(f, jj));
+				}
+				break;
+			}
+
+			case JacobianMethod::Reverse:
+			{
+				// which locations depend on the inputs.  nothing else needs an adjoint.
+				std::vector<bool> active(next_available_complex_, false);
+				for (auto loc : inputs)
+					active[loc] = true;
+				for (auto const& instr : tape)
+					if (active[instr.in1] || (SecondOperandInMemory(instr.op) && active[instr.in2]))
+						active[instr.out] = true;
+
+				// one sweep backward per function, carrying the derivative of it with respect to everything.  each location is written once, so its adjoint is complete by the time the sweep reaches the instruction writing it.
+				for (size_t f=0; f<num_functions; ++f){
+					std::map<size_t, Derivative> adjoint{ {slp.output_locations_.Functions + f, one} };
+
+					for (size_t ii=tape.size(); ii-- > 0; ){
+						auto const& instr = tape[ii];
+						auto z_bar = Lookup(adjoint, instr.out);
+						if (z_bar.IsZero())
+							continue;
+
+						if (active[instr.in1])
+							adjoint[instr.in1] = MultiplyAdd(Lookup(adjoint, instr.in1), Partial(ii,0), z_bar);
+						if (SecondOperandInMemory(instr.op) && active[instr.in2])
+							adjoint[instr.in2] = MultiplyAdd(Lookup(adjoint, instr.in2), Partial(ii,1), z_bar);
+					}
+
+					for (size_t jj=0; jj<inputs.size(); ++jj)
+						Store(Lookup(adjoint, inputs[jj]), OutputLocation(f, jj));
+				}
+				break;
+			}
+
+			default:
+				throw std::runtime_error("automatic differentiation must be either forward or reverse mode");
+		}
+	}
+
+
+
+	void SLPCompiler::Optimize(){
+		auto& slp = slp_under_construction_;
+		auto program = Decode(slp.instructions_);
+
+		auto& stats = slp.optimization_statistics_;
+		stats.InstructionsBefore = program.size();
+		stats.MemoryBefore = next_available_complex_;
+
+		// where the value computed for a location actually lives, after merging.  locations not in here are their own.
+		std::map<size_t, size_t> merged_into;
+		auto Resolve = [&merged_into](size_t loc){
+			auto found = merged_into.find(loc);
+			return found==merged_into.end() ? loc : found->second;
+		};
+
+
+		// 1. numbers with the same value get the same location
+		std::map<size_t, Nd> numbers; // location --> true value
+		std::map<std::string, size_t> locations_of_numbers; // value --> location
+		for (auto const& x : slp.true_values_of_numbers_){
+			auto key = NumberKey(x.first);
+			auto found = locations_of_numbers.find(key);
+			if (found==locations_of_numbers.end()){
+				locations_of_numbers[key] = x.second;
+				numbers[x.second] = x.first;
+			}
+			else
+				merged_into[x.second] = found->second;
+		}
+
+
+		// 2, 3, and the first half of 4, in one forward pass.  the program is in SSA form, so every temporary is written exactly once, before it is read.
+		std::map<std::tuple<size_t,size_t,size_t>, size_t> computed; // (op, operand, operand) --> location of result
+		std::vector<Instruction> optimized;
+		for (auto instr : program){
+			instr.in1 = Resolve(instr.in1);
+			if (SecondOperandInMemory(instr.op))
+				instr.in2 = Resolve(instr.in2);
+
+			const bool is_output = instr.out < first_temporary_location_;
+
+			if (instr.op==Assign){
+				if (is_output)
+					optimized.push_back(instr);
+				else
+					merged_into[instr.out] = instr.in1;
+				continue;
+			}
+
+			if (!is_output && numbers.count(instr.in1) && (!SecondOperandInMemory(instr.op) || numbers.count(instr.in2))){
+				auto folded = FoldConstants(instr.op, numbers[instr.in1], SecondOperandInMemory(instr.op) ? numbers[instr.in2] : nullptr, instr.op==IntPower ? slp.integers_[instr.in2] : 0);
+
+				auto key = NumberKey(folded);
+				auto found = locations_of_numbers.find(key);
+				if (found==locations_of_numbers.end()){
+					locations_of_numbers[key] = instr.out;
+					numbers[instr.out] = folded;
+				}
+				else
+					merged_into[instr.out] = found->second;
+				continue;
+			}
+
+			auto first = instr.in1, second = instr.in2;
+			if ((instr.op==Add || instr.op==Multiply) && second<first)
+				std::swap(first, second);
+
+			auto key = std::make_tuple(static_cast<size_t>(instr.op), first, second);
+			auto found = computed.find(key);
+			if (found==computed.end()){
+				computed[key] = instr.out;
+				optimized.push_back(instr);
+			}
+			else if (is_output)
+				optimized.push_back({Assign, found->second, 0, instr.out});
+			else
+				merged_into[instr.out] = found->second;
+		}
+
+
+		// the second half of 4.  a temporary copied into an output is computed straight into the output instead.
+		std::set<size_t> computed_by_instruction;
+		for (auto const& instr : optimized)
+			computed_by_instruction.insert(instr.out);
+
+		std::map<size_t, size_t> moved_to_output;
+		std::vector<Instruction> without_copies;
+		for (auto const& instr : optimized){
+			if (instr.op==Assign && instr.in1>=first_temporary_location_ && computed_by_instruction.count(instr.in1) && !moved_to_output.count(instr.in1))
+				moved_to_output[instr.in1] = instr.out;
+			else
+				without_copies.push_back(instr);
+		}
+
+		auto Move = [&moved_to_output](size_t& loc){
+			auto found = moved_to_output.find(loc);
+			if (found!=moved_to_output.end())
+				loc = found->second;
+		};
+		for (auto& instr : without_copies){
+			Move(instr.in1);
+			if (SecondOperandInMemory(instr.op))
+				Move(instr.in2);
+			Move(instr.out);
+		}
+
+
+		// 5. only keep what the outputs depend on
+		auto is_needed = DependencyClosure(without_copies, slp.input_locations_.Variables, first_temporary_location_);
+
+		std::vector<Instruction> live;
+		std::set<size_t> used_locations;
+		for (size_t ii{0}; ii<without_copies.size(); ++ii){
+			if (!is_needed[ii])
+				continue;
+
+			auto const& instr = without_copies[ii];
+			live.push_back(instr);
+			used_locations.insert(instr.in1);
+			if (SecondOperandInMemory(instr.op))
+				used_locations.insert(instr.in2);
+			used_locations.insert(instr.out);
+		}
+
+
+		// 6. close up the holes left in memory
+		std::map<size_t, size_t> new_location;
+		size_t next_location = first_temporary_location_;
+		for (auto loc : used_locations)
+			new_location[loc] = loc<first_temporary_location_ ? loc : next_location++;
+
+		slp.true_values_of_numbers_.clear();
+		for (auto const& x : numbers)
+			if (used_locations.count(x.first))
+				slp.AddNumber(x.second, new_location[x.first]);
+
+		slp.instructions_.clear();
+		for (auto instr : live){
+			instr.in1 = new_location[instr.in1];
+			if (SecondOperandInMemory(instr.op))
+				instr.in2 = new_location[instr.in2];
+			instr.out = new_location[instr.out];
+			Encode(instr, slp.instructions_);
+		}
+
+		next_available_complex_ = next_location;
+
+		stats.InstructionsAfter = live.size();
+		stats.MemoryAfter = next_available_complex_;
+	}
+
+	void SLPCompiler::FuseInstructions(){
+		auto& slp = slp_under_construction_;
+		auto program = Decode(slp.instructions_);
+
+		// the numbers which are small integers.  multiplying by one of them is exact in any precision, so it can be done by the integer, without the number.
+		std::map<size_t, IntT> small_integers; // location --> value
+		for (auto const& x : slp.true_values_of_numbers_){
+			if (typeid(*x.first)!=typeid(node::Integer))
+				continue;
+
+			std::stringstream printed;
+			printed << *x.first;
+			long long value;
+			if (printed >> value && printed.peek()==std::char_traits<char>::eof() && std::abs(value) <= (1ll << 24))
+				small_integers[x.second] = static_cast<IntT>(value);
+		}
+
+
+		// 1. squares, and products with a small integer
+		for (auto& instr : program){
+			if ((instr.op==Multiply && instr.in1==instr.in2) || (instr.op==IntPower && slp.integers_[instr.in2]==2))
+				instr = {Square, instr.in1, 0, instr.out};
+			else if (instr.op==Multiply && (small_integers.count(instr.in1) || small_integers.count(instr.in2))){
+				const bool second_is_integer = small_integers.count(instr.in2);
+				const auto scaled = second_is_integer ? instr.in1 : instr.in2;
+				const auto factor = small_integers[second_is_integer ? instr.in2 : instr.in1];
+				instr = {ScaleByInt, scaled, IndexOfExponent(factor), instr.out};
+			}
+		}
+
+
+		// 2. a product read only by a sum is computed as part of the sum.  the program is still in SSA form, so the product's operands still hold the same values when the sum is computed.
+		std::map<size_t, size_t> times_read, defined_by; // location --> count, location --> index of instruction
+		for (size_t ii{0}; ii<program.size(); ++ii){
+			auto const& instr = program[ii];
+			++times_read[instr.in1];
+			if (SecondOperandInMemory(instr.op))
+				++times_read[instr.in2];
+			if (IsTernary(instr.op))
+				++times_read[instr.in3];
+			defined_by[instr.out] = ii;
+		}
+
+		auto IsFusableProduct = [&](size_t loc){
+			if (loc<first_temporary_location_ || times_read[loc]!=1 || !defined_by.count(loc))
+				return false;
+			const auto op = program[defined_by[loc]].op;
+			return op==Multiply || op==Square || op==ScaleByInt;
+		};
+
+		std::vector<bool> fused_away(program.size(), false);
+		for (auto& instr : program){
+			if (instr.op!=Add)
+				continue;
+
+			size_t product, addend;
+			if (IsFusableProduct(instr.in1)){
+				product = instr.in1;
+				addend = instr.in2;
+			}
+			else if (IsFusableProduct(instr.in2)){
+				product = instr.in2;
+				addend = instr.in1;
+			}
+			else
+				continue;
+
+			auto const& p = program[defined_by[product]];
+			if (p.op==ScaleByInt)
+				instr = {MulAddConst, p.in1, p.in2, instr.out, addend};
+			else
+				instr = {FMA, p.in1, p.op==Square ? p.in1 : p.in2, instr.out, addend};
+			fused_away[defined_by[product]] = true;
+		}
+
+
+		slp.instructions_.clear();
+		size_t num_instructions{0};
+		for (size_t ii{0}; ii<program.size(); ++ii)
+			if (!fused_away[ii]){
+				Encode(program[ii], slp.instructions_);
+				++num_instructions;
+			}
+
+		slp.optimization_statistics_.InstructionsAfter = num_instructions;
+	}
+
+	void SLPCompiler::PartitionIntoBlocks(){
+		auto& slp = slp_under_construction_;
+		auto program = Decode(slp.instructions_);
+
+		auto for_functions = DependencyClosure(program, slp.output_locations_.Functions, slp.number_of_.Functions);
+		auto for_jacobian = DependencyClosure(program, slp.output_locations_.Jacobian, slp.number_of_.Jacobian);
+		auto for_time_deriv = DependencyClosure(program, slp.output_locations_.TimeDeriv, slp.number_of_.TimeDeriv);
+
+		// what each instruction depends on, going forward, since every location is written before it's read.  a location nothing writes, other than a number, is taken to depend on the variables, to be safe.
+		enum class Stage{Constant, Time, Space};
+		std::map<size_t, Stage> stage_of;
+		for (auto const& x : slp.true_values_of_numbers_)
+			stage_of[x.second] = Stage::Constant;
+		if (slp.has_path_variable_)
+			stage_of[slp.input_locations_.Time] = Stage::Time;
+
+		auto StageOf = [&](size_t loc){
+			auto found = stage_of.find(loc);
+			return found==stage_of.end() ? Stage::Space : found->second;
+		};
+
+		std::vector<Stage> stage(program.size());
+		for (size_t ii{0}; ii<program.size(); ++ii){
+			auto const& instr = program[ii];
+			stage[ii] = StageOf(instr.in1);
+			if (SecondOperandInMemory(instr.op))
+				stage[ii] = std::max(stage[ii], StageOf(instr.in2));
+			if (IsTernary(instr.op))
+				stage[ii] = std::max(stage[ii], StageOf(instr.in3));
+			stage_of[instr.out] = stage[ii];
+		}
+
+		// the blocks are closed under dependency, and the constant and time-only ones only read from each other, so a stable partition keeps every instruction after the ones it reads from.
+		std::vector<Instruction> constant, time_only, functions, shared_derivatives, jacobian, time_deriv;
+		for (size_t ii{0}; ii<program.size(); ++ii){
+			if (!for_functions[ii] && !for_jacobian[ii] && !for_time_deriv[ii])
+				continue; // nothing reads it, so drop it
+
+			if (stage[ii]==Stage::Constant)
+				constant.push_back(program[ii]);
+			else if (stage[ii]==Stage::Time)
+				time_only.push_back(program[ii]);
+			else if (for_functions[ii])
+				functions.push_back(program[ii]);
+			else if (for_jacobian[ii] && for_time_deriv[ii])
+				shared_derivatives.push_back(program[ii]);
+			else if (for_jacobian[ii])
+				jacobian.push_back(program[ii]);
+			else
+				time_deriv.push_back(program[ii]);
+		}
+
+		auto& ranges = slp.instruction_ranges_;
+		ranges.ConstantEnd = constant.size();
+		ranges.TimeOnlyEnd = ranges.ConstantEnd + time_only.size();
+		ranges.FunctionsEnd = ranges.TimeOnlyEnd + functions.size();
+		ranges.SharedDerivativesEnd = ranges.FunctionsEnd + shared_derivatives.size();
+		ranges.JacobianEnd = ranges.SharedDerivativesEnd + jacobian.size();
+		ranges.TimeDerivEnd = ranges.JacobianEnd + time_deriv.size();
+
+		slp.instructions_.clear();
+		for (auto const& block : {constant, time_only, functions, shared_derivatives, jacobian, time_deriv})
+			for (auto const& instr : block)
+				Encode(instr, slp.instructions_);
+	}
+
+	void SLPCompiler::ReuseMemory(){
+		auto& slp = slp_under_construction_;
+		auto program = Decode(slp.instructions_);
+
+		auto const& ranges = slp.instruction_ranges_;
+		auto bounds = ranges.Bounds();
+		auto block = BlockOfEachInstruction(program.size(), std::vector<size_t>(bounds.begin()+1, bounds.end()));
+
+		std::set<size_t> number_locations;
+		for (auto const& x : slp.true_values_of_numbers_)
+			number_locations.insert(x.second);
+
+		auto IsTemporary = [&](size_t loc){
+			return loc>=first_temporary_location_ && !number_locations.count(loc);
+		};
+
+
+		// liveness.  a temporary read by a block other than the one computing it has to survive until the next evaluation, so it is pinned to its slot.
+		std::map<size_t, size_t> defining_block, last_read;
+		std::set<size_t> pinned;
+		for (size_t ii{0}; ii<program.size(); ++ii){
+			auto const& instr = program[ii];
+
+			std::vector<size_t> reads{instr.in1};
+			if (SecondOperandInMemory(instr.op))
+				reads.push_back(instr.in2);
+			if (IsTernary(instr.op))
+				reads.push_back(instr.in3);
+
+			for (auto loc : reads)
+				if (IsTemporary(loc)){
+					last_read[loc] = ii;
+					if (defining_block[loc]!=block[ii])
+						pinned.insert(loc);
+				}
+
+			if (IsTemporary(instr.out))
+				defining_block[instr.out] = block[ii];
+		}
+
+
+		// the numbers go first, right after the inputs and outputs, then the slots for temporaries
+		std::map<size_t, size_t> new_location;
+		size_t next_location = first_temporary_location_;
+		for (auto& x : slp.true_values_of_numbers_){
+			if (!new_location.count(x.second))
+				new_location[x.second] = next_location++;
+			x.second = new_location[x.second];
+		}
+
+		auto Relocate = [&](size_t loc){
+			return loc<first_temporary_location_ ? loc : new_location.at(loc);
+		};
+
+
+		// linear scan.  the slot for the result is taken before the operands' slots are given back, so that a result never shares a slot with an operand of the same instruction.
+		std::set<size_t> free_slots; // a set, so the smallest is reused first, and the result is deterministic
+		slp.instructions_.clear();
+		for (size_t ii{0}; ii<program.size(); ++ii){
+			auto instr = program[ii];
+
+			if (IsTemporary(instr.out)){
+				if (free_slots.empty())
+					new_location[instr.out] = next_location++;
+				else{
+					new_location[instr.out] = *free_slots.begin();
+					free_slots.erase(free_slots.begin());
+				}
+			}
+
+			auto in1 = instr.in1, in2 = instr.in2, in3 = instr.in3, out = instr.out;
+			instr.in1 = Relocate(in1);
+			if (SecondOperandInMemory(instr.op))
+				instr.in2 = Relocate(in2);
+			if (IsTernary(instr.op))
+				instr.in3 = Relocate(in3);
+			instr.out = Relocate(out);
+			Encode(instr, slp.instructions_);
+
+			std::set<size_t> done_with;
+			if (IsTemporary(in1) && last_read[in1]==ii)
+				done_with.insert(in1);
+			if (SecondOperandInMemory(instr.op) && IsTemporary(in2) && last_read[in2]==ii)
+				done_with.insert(in2);
+			if (IsTernary(instr.op) && IsTemporary(in3) && last_read[in3]==ii)
+				done_with.insert(in3);
+			if (IsTemporary(out) && !last_read.count(out)) // never read.  only possible if nothing was removed as dead, but let's be safe
+				done_with.insert(out);
+
+			for (auto loc : done_with)
+				if (!pinned.count(loc))
+					free_slots.insert(new_location[loc]);
+		}
+
+		next_available_complex_ = next_location;
+		slp.optimization_statistics_.MemoryAfter = next_available_complex_;
+	}
+
 	void SLPCompiler::Clear(){
 		next_available_complex_ = 0;
 		next_available_int_ = 0;
+		first_temporary_location_ = 0;
+		current_diff_variable_.reset();
 
 		locations_encountered_nodes_.clear();
+		locations_integers_.clear();
+		locations_integer_numbers_.clear();
+		locations_top_level_functions_and_derivatives_.clear();
+		power_tables_.clear();
+		locations_monomials_.clear();
+		is_polynomial_ = false;
 		slp_under_construction_ = SLP();
 	}
 
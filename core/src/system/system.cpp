@@ -24,6 +24,14 @@
 
 
 #include "bertini2/system/system.hpp"
+#include "bertini2/system/slp_binary.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 template<typename NumType> using Vec = bertini::Vec<NumType>;
 template<typename NumType> using Mat = bertini::Mat<NumType>;
@@ -53,6 +61,69 @@ namespace bertini
 		return true;
 	}
 
+	unsigned DefaultNumDifferentiationThreads()
+	{
+		return 0;
+	}
+
+
+	namespace {
+
+		/**
+		 Do work(kk) for every kk in [0,num_tasks), on num_threads threads including the calling one, each taking the next task when done with one.  The first exception thrown by a task is rethrown once all the threads are done.
+
+		 The other threads make nodes in the arena given, if any, and at the calling thread's default precision, as the calling thread would.
+		*/
+		template<typename WorkT>
+		void DifferentiateInParallel(size_t num_tasks, unsigned num_threads, std::shared_ptr<node::NodeArena> const& arena, WorkT const& work)
+		{
+			if (num_threads<=1)
+			{
+				for (size_t kk = 0; kk < num_tasks; ++kk)
+					work(kk);
+				return;
+			}
+
+			const auto precision = mpfr_float::thread_default_precision();
+			const auto options = mpfr_float::thread_default_variable_precision_options();
+
+			std::atomic<size_t> next_task{0};
+			std::exception_ptr error;
+			std::mutex error_mutex;
+
+			auto worker = [&](){
+				mpfr_float::thread_default_precision(precision);
+				mpfr_complex::thread_default_precision(precision);
+				mpfr_float::thread_default_variable_precision_options(options);
+				mpfr_complex::thread_default_variable_precision_options(options);
+				node::NodeArena::Scope arena_scope(arena);
+
+				for (size_t kk = next_task++; kk < num_tasks; kk = next_task++)
+				{
+					try{
+						work(kk);
+					}
+					catch (...){
+						std::lock_guard<std::mutex> lock(error_mutex);
+						if (!error)
+							error = std::current_exception();
+						next_task = num_tasks; // the others stop after their current task
+					}
+				}
+			};
+
+			std::vector<std::thread> threads;
+			for (unsigned t = 1; t < num_threads; ++t)
+				threads.emplace_back(worker);
+			worker();
+			for (auto& t : threads)
+				t.join();
+
+			if (error)
+				std::rethrow_exception(error);
+		}
+	}
+
 	void swap(System & a, System & b)
 	{
 		using std::swap;
@@ -82,9 +153,16 @@ namespace bertini
 
 		swap(a.space_derivatives_,b.space_derivatives_);
 		swap(a.time_derivatives_,b.time_derivatives_);
+		swap(a.flat_tree_,b.flat_tree_);
 
 		swap(a.assume_uniform_precision_,b.assume_uniform_precision_);
 		swap(a.eval_method_,b.eval_method_);
+		swap(a.native_slp_library_,b.native_slp_library_);
+		swap(a.slp_cache_directory_,b.slp_cache_directory_);
+		swap(a.slp_jacobian_method_,b.slp_jacobian_method_);
+		swap(a.intern_nodes_,b.intern_nodes_);
+		swap(a.num_differentiation_threads_,b.num_differentiation_threads_);
+		swap(a.node_arena_,b.node_arena_);
 
 		swap(a.precision_,b.precision_);
 		swap(a.is_patched_,b.is_patched_);
@@ -108,11 +186,18 @@ namespace bertini
 		jacobian_ = other.jacobian_;
 		space_derivatives_ = other.space_derivatives_;
 		time_derivatives_ = other.time_derivatives_;
+		flat_tree_ = other.flat_tree_; // the copy shares the nodes, so it can share their flattening
 
 		is_differentiated_ = other.is_differentiated_;
 
 		assume_uniform_precision_ = other.assume_uniform_precision_;
 		eval_method_ = other.eval_method_;
+		native_slp_library_ = other.native_slp_library_;
+		slp_cache_directory_ = other.slp_cache_directory_;
+		slp_jacobian_method_ = other.slp_jacobian_method_;
+		intern_nodes_ = other.intern_nodes_;
+		num_differentiation_threads_ = other.num_differentiation_threads_;
+		node_arena_ = other.node_arena_;
 
 		time_order_of_variable_groups_ = other.time_order_of_variable_groups_;
 
@@ -284,10 +369,20 @@ namespace bertini
 					break;
 				}
 				case EvalMethod::SLP:
+				case EvalMethod::NativeSLP:
 				{
 					this->slp_.precision(new_precision);
 					break;					
 				}
+				case EvalMethod::FlatTree:
+				{
+					for (const auto& iter : space_derivatives_)
+						iter->precision(new_precision);
+					for (const auto& iter : time_derivatives_)
+						iter->precision(new_precision);
+					this->flat_tree_.precision(new_precision); // after the nodes, since it re-evaluates its numbers from them
+					break;
+				}
 			}
 			
 		}
@@ -322,22 +417,42 @@ namespace bertini
 
 	void System::Differentiate() const
 	{
-		switch (deriv_method_){
-			case DerivMethod::JacobianNode:
-			{
-				DifferentiateUsingJacobianNode();
-				break;
-			}
-			case DerivMethod::Derivatives:
-			{
-				DifferentiateUsingDerivatives();
-				break;
-			}
+		node::NodeArena::Scope arena_scope(node_arena_);
+
+		// a program cached from an earlier run on this same system needs no differentiating or compiling
+		if ((eval_method_==EvalMethod::SLP || eval_method_==EvalMethod::NativeSLP) && !slp_cache_directory_.empty() && SLPCache(slp_cache_directory_).Load(SLPCacheDescription(), this->slp_))
+		{
+			is_differentiated_ = true;
+			if (eval_method_==EvalMethod::NativeSLP && !native_slp_library_.empty())
+				this->slp_.LoadNativeEvaluator(native_slp_library_);
+			return;
 		}
 
+		// the SLP compiler can differentiate the program for the functions itself, and then there's no need for symbolic derivatives
+		if (eval_method_==EvalMethod::FunctionTree || eval_method_==EvalMethod::FlatTree || slp_jacobian_method_==JacobianMethod::Symbolic)
+		{
+			switch (DifferentiationMethod()){
+				case DerivMethod::JacobianNode:
+				{
+					DifferentiateUsingJacobianNode();
+					break;
+				}
+				case DerivMethod::Derivatives:
+				{
+					DifferentiateUsingDerivatives();
+					break;
+				}
+			}
+
 
-		if (auto_simplify_)
-			this->SimplifyDerivatives();
+			if (auto_simplify_)
+				this->SimplifyDerivatives();
+
+			if (intern_nodes_)
+				this->InternNodes();
+		}
+		else
+			is_differentiated_ = true;
 
 
 		switch (eval_method_)
@@ -346,9 +461,27 @@ namespace bertini
 				break;
 			}
 			case EvalMethod::SLP:
+			case EvalMethod::NativeSLP:
 			{	
 				SLPCompiler compiler;
+				compiler.SetJacobianMethod(slp_jacobian_method_);
 				this->slp_ = compiler.Compile(*this);
+				if (!slp_cache_directory_.empty())
+				{
+					try{
+						SLPCache(slp_cache_directory_).Store(SLPCacheDescription(), this->slp_);
+					}
+					catch (std::runtime_error const&){
+						// a cache that can't be written to just goes unused
+					}
+				}
+				if (eval_method_==EvalMethod::NativeSLP && !native_slp_library_.empty())
+					this->slp_.LoadNativeEvaluator(native_slp_library_);
+				break;
+			}
+			case EvalMethod::FlatTree:
+			{
+				FlattenTrees();
 				break;
 			}
 		}
@@ -357,42 +490,165 @@ namespace bertini
 
 	}
 
+	void System::SetNativeSLPLibrary(std::string const& library)
+	{
+		native_slp_library_ = library;
+
+		if (is_differentiated_ && eval_method_==EvalMethod::NativeSLP)
+			this->slp_.LoadNativeEvaluator(native_slp_library_);
+	}
+
+	bool System::HasNativeSLPEvaluator() const
+	{
+		if (eval_method_!=EvalMethod::NativeSLP)
+			return false;
+
+		if (!is_differentiated_)
+			Differentiate();
+
+		return slp_.HasNativeEvaluator();
+	}
+
+	StraightLineProgram::ErrorBounds System::EvalErrorBounds(Vec<dbl> const& variable_values) const
+	{
+		if (!CanEvalErrorBounds())
+			throw std::runtime_error("evaluating with error bounds needs a straight line program, but this system isn't evaluated with one");
+
+		if (!is_differentiated_)
+			Differentiate();
+
+		return slp_.EvalErrorBounds(variable_values);
+	}
+
+	StraightLineProgram::ErrorBounds System::EvalErrorBounds(Vec<dbl> const& variable_values, dbl const& time) const
+	{
+		if (!CanEvalErrorBounds())
+			throw std::runtime_error("evaluating with error bounds needs a straight line program, but this system isn't evaluated with one");
+
+		if (!have_path_variable_)
+			throw std::runtime_error("trying to evaluate with error bounds at a value of the path variable, but one is not defined for this system");
+
+		if (!is_differentiated_)
+			Differentiate();
+
+		return slp_.EvalErrorBounds(variable_values, time);
+	}
+
+	std::string System::SLPCacheDescription() const
+	{
+		std::stringstream description;
+		description.precision(0); // every digit of the numbers.  see the note on precision(0) in NumberKey in straight_line_program.cpp
+
+		description << "SLP jacobian method " << static_cast<int>(slp_jacobian_method_) << '\n';
+		description << "derivative method " << static_cast<int>(deriv_method_) << '\n';
+		description << "simplify " << auto_simplify_ << '\n';
+
+		description << "variables";
+		for (auto const& v : VariableOrdering())
+			description << ' ' << *v;
+		description << '\n';
+
+		if (HavePathVariable())
+			description << "path variable " << *GetPathVariable() << '\n';
+
+		for (auto const& f : functions_)
+			description << *f << '\n';
+
+		return description.str();
+	}
+
+	void System::GenerateNativeSLPSource(std::ostream & out, bool multiple_precision) const
+	{
+		if (!is_differentiated_)
+			Differentiate();
+
+		if (eval_method_!=EvalMethod::SLP && eval_method_!=EvalMethod::NativeSLP){
+			SLPCompiler compiler;
+			compiler.Compile(*this).GenerateCpp(out, multiple_precision);
+		}
+		else
+			this->slp_.GenerateCpp(out, multiple_precision);
+	}
+
+	void System::FlattenTrees() const
+	{
+		flat_tree_ = node::FlatTree();
+
+		for (auto const& v : VariableOrdering())
+			flat_tree_.AddInput(v);
+		if (HavePathVariable())
+			flat_tree_.AddInput(path_variable_);
+
+		flat_tree_.AddOutputs(std::vector<Nd>(functions_.begin(), functions_.end()));
+
+		// the derivatives are flattened one variable of differentiation at a time, which fixes the values of their Differentials.  Differentiate made them with DerivMethod::Derivatives, see DifferentiationMethod
+		const auto num_functions = NumNaturalFunctions();
+		const auto& vars = VariableOrdering();
+		for (size_t jj = 0; jj < vars.size(); ++jj)
+			flat_tree_.AddOutputs(std::vector<Nd>(space_derivatives_.begin()+jj*num_functions, space_derivatives_.begin()+(jj+1)*num_functions), vars[jj]);
+
+		if (HavePathVariable())
+			flat_tree_.AddOutputs(time_derivatives_, path_variable_);
+
+		flat_tree_.precision(precision_);
+	}
+
 	void System::DifferentiateUsingJacobianNode() const
 	{
+		node::NodeArena::Scope arena_scope(node_arena_);
+
 		auto num_functions = NumNaturalFunctions();
 		jacobian_.resize(num_functions);
-		for (int ii = 0; ii < num_functions; ++ii)
+		DifferentiateInParallel(num_functions, NumDifferentiationThreads(num_functions), node_arena_, [&](size_t ii){
 			jacobian_[ii] = Jacobian::Make(functions_[ii]->Differentiate());
+		});
 
 		is_differentiated_ = true;
 	}
 
 	void System::DifferentiateUsingDerivatives() const
 	{
+		node::NodeArena::Scope arena_scope(node_arena_); // also when called directly, by the getters of derivatives
+
 		const auto& vars = this->Variables();
 		const auto num_vars = NumVariables();
 		const auto num_functions = NumNaturalFunctions();
 
-		space_derivatives_.resize(num_functions*num_vars);
-		// again, computing these in column major, so staying with one variable at a time.
-		for (int jj = 0; jj < num_vars; ++jj)
-			for (int ii = 0; ii < num_functions; ++ii)
-				space_derivatives_[ii+jj*num_functions] = Function::Make(functions_[ii]->Differentiate(vars[jj]));
+		const auto num_space_derivatives = num_functions*num_vars;
+		const auto num_time_derivatives = HavePathVariable() ? num_functions : 0;
 
-		if (HavePathVariable())
-		{
-			const auto& t = path_variable_;
-			time_derivatives_.resize(num_functions);
-				for (int ii = 0; ii < num_functions; ++ii)
-					time_derivatives_[ii] = Function::Make(functions_[ii]->Differentiate(t));
-		}
+		space_derivatives_.resize(num_space_derivatives);
+		time_derivatives_.resize(num_time_derivatives);
+
+		// again, computing these in column major.  each goes in its own place, so they're the same no matter which thread makes which
+		const auto num_derivatives = num_space_derivatives + num_time_derivatives;
+		DifferentiateInParallel(num_derivatives, NumDifferentiationThreads(num_derivatives), node_arena_, [&](size_t kk){
+			if (kk < num_space_derivatives)
+				space_derivatives_[kk] = Function::Make(functions_[kk % num_functions]->Differentiate(vars[kk / num_functions]));
+			else
+				time_derivatives_[kk - num_space_derivatives] = Function::Make(functions_[kk - num_space_derivatives]->Differentiate(path_variable_));
+		});
 
 		is_differentiated_ = true;
 	}
 
+	unsigned System::NumDifferentiationThreads(size_t num_derivatives) const
+	{
+		if (num_derivatives==0)
+			return 1;
+
+		if (num_differentiation_threads_!=0)
+			return static_cast<unsigned>(std::min<size_t>(num_differentiation_threads_, num_derivatives));
+
+		// starting threads costs about as much as making a few dozen small derivatives
+		const size_t min_derivatives_per_thread = 64;
+		const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+		return static_cast<unsigned>(std::max<size_t>(1, std::min(hardware, num_derivatives/min_derivatives_per_thread)));
+	}
+
 	std::vector< Nd > System::GetSpaceDerivatives() const
 	{
-		if ( (deriv_method_==DerivMethod::JacobianNode) || (!is_differentiated_) )
+		if ( (DifferentiationMethod()==DerivMethod::JacobianNode) || (!is_differentiated_) || space_derivatives_.empty() )
 			DifferentiateUsingDerivatives();
 
 		return space_derivatives_;
@@ -400,12 +656,20 @@ namespace bertini
 
 	std::vector< Nd > System::GetTimeDerivatives() const
 	{
-		if ( (deriv_method_==DerivMethod::JacobianNode) || (!is_differentiated_) )
+		if ( (DifferentiationMethod()==DerivMethod::JacobianNode) || (!is_differentiated_) || (HavePathVariable() && time_derivatives_.empty()) )
 			DifferentiateUsingDerivatives();
 		
 		return time_derivatives_;
 	}
 
+	std::vector< System::Jac > System::GetJacobianNodes() const
+	{
+		if ( (DifferentiationMethod()==DerivMethod::Derivatives) || (!is_differentiated_) || jacobian_.size()!=NumNaturalFunctions() )
+			DifferentiateUsingJacobianNode();
+
+		return jacobian_;
+	}
+
 	void System::Homogenize()
 	{
 
@@ -1104,7 +1368,7 @@ namespace bertini
 
 
 
-		switch (deriv_method_){
+		switch (DifferentiationMethod()){
 			case DerivMethod::JacobianNode:{
 				for (auto& iter : this->jacobian_)
 					Simplify(iter);
@@ -1145,6 +1409,31 @@ namespace bertini
 
 
 
+	size_t System::InternNodes() const
+	{
+		// the functions go first, so that the nodes kept are theirs, and the derivatives come to share them
+		node::NodeFactory factory;
+		for (auto const& iter : explicit_parameters_)
+			factory.Intern(iter);
+		for (auto const& iter : constant_subfunctions_)
+			factory.Intern(iter);
+		for (auto const& iter : subfunctions_)
+			factory.Intern(iter);
+		for (auto const& iter : functions_)
+			factory.Intern(iter);
+
+		for (auto const& iter : jacobian_)
+			factory.Intern(iter);
+		for (auto const& iter : space_derivatives_)
+			factory.Intern(iter);
+		for (auto const& iter : time_derivatives_)
+			factory.Intern(iter);
+
+		return factory.NumShared();
+	}
+
+
+
 
 
 
@@ -1219,7 +1508,7 @@ namespace bertini
 		{
 			out << "system is differentiated; jacobian:\n";
 
-				switch (s.deriv_method_){
+				switch (s.DifferentiationMethod()){
 					case DerivMethod::JacobianNode:{
 						out << "using the JacobianNode method of differentiation:" << std::endl;
 
@@ -1229,6 +1518,11 @@ namespace bertini
 					}
 
 					case DerivMethod::Derivatives:{
+						if (s.space_derivatives_.empty()){
+							out << "the straight line program differentiates the functions itself" << std::endl;
+							break;
+						}
+
 						out << "using the Derivatives method of differentiation:" << std::endl;
 
 						for (int jj = 0; jj < s.NumVariables(); ++jj)
@@ -1250,7 +1544,7 @@ namespace bertini
 
 
 
-				if (s.eval_method_ == EvalMethod::SLP)
+				if (s.eval_method_==EvalMethod::SLP || s.eval_method_==EvalMethod::NativeSLP)
 				{
 					out << "since using SLP for evaluation, here's the SLP:" << std::endl;
 					out << s.slp_;				
@@ -29,6 +29,7 @@
 
 #include <cstdlib>
 #include <cmath>
+#include <thread>
 
 #include "bertini2/function_tree.hpp"
 
@@ -117,6 +118,182 @@ BOOST_AUTO_TEST_CASE(manual_construction_x_squared){
 
 
 
+BOOST_AUTO_TEST_CASE(new_evaluation_epoch_forgets_stored_values){
+	bertini::DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+
+	std::shared_ptr<Variable> x = Variable::Make("x");
+	std::shared_ptr<Node> N = Float::Make("1.5")*x*x;
+
+	x->set_current_value<dbl>(dbl(2));
+	x->set_current_value<mpfr>(mpfr(2));
+	N->Reset();
+
+	BOOST_CHECK_EQUAL(N->Eval<dbl>(), dbl(6));
+	BOOST_CHECK_EQUAL(N->Eval<mpfr>(), mpfr(6));
+
+	// without a reset, the stored values are still used
+	x->set_current_value<dbl>(dbl(3));
+	x->set_current_value<mpfr>(mpfr(3));
+	BOOST_CHECK_EQUAL(N->Eval<dbl>(), dbl(6));
+	BOOST_CHECK_EQUAL(N->Eval<mpfr>(), mpfr(6));
+
+	// a new epoch does the job of a reset, without walking the tree
+	bertini::node::NewEvaluationEpoch();
+	BOOST_CHECK_EQUAL(N->Eval<dbl>(), dbl(13.5));
+	BOOST_CHECK_EQUAL(N->Eval<mpfr>(), mpfr(13.5));
+}
+
+
+BOOST_AUTO_TEST_CASE(evaluation_epochs_are_per_thread){
+	using bertini::node::CurrentEvaluationEpoch;
+	using bertini::node::NewEvaluationEpoch;
+
+	const auto epoch = CurrentEvaluationEpoch();
+
+	// a new epoch on another thread leaves this one's alone, and is never this one's
+	std::uint64_t other_first, other_second;
+	std::thread other([&](){
+		other_first = CurrentEvaluationEpoch();
+		NewEvaluationEpoch();
+		other_second = CurrentEvaluationEpoch();
+	});
+	other.join();
+
+	BOOST_CHECK_EQUAL(CurrentEvaluationEpoch(), epoch);
+	BOOST_CHECK(other_first!=epoch);
+	BOOST_CHECK(other_second!=epoch);
+	BOOST_CHECK(other_second!=other_first);
+
+	NewEvaluationEpoch();
+	BOOST_CHECK(CurrentEvaluationEpoch()!=epoch);
+	BOOST_CHECK(CurrentEvaluationEpoch()!=other_first);
+	BOOST_CHECK(CurrentEvaluationEpoch()!=other_second);
+}
+
+
+BOOST_AUTO_TEST_CASE(node_factory_shares_identical_subtrees){
+	bertini::DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	using bertini::node::NodeFactory;
+
+	std::shared_ptr<Variable> x = Variable::Make("x");
+	std::shared_ptr<Variable> y = Variable::Make("y");
+
+	std::shared_ptr<Node> a = exp(x*y+1);
+	std::shared_ptr<Node> b = exp(x*y+1);
+	std::shared_ptr<Node> c = exp(x*y-1);
+	std::shared_ptr<Node> d = exp(y*x+1); // not the same, since the factors are in a different order
+	BOOST_CHECK(a!=b);
+
+	NodeFactory factory;
+	auto interned_a = factory.Intern(a);
+	auto interned_b = factory.Intern(b);
+	auto interned_c = factory.Intern(c);
+	auto interned_d = factory.Intern(d);
+
+	BOOST_CHECK(interned_a==a);
+	BOOST_CHECK(interned_b==a);
+	BOOST_CHECK(interned_c!=a);
+	BOOST_CHECK(interned_d!=a);
+	BOOST_CHECK(factory.Intern(a)==a);
+
+	// made by the factory, so it's the very same node
+	BOOST_CHECK(factory.Make<bertini::node::ExpOperator>(x*y+1)==a);
+
+	// c shares the product x*y and the integer 1 with a
+	auto sum_a = std::dynamic_pointer_cast<bertini::node::UnaryOperator>(a)->Operand();
+	auto sum_c = std::dynamic_pointer_cast<bertini::node::UnaryOperator>(interned_c)->Operand();
+	auto const& terms_a = std::dynamic_pointer_cast<bertini::node::NaryOperator>(sum_a)->Operands();
+	auto const& terms_c = std::dynamic_pointer_cast<bertini::node::NaryOperator>(sum_c)->Operands();
+	BOOST_CHECK(terms_a[0]==terms_c[0]);
+	BOOST_CHECK(terms_a[1]==terms_c[1]);
+
+	// the values don't change
+	x->set_current_value<dbl>(dbl(0.5,0.25));
+	y->set_current_value<dbl>(dbl(-1,2));
+	bertini::node::NewEvaluationEpoch();
+	BOOST_CHECK(abs(interned_c->Eval<dbl>() - exp(dbl(0.5,0.25)*dbl(-1,2)-1.)) < threshold_clearance_d);
+	BOOST_CHECK(abs(interned_d->Eval<dbl>() - exp(dbl(0.5,0.25)*dbl(-1,2)+1.)) < threshold_clearance_d);
+}
+
+
+BOOST_AUTO_TEST_CASE(nodes_made_in_an_arena_outlive_it){
+	bertini::DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	using bertini::node::NodeArena;
+
+	std::shared_ptr<Variable> x = Variable::Make("x"); // on the heap
+
+	std::shared_ptr<Node> f;
+	{
+		auto arena = NodeArena::Make();
+		{
+			NodeArena::Scope scope(arena);
+			BOOST_CHECK(NodeArena::Current()==arena.get());
+			f = pow(x,2)*sin(x) + 1;
+		}
+		BOOST_CHECK(NodeArena::Current()==nullptr);
+
+		// a node and a control block each, for the power, the sine, the product, the integer 1 and the sum, at least
+		BOOST_CHECK(arena->NumAllocations() >= 10);
+		const auto num_allocations = arena->NumAllocations();
+
+		std::shared_ptr<Node> g = x*x; // no scope, so on the heap
+		BOOST_CHECK_EQUAL(arena->NumAllocations(), num_allocations);
+	}
+
+	// the arena is gone, but the nodes made in it aren't
+	x->set_current_value<dbl>(dbl(0.5,0.25));
+	bertini::node::NewEvaluationEpoch();
+	BOOST_CHECK(abs(f->Eval<dbl>() - (pow(dbl(0.5,0.25),2)*sin(dbl(0.5,0.25)) + 1.)) < threshold_clearance_d);
+
+	f.reset(); // gives back the arena's memory
+}
+
+
+BOOST_AUTO_TEST_CASE(flat_tree_evaluates_like_the_trees){
+	bertini::DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	using bertini::node::FlatTree;
+
+	std::shared_ptr<Variable> x = Variable::Make("x");
+	std::shared_ptr<Variable> y = Variable::Make("y");
+
+	std::shared_ptr<Node> xy = x*y;
+	std::shared_ptr<Node> f = xy - x/y;
+	std::shared_ptr<Node> g = pow(xy,3)*sin(x);
+
+	FlatTree flat;
+	flat.AddInput(x);
+	flat.AddInput(y);
+	flat.AddOutputs({f,g});
+	BOOST_CHECK_EQUAL(flat.NumInputs(), 2);
+	BOOST_CHECK_EQUAL(flat.NumOutputs(), 2);
+
+	// flattening a tree again adds an output, but no entries
+	const auto num_entries = flat.NumEntries();
+	flat.AddOutputs({f});
+	BOOST_CHECK_EQUAL(flat.NumEntries(), num_entries);
+
+	dbl x_d(0.5,0.25), y_d(-1,2);
+	flat.SetInput(0, x_d);
+	flat.SetInput(1, y_d);
+	BOOST_CHECK(abs(flat.Output<dbl>(0) - (x_d*y_d - x_d/y_d)) < threshold_clearance_d);
+	BOOST_CHECK(abs(flat.Output<dbl>(1) - pow(x_d*y_d,3)*sin(x_d)) < threshold_clearance_d);
+	BOOST_CHECK(abs(flat.Output<dbl>(2) - flat.Output<dbl>(0)) < threshold_clearance_d);
+
+	mpfr x_mp("0.5","0.25"), y_mp("-1","2");
+	flat.SetInput(0, x_mp);
+	flat.SetInput(1, y_mp);
+	x->set_current_value(x_mp);
+	y->set_current_value(y_mp);
+	bertini::node::NewEvaluationEpoch();
+	BOOST_CHECK(abs(flat.Output<mpfr>(0) - f->Eval<mpfr>()) < threshold_clearance_mp);
+	BOOST_CHECK(abs(flat.Output<mpfr>(1) - g->Eval<mpfr>()) < threshold_clearance_mp);
+
+	// a variable which isn't an input can't be flattened
+	std::shared_ptr<Variable> z = Variable::Make("z");
+	BOOST_CHECK_THROW(flat.AddOutputs({x*z}), std::runtime_error);
+}
+
+
 BOOST_AUTO_TEST_CASE(default_constructed_variable_is_not_nan){
 	
 
@@ -1,9 +1,22 @@
 #include <boost/test/unit_test.hpp>
 #include "bertini2/system/straight_line_program.hpp"
+#include "bertini2/system/slp_kernels.hpp"
+#include "bertini2/system/slp_binary.hpp"
+#include "bertini2/system/slp_codegen.hpp"
+#include "bertini2/system/slp_jit.hpp"
 #include "bertini2/system/system.hpp"
 #include "bertini2/io/parsing/system_parsers.hpp"
 #include "bertini2/system/start_systems.hpp"
 
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/filesystem.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <thread>
+
 using Variable = bertini::node::Variable;
 
 using bertini::Operation;
@@ -12,6 +25,78 @@ template<typename NumType> using Vec = bertini::Vec<NumType>;
 template<typename NumType> using Mat = bertini::Mat<NumType>;
 using dbl = bertini::dbl;
 
+
+
+// counting heap allocations, for checking that evaluation doesn't allocate.  C++ allocations are counted by replacing the global operator new, and GMP's, so MPFR's and MPC's, by swapping in GMP memory functions which count.  Only the thread counting is counted, since other tests in this binary differentiate on several threads, and the counts are that thread's alone.
+namespace {
+	struct AllocationCounts{
+		size_t Cxx{0};
+		size_t GMPAllocations{0};
+		size_t GMPReallocations{0};
+		size_t GMPFrees{0};
+	};
+
+	thread_local bool counting_allocations = false;
+	thread_local AllocationCounts allocation_counts;
+
+	void* (*gmp_allocate)(size_t);
+	void* (*gmp_reallocate)(void*, size_t, size_t);
+	void (*gmp_free)(void*, size_t);
+
+	void* CountingAllocate(size_t size){
+		if (counting_allocations)
+			++allocation_counts.GMPAllocations;
+		return gmp_allocate(size);
+	}
+
+	void* CountingReallocate(void* p, size_t old_size, size_t new_size){
+		if (counting_allocations)
+			++allocation_counts.GMPReallocations;
+		return gmp_reallocate(p, old_size, new_size);
+	}
+
+	void CountingFree(void* p, size_t size){
+		if (counting_allocations)
+			++allocation_counts.GMPFrees;
+		gmp_free(p, size);
+	}
+
+	/**
+	 Counts the allocations made on this thread for as long as it lives.  Only one may be around at a time, as it swaps GMP's memory functions for the whole process.
+	 */
+	struct CountAllocations{
+		CountAllocations(){
+			mp_get_memory_functions(&gmp_allocate, &gmp_reallocate, &gmp_free);
+			mp_set_memory_functions(&CountingAllocate, &CountingReallocate, &CountingFree);
+			allocation_counts = AllocationCounts();
+			counting_allocations = true;
+		}
+
+		~CountAllocations(){
+			counting_allocations = false;
+			mp_set_memory_functions(gmp_allocate, gmp_reallocate, gmp_free);
+		}
+	};
+}
+
+void* operator new(std::size_t size){
+	if (counting_allocations)
+		++allocation_counts.Cxx;
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept{
+	std::free(p);
+}
+
+
+
 BOOST_AUTO_TEST_SUITE(SLP_tests)
 
 
@@ -50,6 +135,83 @@ bertini::System ThreeVariableTestSystem(){
 
 
 
+bertini::System PathVariableTestSystem(){
+	std::string str = "variable_group x, y; function f, g; pathvariable t; parameter p; p = t; f = x^2 + p*y; g = x*y - p;";
+
+	bertini::System sys;
+	bool success = bertini::parsing::classic::parse(str.begin(), str.end(), sys);
+
+	return sys;
+}
+
+
+
+bertini::System RepeatedSubexpressionTestSystem(){
+	std::string str = "function f, g; variable_group x, y; f = (x+y)^2 + (x+y)*3; g = (y+x)*2*3 - (1+2)*x;";
+
+	bertini::System sys;
+	bool success = bertini::parsing::classic::parse(str.begin(), str.end(), sys);
+
+	return sys;
+}
+
+
+
+bertini::System ManyTemporariesTestSystem(){
+	std::string str = "variable_group x, y, z; function f, g, h; pathvariable t; parameter p; p = t^2; f = (x*y+z)*(x-y*z)^3 + p*x*y*z; g = exp(x*y)*sin(z) - (x+y+z)^2*p; h = (x*y+z)/(x-y*z) + p*(x-y*z);";
+
+	bertini::System sys;
+	bool success = bertini::parsing::classic::parse(str.begin(), str.end(), sys);
+
+	return sys;
+}
+
+
+
+bertini::System TranscendentalTestSystem(){
+	std::string str = "variable_group x, y; function f, g; pathvariable t; f = sqrt(x)*log(y) - tan(x*y*t) + exp(x)/y^3; g = cos(y)^3 + x^(1.5) - (-x)/(y+t) + sin(x)*y;";
+
+	bertini::System sys;
+	bool success = bertini::parsing::classic::parse(str.begin(), str.end(), sys);
+
+	return sys;
+}
+
+
+
+bertini::System WideSumTestSystem(){
+	std::string str = "variable_group x, y; function f, g; f = -x - y + 2*x*y - x^2 - y^2 + 3 - x*y*y + y/x - 1/x; g = -x/y/(x+1)*y*x - x - y - 1;";
+
+	bertini::System sys;
+	bool success = bertini::parsing::classic::parse(str.begin(), str.end(), sys);
+
+	return sys;
+}
+
+
+
+bertini::System LinearTestSystem(){
+	std::string str = "variable_group x, y; function f, g; f = x + 2*y - 3; g = x - y + y*5;";
+
+	bertini::System sys;
+	bool success = bertini::parsing::classic::parse(str.begin(), str.end(), sys);
+
+	return sys;
+}
+
+
+
+bertini::System DensePolynomialTestSystem(){
+	std::string str = "variable_group x, y, z; function f, g, h; f = x^3 + 2*x^2*y - 3*x*y^2 + 4*y^3 + 5*x^2*z - x*y*z + 7*z^3 - 8*x + 9; g = x^4*y - y^4*z + x^2*y^2*z^2 - 3*x*y*z^3 + z^5 - 1; h = (x^2 - y*z)*(x + y^3) - x^6 + 2*y^5*z;";
+
+	bertini::System sys;
+	bool success = bertini::parsing::classic::parse(str.begin(), str.end(), sys);
+
+	return sys;
+}
+
+
+
 bertini::System HomotopyTotalDegreeTestSystem(){
 	std::string str = "function f, g, h; variable_group x, y, z; f = x+1; g = y-1; h =z/3;";
 
@@ -297,4 +459,1189 @@ BOOST_AUTO_TEST_CASE(evaluate_three_variable_system)
 
 
 
+BOOST_AUTO_TEST_CASE(evaluate_blocks_separately)
+{
+	auto sys = PathVariableTestSystem();
+
+	auto slp = SLP(sys);
+
+	Vec<dbl> values(2);
+	values(0) = dbl(0.5); // x
+	values(1) = dbl(0.1); // y
+	dbl t(0.3);
+
+	dbl x{values(0)}, y{values(1)};
+
+	slp.SetVariableValues(values);
+	slp.SetPathVariable(t);
+
+	// only the functions block is run here
+	Vec<dbl> f = slp.GetFuncVals<dbl>();
+	BOOST_CHECK_SMALL(abs(f(0) - (x*x + t*y)),1e-15);
+	BOOST_CHECK_SMALL(abs(f(1) - (x*y - t)),1e-15);
+
+	Vec<dbl> dt = slp.GetTimeDeriv<dbl>();
+	BOOST_CHECK_SMALL(abs(dt(0) - y),1e-15);
+	BOOST_CHECK_SMALL(abs(dt(1) - (-1.)),1e-15);
+
+	Mat<dbl> J = slp.GetJacobian<dbl>();
+	BOOST_CHECK_SMALL(abs(J(0,0) - (2.*x)),1e-15);
+	BOOST_CHECK_SMALL(abs(J(0,1) - t),1e-15);
+	BOOST_CHECK_SMALL(abs(J(1,0) - y),1e-15);
+	BOOST_CHECK_SMALL(abs(J(1,1) - x),1e-15);
+
+	// new values invalidate all the blocks
+	values(0) = dbl(-1.5);
+	x = values(0);
+	slp.SetVariableValues(values);
+
+	f = slp.GetFuncVals<dbl>();
+	BOOST_CHECK_SMALL(abs(f(0) - (x*x + t*y)),1e-15);
+
+	J = slp.GetJacobian<dbl>();
+	BOOST_CHECK_SMALL(abs(J(0,0) - (2.*x)),1e-15);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(optimization_shrinks_program)
+{
+	auto sys = RepeatedSubexpressionTestSystem();
+
+	auto slp = SLP(sys);
+
+	auto const& stats = slp.GetOptimizationStatistics();
+	BOOST_CHECK(stats.InstructionsAfter < stats.InstructionsBefore);
+	BOOST_CHECK(stats.MemoryAfter < stats.MemoryBefore);
+
+	Vec<dbl> values(2);
+	values(0) = dbl(0.5, 0.2); // x
+	values(1) = dbl(-0.1, 1.3); // y
+
+	dbl x{values(0)}, y{values(1)};
+
+	slp.Eval(values);
+
+	Vec<dbl> f = slp.GetFuncVals<dbl>();
+	BOOST_CHECK_SMALL(abs(f(0) - ((x+y)*(x+y) + 3.*(x+y))),1e-14);
+	BOOST_CHECK_SMALL(abs(f(1) - (6.*(x+y) - 3.*x)),1e-14);
+
+	Mat<dbl> J = slp.GetJacobian<dbl>();
+	BOOST_CHECK_SMALL(abs(J(0,0) - (2.*(x+y) + 3.)),1e-14);
+	BOOST_CHECK_SMALL(abs(J(0,1) - (2.*(x+y) + 3.)),1e-14);
+	BOOST_CHECK_SMALL(abs(J(1,0) - 3.),1e-14);
+	BOOST_CHECK_SMALL(abs(J(1,1) - 6.),1e-14);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(reused_memory_agrees_with_function_tree)
+{
+	auto sys = ManyTemporariesTestSystem();
+	auto slp = SLP(sys);
+
+	// temporaries share slots, so there are fewer slots than instructions
+	BOOST_CHECK(slp.GetOptimizationStatistics().MemoryAfter < slp.GetOptimizationStatistics().MemoryBefore);
+
+	Vec<dbl> values(3);
+	values(0) = dbl(0.5, 0.2); // x
+	values(1) = dbl(-0.1, 1.3); // y
+	values(2) = dbl(0.7, -0.4); // z
+	dbl t(0.3, 0.1);
+
+	sys.SetEvalMethod(bertini::EvalMethod::FunctionTree);
+	Vec<dbl> f_tree = sys.Eval(values, t);
+	Mat<dbl> J_tree = sys.Jacobian(values, t);
+	Vec<dbl> dt_tree = sys.TimeDerivative(values, t);
+
+	// in the order that a corrector and predictor would ask, to exercise running the blocks separately
+	slp.SetVariableValues(values);
+	slp.SetPathVariable(t);
+	Vec<dbl> f = slp.GetFuncVals<dbl>();
+	Mat<dbl> J = slp.GetJacobian<dbl>();
+	Vec<dbl> dt = slp.GetTimeDeriv<dbl>();
+
+	for (int ii = 0; ii < 3; ++ii){
+		BOOST_CHECK_SMALL(abs(f(ii) - f_tree(ii)),1e-13);
+		BOOST_CHECK_SMALL(abs(dt(ii) - dt_tree(ii)),1e-13);
+		for (int jj = 0; jj < 3; ++jj)
+			BOOST_CHECK_SMALL(abs(J(ii,jj) - J_tree(ii,jj)),1e-13);
+	}
+
+	// and the other order
+	values(0) = dbl(-0.25, 0.9);
+	f_tree = sys.Eval(values, t);
+	J_tree = sys.Jacobian(values, t);
+	dt_tree = sys.TimeDerivative(values, t);
+
+	slp.SetVariableValues(values);
+	slp.SetPathVariable(t);
+	dt = slp.GetTimeDeriv<dbl>();
+	J = slp.GetJacobian<dbl>();
+	f = slp.GetFuncVals<dbl>();
+
+	for (int ii = 0; ii < 3; ++ii){
+		BOOST_CHECK_SMALL(abs(f(ii) - f_tree(ii)),1e-13);
+		BOOST_CHECK_SMALL(abs(dt(ii) - dt_tree(ii)),1e-13);
+		for (int jj = 0; jj < 3; ++jj)
+			BOOST_CHECK_SMALL(abs(J(ii,jj) - J_tree(ii,jj)),1e-13);
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE(batch_agrees_with_single_points)
+{
+	auto sys = ManyTemporariesTestSystem();
+	auto slp = SLP(sys);
+
+	const int num_points = 5;
+	Mat<dbl> points(3, num_points);
+	Vec<dbl> times(num_points);
+	for (int p = 0; p < num_points; ++p){
+		points(0,p) = dbl(0.5 - 0.1*p, 0.2);
+		points(1,p) = dbl(-0.1, 1.3 - 0.2*p);
+		points(2,p) = dbl(0.7 + 0.05*p, -0.4);
+		times(p) = dbl(0.3, 0.1*p);
+	}
+
+	slp.EvalBatch(points, times);
+	BOOST_CHECK_EQUAL(slp.BatchSize(), num_points);
+
+	Mat<dbl> f_batch = slp.GetFuncValsBatch<dbl>();
+	std::vector<Mat<dbl>> J_batch = slp.GetJacobianBatch<dbl>();
+	Mat<dbl> dt_batch = slp.GetTimeDerivBatch<dbl>();
+
+	for (int p = 0; p < num_points; ++p){
+		Vec<dbl> x = points.col(p);
+		slp.Eval(x, times(p));
+
+		Vec<dbl> f = slp.GetFuncVals<dbl>();
+		Mat<dbl> J = slp.GetJacobian<dbl>();
+		Vec<dbl> dt = slp.GetTimeDeriv<dbl>();
+
+		for (int ii = 0; ii < 3; ++ii){
+			BOOST_CHECK_SMALL(abs(f(ii) - f_batch(ii,p)),1e-13);
+			BOOST_CHECK_SMALL(abs(dt(ii) - dt_batch(ii,p)),1e-13);
+			for (int jj = 0; jj < 3; ++jj)
+				BOOST_CHECK_SMALL(abs(J(ii,jj) - J_batch[p](ii,jj)),1e-13);
+		}
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE(dispatch_methods_agree)
+{
+	auto sys = ManyTemporariesTestSystem();
+	auto slp = SLP(sys);
+
+	Vec<dbl> values(3);
+	values(0) = dbl(0.5, 0.2); // x
+	values(1) = dbl(-0.1, 1.3); // y
+	values(2) = dbl(0.7, -0.4); // z
+	dbl t(0.3, 0.1);
+
+	BOOST_CHECK(slp.GetDispatchMethod()==bertini::DispatchMethod::JIT);
+#if BERTINI_SLP_JIT_AVAILABLE
+	BOOST_CHECK(slp.HasJIT());
+#endif
+
+	slp.SetDispatchMethod(bertini::DispatchMethod::Threaded);
+	slp.Eval(values, t);
+	Vec<dbl> f_threaded = slp.GetFuncVals<dbl>();
+	Mat<dbl> J_threaded = slp.GetJacobian<dbl>();
+	Vec<dbl> dt_threaded = slp.GetTimeDeriv<dbl>();
+
+	slp.SetDispatchMethod(bertini::DispatchMethod::Switch);
+	slp.Eval(values, t);
+
+	// the same operations in the same order, so exactly the same results
+	BOOST_CHECK(slp.GetFuncVals<dbl>()==f_threaded);
+	BOOST_CHECK(slp.GetJacobian<dbl>()==J_threaded);
+	BOOST_CHECK(slp.GetTimeDeriv<dbl>()==dt_threaded);
+
+	// the machine code multiplies with the same formula, but the interpreter might have been compiled to use fused multiply-adds
+	slp.SetDispatchMethod(bertini::DispatchMethod::JIT);
+	slp.Eval(values, t);
+
+	Vec<dbl> f_jit = slp.GetFuncVals<dbl>();
+	Mat<dbl> J_jit = slp.GetJacobian<dbl>();
+	Vec<dbl> dt_jit = slp.GetTimeDeriv<dbl>();
+	for (int ii = 0; ii < 3; ++ii){
+		BOOST_CHECK_SMALL(abs(f_jit(ii) - f_threaded(ii)), 1e-14);
+		BOOST_CHECK_SMALL(abs(dt_jit(ii) - dt_threaded(ii)), 1e-14);
+		for (int jj = 0; jj < 3; ++jj)
+			BOOST_CHECK_SMALL(abs(J_jit(ii,jj) - J_threaded(ii,jj)), 1e-14);
+	}
+
+	// and it's remade when loading
+	std::stringstream archive;
+	{
+		boost::archive::text_oarchive oa(archive);
+		oa << slp;
+	}
+	SLP loaded;
+	{
+		boost::archive::text_iarchive ia(archive);
+		ia >> loaded;
+	}
+	BOOST_CHECK_EQUAL(loaded.HasJIT(), slp.HasJIT());
+}
+
+
+
+BOOST_AUTO_TEST_CASE(automatic_differentiation_agrees_with_symbolic)
+{
+	using bertini::JacobianMethod;
+
+	// more functions than variables, and fewer
+	BOOST_CHECK(bertini::SLPCompiler::ChooseAutomaticDifferentiationMode(3, 2)==JacobianMethod::Forward);
+	BOOST_CHECK(bertini::SLPCompiler::ChooseAutomaticDifferentiationMode(1, 4)==JacobianMethod::Reverse);
+
+	for (auto sys : {ManyTemporariesTestSystem(), TranscendentalTestSystem()})
+	{
+		const auto num_functions = sys.NumNaturalFunctions();
+		const auto num_variables = sys.NumVariables();
+
+		Vec<dbl> values(num_variables);
+		for (unsigned jj = 0; jj < num_variables; ++jj)
+			values(jj) = dbl(0.5 - 0.2*jj, 0.2 + 0.3*jj);
+		dbl t(0.3, 0.1);
+
+		auto symbolic = SLP(sys);
+		symbolic.Eval(values, t);
+		Mat<dbl> J_symbolic = symbolic.GetJacobian<dbl>();
+		Vec<dbl> dt_symbolic = symbolic.GetTimeDeriv<dbl>();
+
+		for (auto method : {JacobianMethod::Forward, JacobianMethod::Reverse, JacobianMethod::Automatic})
+		{
+			bertini::SLPCompiler compiler;
+			compiler.SetJacobianMethod(method);
+			auto slp = compiler.Compile(sys);
+
+			slp.Eval(values, t);
+			Vec<dbl> f = slp.GetFuncVals<dbl>();
+			Mat<dbl> J = slp.GetJacobian<dbl>();
+			Vec<dbl> dt = slp.GetTimeDeriv<dbl>();
+
+			for (unsigned ii = 0; ii < num_functions; ++ii){
+				BOOST_CHECK_SMALL(abs(f(ii) - symbolic.GetFuncVals<dbl>()(ii)), 1e-13);
+				BOOST_CHECK_SMALL(abs(dt(ii) - dt_symbolic(ii)), 1e-12);
+				for (unsigned jj = 0; jj < num_variables; ++jj)
+					BOOST_CHECK_SMALL(abs(J(ii,jj) - J_symbolic(ii,jj)), 1e-12);
+			}
+		}
+
+		// and through the system, which then doesn't differentiate symbolically at all
+		auto tree = sys;
+		tree.SetEvalMethod(bertini::EvalMethod::FunctionTree);
+		Mat<dbl> J_tree = tree.Jacobian(values, t);
+
+		sys.SetEvalMethod(bertini::EvalMethod::SLP);
+		sys.SetSLPJacobianMethod(JacobianMethod::Reverse);
+		BOOST_CHECK(sys.GetSLPJacobianMethod()==JacobianMethod::Reverse);
+		Mat<dbl> J = sys.Jacobian(values, t);
+		for (unsigned ii = 0; ii < num_functions; ++ii)
+			for (unsigned jj = 0; jj < num_variables; ++jj)
+				BOOST_CHECK_SMALL(abs(J(ii,jj) - J_tree(ii,jj)), 1e-12);
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE(chain_and_pairwise_reduction_agree)
+{
+	auto sys = WideSumTestSystem();
+
+	Vec<dbl> values(2);
+	values(0) = dbl(0.5, 0.2); // x
+	values(1) = dbl(-0.1, 1.3); // y
+
+	sys.SetEvalMethod(bertini::EvalMethod::FunctionTree);
+	Vec<dbl> f_tree = sys.Eval(values);
+	Mat<dbl> J_tree = sys.Jacobian(values);
+
+	bertini::SLPCompiler compiler;
+	BOOST_CHECK(compiler.GetReductionMethod()==bertini::ReductionMethod::Pairwise);
+	auto pairwise = compiler.Compile(sys);
+
+	compiler.SetReductionMethod(bertini::ReductionMethod::Chain);
+	auto chain = compiler.Compile(sys);
+
+	// the same operations, in a different order, with no more inversions
+	BOOST_CHECK(pairwise.GetOptimizationStatistics().InstructionsBefore <= chain.GetOptimizationStatistics().InstructionsBefore);
+
+	for (auto slp : {pairwise, chain})
+	{
+		slp.Eval(values);
+		Vec<dbl> f = slp.GetFuncVals<dbl>();
+		Mat<dbl> J = slp.GetJacobian<dbl>();
+
+		for (int ii = 0; ii < 2; ++ii){
+			BOOST_CHECK_SMALL(abs(f(ii) - f_tree(ii)), 1e-13);
+			for (int jj = 0; jj < 2; ++jj)
+				BOOST_CHECK_SMALL(abs(J(ii,jj) - J_tree(ii,jj)), 1e-13);
+		}
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE(polynomial_methods_agree_with_function_tree)
+{
+	auto sys = DensePolynomialTestSystem();
+	BOOST_CHECK(sys.IsPolynomial());
+
+	Vec<dbl> values(3);
+	values(0) = dbl(0.5, 0.2); // x
+	values(1) = dbl(-0.1, 1.3); // y
+	values(2) = dbl(0.7, -0.4); // z
+
+	sys.SetEvalMethod(bertini::EvalMethod::FunctionTree);
+	Vec<dbl> f_tree = sys.Eval(values);
+	Mat<dbl> J_tree = sys.Jacobian(values);
+
+	bertini::SLPCompiler compiler;
+	BOOST_CHECK(compiler.GetPolynomialMethod()==bertini::PolynomialMethod::SparseMonomial);
+
+	using bertini::PolynomialMethod;
+	using bertini::JacobianMethod;
+	for (auto method : {PolynomialMethod::Generic, PolynomialMethod::SparseMonomial, PolynomialMethod::Horner})
+		for (auto jacobian_method : {JacobianMethod::Symbolic, JacobianMethod::Reverse})
+		{
+			compiler.SetPolynomialMethod(method);
+			compiler.SetJacobianMethod(jacobian_method);
+			auto slp = compiler.Compile(sys);
+
+			slp.Eval(values);
+			Vec<dbl> f = slp.GetFuncVals<dbl>();
+			Mat<dbl> J = slp.GetJacobian<dbl>();
+
+			for (int ii = 0; ii < 3; ++ii){
+				BOOST_CHECK_SMALL(abs(f(ii) - f_tree(ii)), 1e-13);
+				for (int jj = 0; jj < 3; ++jj)
+					BOOST_CHECK_SMALL(abs(J(ii,jj) - J_tree(ii,jj)), 1e-12);
+			}
+		}
+}
+
+
+
+BOOST_AUTO_TEST_CASE(changing_precision_rounds_cached_numbers)
+{
+	using mpfr_complex = bertini::mpfr_complex;
+
+	std::string str = "variable_group x, y; function f, g; f = x/3 + 0.1*y - 2/7; g = x*y*(1/11) + pi;";
+	bertini::System sys;
+	bertini::parsing::classic::parse(str.begin(), str.end(), sys);
+
+	const auto initial_precision = bertini::DefaultPrecision();
+	SLP slp(sys);
+
+	// up, down below where it started, then back up to where the numbers are cached.  each time it should agree with an SLP compiled at that precision
+	for (unsigned digits : {60u, 30u, 20u, 60u, 40u})
+	{
+		bertini::DefaultPrecision(digits);
+		slp.precision(digits);
+		SLP fresh(sys);
+
+		Vec<mpfr_complex> values(2);
+		values(0) = mpfr_complex("0.5","0.2");
+		values(1) = mpfr_complex("-0.1","1.3");
+
+		slp.Eval(values);
+		fresh.Eval(values);
+		Vec<mpfr_complex> f = slp.GetFuncVals<mpfr_complex>();
+		Vec<mpfr_complex> f_fresh = fresh.GetFuncVals<mpfr_complex>();
+
+		for (int ii = 0; ii < 2; ++ii)
+			BOOST_CHECK(abs(f(ii) - f_fresh(ii)) < pow(bertini::mpfr_float(10), -static_cast<int>(digits)+2));
+	}
+
+	bertini::DefaultPrecision(initial_precision);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(shared_program_with_workspaces_per_thread)
+{
+	std::string str = "variable_group x, y; function f, g; f = x^3*y - 2/7 + exp(x); g = x*y*(1/11) + y^2;";
+	bertini::System sys;
+	bertini::parsing::classic::parse(str.begin(), str.end(), sys);
+
+	const SLP slp(sys);
+
+	const unsigned num_threads = 4, points_per_thread = 50;
+	std::vector<Vec<dbl>> points;
+	std::vector<Vec<dbl>> expected_f;
+	std::vector<Mat<dbl>> expected_j;
+	for (unsigned ii = 0; ii < num_threads*points_per_thread; ++ii)
+	{
+		Vec<dbl> values(2);
+		values(0) = dbl(0.01*ii, -0.3);
+		values(1) = dbl(0.7, 0.02*ii);
+		points.push_back(values);
+
+		slp.Eval(values);
+		expected_f.push_back(slp.GetFuncVals<dbl>());
+		expected_j.push_back(slp.GetJacobian<dbl>());
+	}
+
+	std::vector<unsigned> mismatches(num_threads, 0);
+	std::vector<std::thread> threads;
+	for (unsigned t = 0; t < num_threads; ++t)
+		threads.emplace_back([&, t]{
+			auto workspace = slp.MakeWorkspace();
+			for (unsigned ii = t*points_per_thread; ii < (t+1)*points_per_thread; ++ii)
+			{
+				slp.Eval(workspace, points[ii]);
+				if (slp.GetFuncVals<dbl>(workspace) != expected_f[ii] || slp.GetJacobian<dbl>(workspace) != expected_j[ii])
+					++mismatches[t];
+			}
+		});
+	for (auto& t : threads)
+		t.join();
+
+	for (auto m : mismatches)
+		BOOST_CHECK_EQUAL(m, 0);
+
+	// a workspace's precision is its own
+	using mpfr_complex = bertini::mpfr_complex;
+	const auto initial_precision = bertini::DefaultPrecision();
+	auto workspace = slp.MakeWorkspace();
+	bertini::DefaultPrecision(40);
+	slp.precision(workspace, 40);
+	BOOST_CHECK_EQUAL(slp.precision(), initial_precision);
+
+	Vec<mpfr_complex> values(2);
+	values(0) = mpfr_complex("0.5","0.2");
+	values(1) = mpfr_complex("-0.1","1.3");
+	slp.Eval(workspace, values);
+	Vec<mpfr_complex> f = slp.GetFuncVals<mpfr_complex>(workspace);
+
+	SLP fresh(sys);
+	fresh.Eval(values);
+	Vec<mpfr_complex> f_fresh = fresh.GetFuncVals<mpfr_complex>();
+	for (int ii = 0; ii < 2; ++ii)
+		BOOST_CHECK(abs(f(ii) - f_fresh(ii)) < pow(bertini::mpfr_float(10), -38));
+
+	bertini::DefaultPrecision(initial_precision);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(binary_format_round_trips)
+{
+	using mpfr_complex = bertini::mpfr_complex;
+
+	// integers, rationals, floats, pi and e, and the numbers the optimizer folds together out of them
+	std::string str = "variable_group x, y; function f, g; f = x*(2/7 + pi) + 0.1*y^2 - sqrt(3)*e; g = x*y*(1/11) - y^(-2) + 1.25;";
+	bertini::System sys;
+	bertini::parsing::classic::parse(str.begin(), str.end(), sys);
+
+	SLP slp(sys);
+	std::stringstream binary;
+	slp.WriteBinary(binary);
+
+	SLP read;
+	read.ReadBinary(binary);
+	BOOST_CHECK_EQUAL(read.Fingerprint(), slp.Fingerprint());
+
+	Vec<dbl> values(2);
+	values(0) = dbl(0.5, 0.2);
+	values(1) = dbl(-0.1, 1.3);
+	slp.Eval(values);
+	read.Eval(values);
+	BOOST_CHECK(read.GetFuncVals<dbl>() == slp.GetFuncVals<dbl>());
+	BOOST_CHECK(read.GetJacobian<dbl>() == slp.GetJacobian<dbl>());
+
+	// the numbers are still exact, so going up in precision works as always
+	const auto initial_precision = bertini::DefaultPrecision();
+	bertini::DefaultPrecision(50);
+	slp.precision(50);
+	read.precision(50);
+	Vec<mpfr_complex> mp_values(2);
+	mp_values(0) = mpfr_complex("0.5","0.2");
+	mp_values(1) = mpfr_complex("-0.1","1.3");
+	slp.Eval(mp_values);
+	read.Eval(mp_values);
+	Vec<mpfr_complex> f = slp.GetFuncVals<mpfr_complex>(), f_read = read.GetFuncVals<mpfr_complex>();
+	for (int ii = 0; ii < 2; ++ii)
+		BOOST_CHECK(abs(f(ii) - f_read(ii)) < pow(bertini::mpfr_float(10), -48));
+	bertini::DefaultPrecision(initial_precision);
+
+	// anything cut short, or changed, doesn't read
+	auto bytes = binary.str();
+	std::stringstream truncated(bytes.substr(0, bytes.size()-1));
+	BOOST_CHECK_THROW(read.ReadBinary(truncated), std::runtime_error);
+
+	bytes[bytes.size()/2] ^= 1;
+	std::stringstream changed(bytes);
+	BOOST_CHECK_THROW(read.ReadBinary(changed), std::runtime_error);
+
+	std::stringstream not_a_program("this is not a program");
+	BOOST_CHECK_THROW(read.ReadBinary(not_a_program), std::runtime_error);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(slp_cache_reads_back_compiled_program)
+{
+	auto dir = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("b2_slp_cache_test_%%%%-%%%%")).string();
+
+	auto sys = ManyTemporariesTestSystem();
+	sys.SetEvalMethod(bertini::EvalMethod::SLP);
+	sys.SetSLPCacheDirectory(dir);
+
+	auto same = ManyTemporariesTestSystem();
+	same.SetEvalMethod(bertini::EvalMethod::SLP);
+	same.SetSLPCacheDirectory(dir);
+
+	const auto description = sys.SLPCacheDescription();
+	BOOST_CHECK_EQUAL(description, same.SLPCacheDescription());
+	BOOST_CHECK(description != PathVariableTestSystem().SLPCacheDescription());
+
+	bertini::SLPCache cache(dir);
+	const auto key = bertini::SLPCache::Key(description);
+	SLP slp;
+	BOOST_CHECK(!cache.Load(description, slp));
+
+	Vec<dbl> values(3);
+	values(0) = dbl(0.5, 0.2); // x
+	values(1) = dbl(-0.1, 1.3); // y
+	values(2) = dbl(0.7, -0.4); // z
+	dbl t(0.3, 0.1);
+
+	Vec<dbl> f = sys.Eval(values, t); // compiles, and stores the program
+	Mat<dbl> J = sys.Jacobian(values, t);
+	BOOST_CHECK(boost::filesystem::exists(cache.PathFor(key)));
+	BOOST_CHECK(cache.Load(description, slp));
+
+	// an entry under the key of another description, as if their hashes collided, isn't taken for it
+	const auto other = PathVariableTestSystem().SLPCacheDescription();
+	boost::filesystem::copy_file(cache.PathFor(key), cache.PathFor(bertini::SLPCache::Key(other)));
+	BOOST_CHECK(!cache.Load(other, slp));
+
+	Vec<dbl> f_cached = same.Eval(values, t); // reads the program back
+	Mat<dbl> J_cached = same.Jacobian(values, t);
+	BOOST_CHECK(f_cached == f);
+	BOOST_CHECK(J_cached == J);
+
+	boost::filesystem::remove_all(dir);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(profiling_counts_every_instruction)
+{
+	using mpfr_complex = bertini::mpfr_complex;
+
+	auto sys = ManyTemporariesTestSystem();
+	SLP slp(sys);
+	SLP unprofiled(sys);
+
+	const auto stats = slp.GetProgramStatistics();
+	BOOST_CHECK_EQUAL(stats.Instructions, slp.GetOptimizationStatistics().InstructionsAfter);
+	BOOST_CHECK(stats.LongestChain > 0);
+	BOOST_CHECK(stats.LongestChain <= stats.Instructions);
+
+	slp.SetProfiling(true);
+
+	Vec<dbl> values(3);
+	values(0) = dbl(0.5, 0.2); // x
+	values(1) = dbl(-0.1, 1.3); // y
+	values(2) = dbl(0.7, -0.4); // z
+	dbl t(0.3, 0.1);
+
+	const unsigned num_evaluations = 3;
+	for (unsigned ii = 0; ii < num_evaluations; ++ii)
+		slp.Eval(values, t);
+	unprofiled.Eval(values, t);
+
+	// profiling doesn't change the results
+	BOOST_CHECK(slp.GetFuncVals<dbl>() == unprofiled.GetFuncVals<dbl>());
+	BOOST_CHECK(slp.GetJacobian<dbl>() == unprofiled.GetJacobian<dbl>());
+
+	auto profile = slp.GetProfile();
+	size_t dbl_count = 0, mpfr_count = 0;
+	for (unsigned ii = 0; ii < bertini::NumOperations; ++ii){
+		dbl_count += profile.Double[ii].Count;
+		mpfr_count += profile.Multiple[ii].Count;
+		BOOST_CHECK(profile.Double[ii].Seconds >= 0);
+	}
+	// the constant block ran when the numbers were put in memory, before profiling, and the time-only block only the first time, since t didn't change
+	const auto space_instructions = stats.Instructions - stats.ConstantStage - stats.TimeStage;
+	BOOST_CHECK_EQUAL(dbl_count, num_evaluations*space_instructions + stats.TimeStage);
+	BOOST_CHECK_EQUAL(mpfr_count, 0);
+	BOOST_CHECK(profile.Double[bertini::OpcodeIndex(Operation::Multiply)].Count > 0);
+
+	Vec<mpfr_complex> mp_values(3);
+	mp_values(0) = mpfr_complex("0.5","0.2");
+	mp_values(1) = mpfr_complex("-0.1","1.3");
+	mp_values(2) = mpfr_complex("0.7","-0.4");
+	slp.Eval(mp_values, mpfr_complex("0.3","0.1"));
+
+	profile = slp.GetProfile();
+	mpfr_count = 0;
+	for (unsigned ii = 0; ii < bertini::NumOperations; ++ii)
+		mpfr_count += profile.Multiple[ii].Count;
+	BOOST_CHECK_EQUAL(mpfr_count, stats.Instructions - stats.ConstantStage);
+
+	std::stringstream printed, json;
+	printed << profile;
+	profile.WriteJSON(json);
+	BOOST_CHECK(printed.str().find("Multiply") != std::string::npos);
+	BOOST_CHECK(json.str().find("\"longest_chain\": " + std::to_string(stats.LongestChain)) != std::string::npos);
+
+	// off, and cleared, nothing more is recorded
+	slp.SetProfiling(false);
+	slp.ClearProfile();
+	slp.Eval(values, t);
+	profile = slp.GetProfile();
+	for (unsigned ii = 0; ii < bertini::NumOperations; ++ii)
+		BOOST_CHECK_EQUAL(profile.Double[ii].Count, 0);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(error_bounds_contain_actual_error)
+{
+	using mpfr_complex = bertini::mpfr_complex;
+	const auto initial_precision = bertini::DefaultPrecision();
+
+	for (auto sys : {ManyTemporariesTestSystem(), TranscendentalTestSystem()})
+	{
+		bertini::DefaultPrecision(initial_precision);
+		SLP slp(sys);
+		const auto num_variables = slp.NumVariables();
+		const auto num_functions = slp.NumFunctions();
+
+		Vec<dbl> values(num_variables);
+		for (unsigned ii = 0; ii < num_variables; ++ii)
+			values(ii) = dbl(0.4 + 0.1*ii, 0.3 - 0.2*ii);
+		dbl t(0.3, 0.1);
+
+		auto bounds = slp.EvalErrorBounds(values, t);
+		BOOST_CHECK(bounds.Trustworthy(1e-10));
+		BOOST_CHECK(bounds.Functions > 0);
+
+		// doesn't disturb plain evaluation
+		slp.Eval(values, t);
+		Vec<dbl> f = slp.GetFuncVals<dbl>();
+		Mat<dbl> J = slp.GetJacobian<dbl>();
+
+		// the same point, exactly, in much higher precision
+		bertini::DefaultPrecision(50);
+		SLP exact(sys);
+		Vec<mpfr_complex> mp_values(num_variables);
+		for (unsigned ii = 0; ii < num_variables; ++ii)
+			mp_values(ii) = mpfr_complex(values(ii));
+		exact.Eval(mp_values, mpfr_complex(t));
+		Vec<mpfr_complex> f_exact = exact.GetFuncVals<mpfr_complex>();
+		Mat<mpfr_complex> J_exact = exact.GetJacobian<mpfr_complex>();
+
+		for (unsigned ii = 0; ii < num_functions; ++ii){
+			BOOST_CHECK(abs(mpfr_complex(f(ii)) - f_exact(ii)) <= bertini::mpfr_float(bounds.Functions));
+			for (unsigned jj = 0; jj < num_variables; ++jj)
+				BOOST_CHECK(abs(mpfr_complex(J(ii,jj)) - J_exact(ii,jj)) <= bertini::mpfr_float(bounds.Jacobian));
+		}
+	}
+
+	bertini::DefaultPrecision(initial_precision);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(error_bounds_near_a_pole_are_not_trustworthy)
+{
+	bertini::System sys;
+	std::string str = "variable_group x; function f; f = 1/(x - 0.1);";
+	bertini::parsing::classic::parse(str.begin(), str.end(), sys);
+
+	SLP slp(sys);
+
+	Vec<dbl> values(1);
+	values(0) = dbl(0.7);
+	BOOST_CHECK(slp.EvalErrorBounds(values).Trustworthy(1e-10));
+
+	values(0) = dbl(0.1); // the difference rounds to 0
+	auto bounds = slp.EvalErrorBounds(values);
+	BOOST_CHECK(!bounds.Trustworthy(1e-10));
+	BOOST_CHECK(std::isinf(bounds.Functions));
+}
+
+
+
+BOOST_AUTO_TEST_CASE(time_only_instructions_run_only_when_time_changes)
+{
+	auto sys = ManyTemporariesTestSystem(); // p = t^2, and its derivative, depend only on t
+	SLP slp(sys);
+
+	const auto stats = slp.GetProgramStatistics();
+	BOOST_CHECK(stats.TimeStage > 0);
+	const auto space_instructions = stats.Instructions - stats.ConstantStage - stats.TimeStage;
+
+	auto InstructionsRun = [&](){
+		auto profile = slp.GetProfile();
+		size_t count = 0;
+		for (unsigned ii = 0; ii < bertini::NumOperations; ++ii)
+			count += profile.Double[ii].Count;
+		slp.ClearProfile();
+		return count;
+	};
+
+	Vec<dbl> values(3);
+	values(0) = dbl(0.5, 0.2); // x
+	values(1) = dbl(-0.1, 1.3); // y
+	values(2) = dbl(0.7, -0.4); // z
+	dbl t(0.3, 0.1), other_t(-0.6, 0.2);
+
+	slp.SetProfiling(true);
+
+	slp.Eval(values, t);
+	BOOST_CHECK_EQUAL(InstructionsRun(), space_instructions + stats.TimeStage);
+
+	// only the space variables change
+	values(0) = dbl(-0.3, 0.9);
+	slp.Eval(values, t);
+	BOOST_CHECK_EQUAL(InstructionsRun(), space_instructions);
+
+	SLP fresh(sys);
+	fresh.Eval(values, t);
+	BOOST_CHECK(slp.GetFuncVals<dbl>() == fresh.GetFuncVals<dbl>());
+	BOOST_CHECK(slp.GetJacobian<dbl>() == fresh.GetJacobian<dbl>());
+	BOOST_CHECK(slp.GetTimeDeriv<dbl>() == fresh.GetTimeDeriv<dbl>());
+
+	// then the path variable
+	slp.Eval(values, other_t);
+	BOOST_CHECK_EQUAL(InstructionsRun(), space_instructions + stats.TimeStage);
+
+	fresh.Eval(values, other_t);
+	BOOST_CHECK(slp.GetFuncVals<dbl>() == fresh.GetFuncVals<dbl>());
+	BOOST_CHECK(slp.GetTimeDeriv<dbl>() == fresh.GetTimeDeriv<dbl>());
+
+	// setting the same time again is free
+	slp.SetPathVariable(other_t);
+	slp.EvalFunctions<dbl>();
+	BOOST_CHECK_EQUAL(InstructionsRun(), 0);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(constant_instructions_run_once)
+{
+	// every entry of the Jacobian is a number, copied into place when the program is made, and never again
+	SLP slp(LinearTestSystem());
+	BOOST_CHECK(slp.GetProgramStatistics().ConstantStage > 0);
+
+	slp.SetProfiling(true);
+
+	Vec<dbl> values(2);
+	for (int ii = 0; ii < 2; ++ii){
+		values << dbl(ii+1.0, 0.5), dbl(-0.25, ii);
+		slp.Eval(values);
+
+		Mat<dbl> J = slp.GetJacobian<dbl>();
+		BOOST_CHECK_EQUAL(J(0,0), dbl(1));
+		BOOST_CHECK_EQUAL(J(0,1), dbl(2));
+		BOOST_CHECK_EQUAL(J(1,0), dbl(1));
+		BOOST_CHECK_EQUAL(J(1,1), dbl(4));
+	}
+
+	const auto stats = slp.GetProgramStatistics();
+	auto profile = slp.GetProfile();
+	size_t count = 0;
+	for (unsigned ii = 0; ii < bertini::NumOperations; ++ii)
+		count += profile.Double[ii].Count;
+	BOOST_CHECK_EQUAL(count, 2*(stats.Instructions - stats.ConstantStage));
+
+	// changing precision puts the numbers back, and the constants with them
+	const auto initial_precision = bertini::DefaultPrecision();
+	bertini::DefaultPrecision(40);
+	slp.precision(40);
+
+	Vec<bertini::mpfr_complex> mp_values(2);
+	mp_values << bertini::mpfr_complex(1), bertini::mpfr_complex(2);
+	slp.Eval(mp_values);
+	BOOST_CHECK(slp.GetJacobian<bertini::mpfr_complex>()(1,1) == bertini::mpfr_complex(4));
+
+	bertini::DefaultPrecision(initial_precision);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(fused_instructions_agree_with_unfused)
+{
+	using mpfr_complex = bertini::mpfr_complex;
+	using bertini::OpcodeIndex;
+
+	BOOST_CHECK(bertini::IsTernary(Operation::FMA));
+	BOOST_CHECK(bertini::IsTernary(Operation::MulAddConst));
+	BOOST_CHECK(IsUnary(Operation::Square));
+	BOOST_CHECK(!bertini::SecondOperandInMemory(Operation::ScaleByInt));
+
+	for (auto sys : {DensePolynomialTestSystem(), ManyTemporariesTestSystem()})
+	{
+		const auto num_functions = sys.NumNaturalFunctions();
+		const auto num_variables = sys.NumVariables();
+
+		bertini::SLPCompiler compiler;
+		BOOST_CHECK(compiler.GetFuseInstructions());
+		auto fused = compiler.Compile(sys);
+
+		compiler.SetFuseInstructions(false);
+		auto unfused = compiler.Compile(sys);
+
+		BOOST_CHECK(fused.GetOptimizationStatistics().InstructionsAfter < unfused.GetOptimizationStatistics().InstructionsAfter);
+
+		Vec<dbl> values(num_variables);
+		Vec<mpfr_complex> mp_values(num_variables);
+		for (unsigned jj = 0; jj < num_variables; ++jj){
+			values(jj) = dbl(0.5 - 0.2*jj, 0.2 + 0.3*jj);
+			mp_values(jj) = mpfr_complex(values(jj).real(), values(jj).imag());
+		}
+		dbl t(0.3, 0.1);
+		mpfr_complex mp_t(t.real(), t.imag());
+
+		for (auto method : {bertini::DispatchMethod::Switch, bertini::DispatchMethod::Threaded, bertini::DispatchMethod::JIT})
+		{
+			fused.SetDispatchMethod(method);
+			unfused.SetDispatchMethod(method);
+
+			if (sys.HavePathVariable()){
+				fused.Eval(values, t);
+				unfused.Eval(values, t);
+			}
+			else{
+				fused.Eval(values);
+				unfused.Eval(values);
+			}
+
+			for (unsigned ii = 0; ii < num_functions; ++ii){
+				BOOST_CHECK_SMALL(abs(fused.GetFuncVals<dbl>()(ii) - unfused.GetFuncVals<dbl>()(ii)), 1e-12);
+				for (unsigned jj = 0; jj < num_variables; ++jj)
+					BOOST_CHECK_SMALL(abs(fused.GetJacobian<dbl>()(ii,jj) - unfused.GetJacobian<dbl>()(ii,jj)), 1e-12);
+			}
+		}
+
+		fused.SetProfiling(true);
+		if (sys.HavePathVariable()){
+			fused.Eval(mp_values, mp_t);
+			unfused.Eval(mp_values, mp_t);
+		}
+		else{
+			fused.Eval(mp_values);
+			unfused.Eval(mp_values);
+		}
+
+		auto f = fused.GetFuncVals<mpfr_complex>();
+		auto g = unfused.GetFuncVals<mpfr_complex>();
+		for (unsigned ii = 0; ii < num_functions; ++ii)
+			BOOST_CHECK(abs(f(ii) - g(ii)) < bertini::mpfr_float("1e-12"));
+
+		// the fused operations were actually used
+		auto profile = fused.GetProfile();
+		BOOST_CHECK(profile.Multiple[OpcodeIndex(Operation::FMA)].Count + profile.Multiple[OpcodeIndex(Operation::MulAddConst)].Count > 0);
+		BOOST_CHECK(profile.Multiple[OpcodeIndex(Operation::Square)].Count + profile.Multiple[OpcodeIndex(Operation::ScaleByInt)].Count + profile.Multiple[OpcodeIndex(Operation::MulAddConst)].Count > 0);
+
+		// automatic differentiation comes first, on unfused instructions, and only then are its derivatives fused too
+		compiler.SetJacobianMethod(bertini::JacobianMethod::Automatic);
+		auto differentiated_unfused = compiler.Compile(sys);
+		compiler.SetFuseInstructions(true);
+		auto differentiated_fused = compiler.Compile(sys);
+
+		differentiated_unfused.SetProfiling(true);
+		differentiated_fused.SetProfiling(true);
+		if (sys.HavePathVariable()){
+			differentiated_unfused.Eval(values, t);
+			differentiated_fused.Eval(values, t);
+		}
+		else{
+			differentiated_unfused.Eval(values);
+			differentiated_fused.Eval(values);
+		}
+
+		auto unfused_profile = differentiated_unfused.GetProfile();
+		for (auto op : {Operation::FMA, Operation::Square, Operation::ScaleByInt, Operation::MulAddConst})
+			BOOST_CHECK_EQUAL(unfused_profile.Double[OpcodeIndex(op)].Count, 0);
+
+		auto fused_profile = differentiated_fused.GetProfile();
+		BOOST_CHECK(fused_profile.Double[OpcodeIndex(Operation::FMA)].Count + fused_profile.Double[OpcodeIndex(Operation::MulAddConst)].Count > 0);
+
+		for (unsigned ii = 0; ii < num_functions; ++ii)
+			for (unsigned jj = 0; jj < num_variables; ++jj)
+				BOOST_CHECK_SMALL(abs(differentiated_fused.GetJacobian<dbl>()(ii,jj) - differentiated_unfused.GetJacobian<dbl>()(ii,jj)), 1e-12);
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE(multiple_precision_evaluation_doesnt_allocate)
+{
+	using mpfr_complex = bertini::mpfr_complex;
+
+	// the linear system only has sums, differences, copies and products with integers, which MPC does without any scratch space.  MPC allocates scratch space of its own for the others, like products, but frees it before returning.
+	struct Case{
+		bertini::System sys;
+		bool expect_no_gmp_allocations;
+	};
+
+	for (auto& c : std::vector<Case>{{LinearTestSystem(), true}, {ManyTemporariesTestSystem(), false}})
+	{
+		auto& sys = c.sys;
+		SLP slp(sys);
+
+		Vec<mpfr_complex> values(sys.NumVariables());
+		for (unsigned jj = 0; jj < sys.NumVariables(); ++jj)
+			values(jj) = mpfr_complex("0.5","0.2") + mpfr_complex(jj);
+		mpfr_complex t("0.3","0.1");
+
+		auto Evaluate = [&](){
+			if (sys.HavePathVariable())
+				slp.Eval(values, t);
+			else
+				slp.Eval(values);
+		};
+
+		// once, so that MPFR's caches of constants, like pi, are made
+		Evaluate();
+		auto f = slp.GetFuncVals<mpfr_complex>();
+
+		AllocationCounts counts;
+		{
+			CountAllocations counting;
+			for (unsigned ii = 0; ii < 10; ++ii)
+				Evaluate();
+			counts = allocation_counts;
+		}
+
+		BOOST_CHECK_EQUAL(counts.Cxx, 0);
+		BOOST_CHECK_EQUAL(counts.GMPReallocations, 0);
+		BOOST_CHECK_EQUAL(counts.GMPAllocations, counts.GMPFrees);
+		if (c.expect_no_gmp_allocations)
+			BOOST_CHECK_EQUAL(counts.GMPAllocations, 0);
+
+		// and it's still right
+		auto g = slp.GetFuncVals<mpfr_complex>();
+		for (unsigned ii = 0; ii < sys.NumNaturalFunctions(); ++ii)
+			BOOST_CHECK(abs(f(ii) - g(ii)) < bertini::mpfr_float("1e-20"));
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE(jacobian_nodes_agree_with_derivatives)
+{
+	auto sys = ManyTemporariesTestSystem();
+
+	Vec<dbl> values(3);
+	values(0) = dbl(0.5, 0.2); // x
+	values(1) = dbl(-0.1, 1.3); // y
+	values(2) = dbl(0.7, -0.4); // z
+	dbl t(0.3, 0.1);
+
+	sys.SetEvalMethod(bertini::EvalMethod::FunctionTree);
+	Mat<dbl> J_tree = sys.Jacobian(values, t);
+	Vec<dbl> dt_tree = sys.TimeDerivative(values, t);
+
+	sys.SetDerivMethod(bertini::DerivMethod::JacobianNode);
+	sys.SetEvalMethod(bertini::EvalMethod::SLP);
+	Mat<dbl> J = sys.Jacobian(values, t);
+	Vec<dbl> dt = sys.TimeDerivative(values, t);
+
+	for (int ii = 0; ii < 3; ++ii){
+		BOOST_CHECK_SMALL(abs(dt(ii) - dt_tree(ii)), 1e-13);
+		for (int jj = 0; jj < 3; ++jj)
+			BOOST_CHECK_SMALL(abs(J(ii,jj) - J_tree(ii,jj)), 1e-13);
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE(linear_product_start_system_agrees_with_function_tree)
+{
+	// a multihomogeneous start system is made of LinearProduct nodes, whose derivatives have DiffLinear nodes
+	auto x1 = Variable::Make("x1");
+	auto x2 = Variable::Make("x2");
+	auto x3 = Variable::Make("x3");
+	auto x4 = Variable::Make("x4");
+
+	bertini::System target;
+	target.AddVariableGroup(bertini::VariableGroup{x1,x2});
+	target.AddVariableGroup(bertini::VariableGroup{x3,x4});
+	target.AddFunction(pow(x1,2) + x4);
+	target.AddFunction(x1*x2*x3);
+	target.AddFunction(pow(x4,2) - x2);
+	target.AddFunction(pow(x3,2) + x1*x4);
+	target.Homogenize();
+	target.AutoPatch();
+
+	bertini::System start = bertini::start_system::MHomogeneous(target);
+
+	const auto num_variables = start.NumVariables();
+	Vec<dbl> values(num_variables);
+	for (unsigned jj = 0; jj < num_variables; ++jj)
+		values(jj) = dbl(0.3 + 0.1*jj, -0.2 + 0.15*jj);
+
+	// the function tree can only differentiate linear products with Jacobian nodes
+	start.SetDerivMethod(bertini::DerivMethod::JacobianNode);
+	start.SetEvalMethod(bertini::EvalMethod::FunctionTree);
+	Vec<dbl> f_tree = start.Eval(values);
+	Mat<dbl> J_tree = start.Jacobian(values);
+
+	for (auto deriv_method : {bertini::DerivMethod::JacobianNode, bertini::DerivMethod::Derivatives})
+	{
+		auto sys = start;
+		sys.SetDerivMethod(deriv_method);
+		sys.SetEvalMethod(bertini::EvalMethod::SLP);
+
+		Vec<dbl> f = sys.Eval(values);
+		Mat<dbl> J = sys.Jacobian(values);
+
+		BOOST_CHECK_EQUAL(J.rows(), J_tree.rows());
+		BOOST_CHECK_EQUAL(J.cols(), J_tree.cols());
+		for (int ii = 0; ii < f.size(); ++ii){
+			BOOST_CHECK_SMALL(abs(f(ii) - f_tree(ii)), 1e-12);
+			for (int jj = 0; jj < J.cols(); ++jj)
+				BOOST_CHECK_SMALL(abs(J(ii,jj) - J_tree(ii,jj)), 1e-12);
+		}
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE(simd_kernels_agree_with_scalar)
+{
+	using namespace bertini::slp_kernels;
+
+	const size_t n = 37; // not a multiple of any vector width, so the leftovers get done too
+	std::vector<double> a_re(n), a_im(n), b_re(n), b_im(n);
+	for (size_t p = 0; p < n; ++p){
+		a_re[p] = 0.3 + 0.1*p;  a_im[p] = -1.1 + 0.07*p;
+		b_re[p] = -0.8 + 0.05*p; b_im[p] = 0.4 - 0.03*p;
+	}
+
+	auto const& scalar = Kernels(SIMDLevel::Scalar);
+
+	for (auto level : {SIMDLevel::AVX2, SIMDLevel::AVX512}){
+		if (!Supported(level))
+			continue;
+
+		auto const& simd = Kernels(level);
+		std::vector<double> expected_re(n), expected_im(n), result_re(n), result_im(n), z_re(n), z_im(n);
+
+		for (auto kernels : {std::make_pair(scalar.Add, simd.Add), std::make_pair(scalar.Subtract, simd.Subtract), std::make_pair(scalar.Multiply, simd.Multiply), std::make_pair(scalar.Divide, simd.Divide)}){
+			kernels.first(expected_re.data(), expected_im.data(), a_re.data(), a_im.data(), b_re.data(), b_im.data(), n);
+			kernels.second(result_re.data(), result_im.data(), a_re.data(), a_im.data(), b_re.data(), b_im.data(), n);
+			BOOST_CHECK(expected_re==result_re);
+			BOOST_CHECK(expected_im==result_im);
+		}
+
+		scalar.Negate(expected_re.data(), expected_im.data(), a_re.data(), a_im.data(), n);
+		simd.Negate(result_re.data(), result_im.data(), a_re.data(), a_im.data(), n);
+		BOOST_CHECK(expected_re==result_re);
+		BOOST_CHECK(expected_im==result_im);
+
+		for (int exponent : {-3, 0, 1, 2, 7}){
+			scalar.IntPower(expected_re.data(), expected_im.data(), a_re.data(), a_im.data(), z_re.data(), z_im.data(), exponent, n);
+			simd.IntPower(result_re.data(), result_im.data(), a_re.data(), a_im.data(), z_re.data(), z_im.data(), exponent, n);
+			BOOST_CHECK(expected_re==result_re);
+			BOOST_CHECK(expected_im==result_im);
+		}
+	}
+
+	// and the scalar IntPower is really a power
+	std::vector<double> re(1), im(1), z_re(1), z_im(1);
+	scalar.IntPower(re.data(), im.data(), a_re.data(), a_im.data(), z_re.data(), z_im.data(), 5, 1);
+	dbl a(a_re[0], a_im[0]);
+	BOOST_CHECK_SMALL(abs(dbl(re[0], im[0]) - a*a*a*a*a), 1e-14);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(generated_cpp_has_every_block)
+{
+	auto sys = ManyTemporariesTestSystem();
+	auto slp = SLP(sys);
+
+	std::stringstream double_only, both;
+	slp.GenerateCpp(double_only);
+	slp.GenerateCpp(both, true);
+
+	BOOST_CHECK(double_only.str().find(slp.Fingerprint()) != std::string::npos);
+	for (size_t block = 0; block < 4; ++block){
+		BOOST_CHECK(double_only.str().find(bertini::slp_codegen::BlockSymbol(false, block)) != std::string::npos);
+		BOOST_CHECK(double_only.str().find(bertini::slp_codegen::BlockSymbol(true, block)) == std::string::npos);
+		BOOST_CHECK(both.str().find(bertini::slp_codegen::BlockSymbol(true, block)) != std::string::npos);
+	}
+
+	// a different program has a different fingerprint
+	BOOST_CHECK(slp.Fingerprint() != SLP(PathVariableTestSystem()).Fingerprint());
+
+	BOOST_CHECK_THROW(slp.LoadNativeEvaluator("this_library_does_not_exist.so"), std::runtime_error);
+	BOOST_CHECK(!slp.HasNativeEvaluator());
+}
+
+
+
+#ifdef B2_TEST_CXX_COMPILER
+BOOST_AUTO_TEST_CASE(native_slp_agrees_with_interpreted)
+{
+	auto sys = ManyTemporariesTestSystem();
+	sys.SetEvalMethod(bertini::EvalMethod::NativeSLP);
+
+	auto dir = boost::filesystem::temp_directory_path();
+	auto source = (dir / "b2_native_slp_test.cpp").string();
+	auto library = (dir / "b2_native_slp_test.so").string();
+	{
+		std::ofstream out(source);
+		sys.GenerateNativeSLPSource(out);
+	}
+
+	auto log = (dir / "b2_native_slp_test.log").string();
+
+	// the compiler is the one that built the tests, so the generated source failing to compile is a failure of the code generator
+	std::string command = std::string(B2_TEST_CXX_COMPILER) + " -std=c++17 -O2 -fPIC -shared -I" + B2_TEST_INCLUDE_DIR + " " + source + " -o " + library + " > " + log + " 2>&1";
+	if (std::system(command.c_str()) != 0){
+		std::ifstream in(log);
+		std::stringstream output;
+		output << in.rdbuf();
+		BOOST_FAIL("couldn't compile the generated straight-line program with\n" << command << "\n" << output.str());
+	}
+	boost::filesystem::remove(log);
+
+	Vec<dbl> values(3);
+	values(0) = dbl(0.5, 0.2); // x
+	values(1) = dbl(-0.1, 1.3); // y
+	values(2) = dbl(0.7, -0.4); // z
+	dbl t(0.3, 0.1);
+
+	auto interpreted = sys;
+	interpreted.SetEvalMethod(bertini::EvalMethod::SLP);
+
+	sys.SetNativeSLPLibrary(library);
+	BOOST_CHECK_EQUAL(sys.GetNativeSLPLibrary(), library);
+	BOOST_REQUIRE(sys.HasNativeSLPEvaluator());
+	BOOST_REQUIRE(!interpreted.HasNativeSLPEvaluator());
+
+	Vec<dbl> f = sys.Eval(values, t), f_interpreted = interpreted.Eval(values, t);
+	Mat<dbl> J = sys.Jacobian(values, t), J_interpreted = interpreted.Jacobian(values, t);
+	Vec<dbl> dt = sys.TimeDerivative(values, t), dt_interpreted = interpreted.TimeDerivative(values, t);
+
+	// same operations in the same order, but the compiler may contract some into fused multiply-adds
+	for (int ii = 0; ii < 3; ++ii){
+		BOOST_CHECK_SMALL(abs(f(ii) - f_interpreted(ii)), 1e-13);
+		BOOST_CHECK_SMALL(abs(dt(ii) - dt_interpreted(ii)), 1e-13);
+		for (int jj = 0; jj < 3; ++jj)
+			BOOST_CHECK_SMALL(abs(J(ii,jj) - J_interpreted(ii,jj)), 1e-13);
+	}
+
+	boost::filesystem::remove(source);
+	boost::filesystem::remove(library);
+}
+#endif
+
+
+
 BOOST_AUTO_TEST_SUITE_END()
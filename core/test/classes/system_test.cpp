@@ -222,6 +222,56 @@ BOOST_AUTO_TEST_CASE(system_differentiate_x_and_y)
 }
 
 
+/**
+\class bertini::System
+\test \b system_interned_nodes_evaluate_the_same Intern the nodes of a system with repeated subexpressions, and check that the functions and Jacobian are unchanged, using both kinds of derivatives.
+*/
+BOOST_AUTO_TEST_CASE(system_interned_nodes_evaluate_the_same)
+{
+	Var x = Variable::Make("x");
+	Var y = Variable::Make("y");
+
+	// x*y+1 is made twice, as separate nodes
+	auto make_system = [&](bertini::System & S){
+		S.AddUngroupedVariable(x);
+		S.AddUngroupedVariable(y);
+		S.AddFunction(pow(x*y+1,2)*y);
+		S.AddFunction(exp(x*y+1)-y);
+		S.SetEvalMethod(EvalMethod::FunctionTree);
+	};
+
+	Vec<dbl> v(2);
+	v << dbl(0.3,0.1) , dbl(-0.7,0.2);
+
+	for (auto method : {DerivMethod::JacobianNode, DerivMethod::Derivatives})
+	{
+		bertini::System plain, interned;
+		make_system(plain);
+		plain.SetDerivMethod(method);
+
+		make_system(interned);
+		interned.SetDerivMethod(method);
+		interned.SetInternNodes(true);
+		BOOST_CHECK(interned.InternNodes() > 0);
+
+		Vec<dbl> f_plain = plain.Eval(v);
+		Vec<dbl> f_interned = interned.Eval(v);
+		Mat<dbl> J_plain = plain.Jacobian(v);
+		Mat<dbl> J_interned = interned.Jacobian(v);
+
+		for (int ii=0; ii<2; ++ii)
+		{
+			BOOST_CHECK(abs(f_plain(ii)-f_interned(ii)) < threshold_clearance_d);
+			for (int jj=0; jj<2; ++jj)
+				BOOST_CHECK(abs(J_plain(ii,jj)-J_interned(ii,jj)) < threshold_clearance_d);
+		}
+
+		// the derivatives were interned along with the functions, so everything is already shared
+		BOOST_CHECK_EQUAL(interned.InternNodes(), 0);
+	}
+}
+
+
 /**
 \class bertini::System
 \test \b system_differentiate_x_and_t Create a system with two functions, one variable, one time variable, and check that can compute and evaluate its Jacobian.
@@ -248,6 +298,123 @@ BOOST_AUTO_TEST_CASE(system_differentiate_x_and_t)
 }
 
 
+/**
+\class bertini::System
+\test \b system_parallel_differentiation_is_deterministic Differentiate a system with one thread and with several, and check the derivatives are the same expressions, in the same places.
+*/
+BOOST_AUTO_TEST_CASE(system_parallel_differentiation_is_deterministic)
+{
+	Var x = Variable::Make("x");
+	Var y = Variable::Make("y");
+	Var z = Variable::Make("z");
+	Var t = Variable::Make("t");
+
+	auto make_system = [&](bertini::System & S, unsigned num_threads){
+		S.AddUngroupedVariable(x);
+		S.AddUngroupedVariable(y);
+		S.AddUngroupedVariable(z);
+		S.AddPathVariable(t);
+		for (int ii=0; ii<20; ++ii)
+			S.AddFunction(pow(x,ii%4+1)*y - (ii+1)*sin(z*t) + exp(x*y*z)/(ii+2));
+		S.SetEvalMethod(EvalMethod::FunctionTree);
+		S.SetDerivMethod(DerivMethod::Derivatives);
+		S.SetNumDifferentiationThreads(num_threads);
+	};
+
+	bertini::System serial, parallel;
+	make_system(serial, 1);
+	make_system(parallel, 4);
+	serial.Differentiate();
+	parallel.Differentiate();
+
+	auto as_strings = [](std::vector<std::shared_ptr<bertini::node::Node>> const& derivatives){
+		std::vector<std::string> strings;
+		for (auto const& d : derivatives)
+		{
+			std::stringstream ss;
+			ss << *d;
+			strings.push_back(ss.str());
+		}
+		return strings;
+	};
+
+	auto serial_dx = as_strings(serial.GetSpaceDerivatives());
+	auto parallel_dx = as_strings(parallel.GetSpaceDerivatives());
+	BOOST_CHECK_EQUAL(serial_dx.size(), 60);
+	BOOST_CHECK_EQUAL_COLLECTIONS(serial_dx.begin(), serial_dx.end(), parallel_dx.begin(), parallel_dx.end());
+
+	auto serial_dt = as_strings(serial.GetTimeDerivatives());
+	auto parallel_dt = as_strings(parallel.GetTimeDerivatives());
+	BOOST_CHECK_EQUAL(serial_dt.size(), 20);
+	BOOST_CHECK_EQUAL_COLLECTIONS(serial_dt.begin(), serial_dt.end(), parallel_dt.begin(), parallel_dt.end());
+}
+
+
+/**
+\class bertini::System
+\test \b system_flat_tree_evaluates_the_same Evaluate a system with EvalMethod::FlatTree, and compare its functions, Jacobian and time derivatives against EvalMethod::FunctionTree, in both number types.
+*/
+BOOST_AUTO_TEST_CASE(system_flat_tree_evaluates_the_same)
+{
+	Var x = Variable::Make("x");
+	Var y = Variable::Make("y");
+	Var t = Variable::Make("t");
+
+	auto make_system = [&](bertini::System & S, EvalMethod method){
+		S.AddUngroupedVariable(x);
+		S.AddUngroupedVariable(y);
+		S.AddPathVariable(t);
+		S.AddFunction((1-t)*pow(x*y+1,2) - t*sin(x)/y);
+		S.AddFunction(exp(x*y+1)*sqrt(y) - pow(x,y) + t);
+		S.SetEvalMethod(method);
+	};
+
+	for (auto deriv_method : {DerivMethod::JacobianNode, DerivMethod::Derivatives})
+	{
+		bertini::System tree, flat;
+		make_system(tree, EvalMethod::FunctionTree);
+		tree.SetDerivMethod(deriv_method);
+		make_system(flat, EvalMethod::FlatTree);
+		flat.SetDerivMethod(deriv_method);
+
+		Vec<dbl> v(2);
+		v << dbl(0.3,0.1) , dbl(-0.7,0.2);
+		dbl time(0.5,0.2);
+
+		Vec<dbl> f_tree = tree.Eval(v,time), f_flat = flat.Eval(v,time);
+		Mat<dbl> J_tree = tree.Jacobian(v,time), J_flat = flat.Jacobian(v,time);
+		Vec<dbl> dt_tree = tree.TimeDerivative(v,time), dt_flat = flat.TimeDerivative(v,time);
+
+		for (int ii=0; ii<2; ++ii)
+		{
+			BOOST_CHECK(abs(f_tree(ii)-f_flat(ii)) < threshold_clearance_d);
+			BOOST_CHECK(abs(dt_tree(ii)-dt_flat(ii)) < threshold_clearance_d);
+			for (int jj=0; jj<2; ++jj)
+				BOOST_CHECK(abs(J_tree(ii,jj)-J_flat(ii,jj)) < threshold_clearance_d);
+		}
+
+		// new values of the inputs are seen by the flat tree
+		Vec<mpfr> v_mp(2);
+		v_mp << mpfr("0.4","-0.3") , mpfr("1.1","0.5");
+		mpfr time_mp("0.25","0.1");
+
+		Vec<mpfr> f_tree_mp = tree.Eval(v_mp,time_mp), f_flat_mp = flat.Eval(v_mp,time_mp);
+		Mat<mpfr> J_tree_mp = tree.Jacobian(v_mp,time_mp), J_flat_mp = flat.Jacobian(v_mp,time_mp);
+
+		for (int ii=0; ii<2; ++ii)
+		{
+			BOOST_CHECK(abs(f_tree_mp(ii)-f_flat_mp(ii)) < threshold_clearance_mp);
+			for (int jj=0; jj<2; ++jj)
+				BOOST_CHECK(abs(J_tree_mp(ii,jj)-J_flat_mp(ii,jj)) < threshold_clearance_mp);
+		}
+
+		// the derivatives flattened are the ones kept, whatever the method of differentiation, so getting them doesn't differentiate again
+		BOOST_CHECK(flat.GetSpaceDerivatives()[0]==flat.GetSpaceDerivatives()[0]);
+		BOOST_CHECK(flat.GetTimeDerivatives()[0]==flat.GetTimeDerivatives()[0]);
+	}
+}
+
+
 
 
 /**
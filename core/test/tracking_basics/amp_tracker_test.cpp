@@ -239,6 +239,130 @@ BOOST_AUTO_TEST_CASE(AMP_tracker_track_decic)
 
 
 
+BOOST_AUTO_TEST_CASE(AMP_tracker_track_decic_with_measured_evaluation_error)
+{
+	DefaultPrecision(30);
+	using namespace bertini::tracking;
+
+	Var y = Variable::Make("y");
+	Var t = Variable::Make("t");
+
+	System sys;
+
+	VariableGroup v{y};
+
+	sys.AddFunction(y-pow(t,10));
+	sys.AddPathVariable(t);
+	sys.AddVariableGroup(v);
+	sys.SetEvalMethod(bertini::EvalMethod::SLP);
+
+	auto AMP = bertini::tracking::AMPConfigFrom(sys);
+	AMP.use_evaluation_error_bounds = true;
+
+	bertini::tracking::AMPTracker tracker(sys);
+
+
+	SteppingConfig stepping_preferences;
+	NewtonConfig newton_preferences;
+
+
+	tracker.Setup(Predictor::Euler,
+	              	1e-5,
+					1e5,
+					stepping_preferences,
+					newton_preferences);
+
+	tracker.PrecisionSetup(AMP);
+
+	mpfr t_start(1);
+	mpfr t_end(-2);
+	
+	Vec<mpfr> y_start(1);
+	y_start << mpfr(1);
+
+	Vec<mpfr> y_end;
+
+	auto code = tracker.TrackPath(y_end,
+	                  t_start, t_end, y_start);
+
+	BOOST_CHECK(code==SuccessCode::Success);
+	BOOST_CHECK_EQUAL(y_end.size(),1);
+	BOOST_CHECK(abs(y_end(0)-mpfr("1024.0")) < 1e-5);
+
+	// the criteria were checked against the Phi measured at the last point, not the configured one, and the Psi too
+	BOOST_CHECK(tracker.CriteriaConfig().Phi < AMP.Phi);
+	BOOST_CHECK(tracker.CriteriaConfig().Psi != AMP.Psi);
+
+	// the Jacobian is exact, so its measured error is far below the bound made from the degree and coefficients
+	Vec<dbl> y_dbl(1);
+	y_dbl << dbl(1.5);
+	auto bounds = sys.EvalErrorBounds(y_dbl, dbl(1.2));
+	BOOST_CHECK(bounds.Jacobian*1e16 < AMP.Phi);
+	BOOST_CHECK(bounds.Trustworthy(1e-10));
+}
+
+
+// a system without a straight line program can't measure its error, so the tracker keeps the configured Phi and Psi
+BOOST_AUTO_TEST_CASE(AMP_tracker_track_decic_with_measured_evaluation_error_flat_tree)
+{
+	DefaultPrecision(30);
+	using namespace bertini::tracking;
+
+	Var y = Variable::Make("y");
+	Var t = Variable::Make("t");
+
+	System sys;
+
+	VariableGroup v{y};
+
+	sys.AddFunction(y-pow(t,10));
+	sys.AddPathVariable(t);
+	sys.AddVariableGroup(v);
+	sys.SetEvalMethod(bertini::EvalMethod::FlatTree);
+
+	BOOST_CHECK(!sys.CanEvalErrorBounds());
+
+	auto AMP = bertini::tracking::AMPConfigFrom(sys);
+	AMP.use_evaluation_error_bounds = true;
+
+	bertini::tracking::AMPTracker tracker(sys);
+
+
+	SteppingConfig stepping_preferences;
+	NewtonConfig newton_preferences;
+
+
+	tracker.Setup(Predictor::Euler,
+	              	1e-5,
+					1e5,
+					stepping_preferences,
+					newton_preferences);
+
+	tracker.PrecisionSetup(AMP);
+
+	mpfr t_start(1);
+	mpfr t_end(-2);
+
+	Vec<mpfr> y_start(1);
+	y_start << mpfr(1);
+
+	Vec<mpfr> y_end;
+
+	SuccessCode code;
+	BOOST_CHECK_NO_THROW(code = tracker.TrackPath(y_end,
+	                  t_start, t_end, y_start));
+
+	BOOST_CHECK(code==SuccessCode::Success);
+	BOOST_CHECK_EQUAL(y_end.size(),1);
+	BOOST_CHECK(abs(y_end(0)-mpfr("1024.0")) < 1e-5);
+
+	BOOST_CHECK_EQUAL(tracker.CriteriaConfig().Phi, AMP.Phi);
+	BOOST_CHECK_EQUAL(tracker.CriteriaConfig().Psi, AMP.Psi);
+}
+
+
+
+
 BOOST_AUTO_TEST_CASE(AMP_tracker_track_square_root)
 {
 	DefaultPrecision(30);
@@ -267,6 +267,7 @@ namespace bertini{
 					.def_readwrite("maximum_precision", &AdaptiveMultiplePrecisionConfig::maximum_precision)
 					.def_readwrite("consecutive_successful_steps_before_precision_decrease", &AdaptiveMultiplePrecisionConfig::consecutive_successful_steps_before_precision_decrease)
 					.def_readwrite("max_num_precision_decreases", &AdaptiveMultiplePrecisionConfig::max_num_precision_decreases)
+					.def_readwrite("use_evaluation_error_bounds", &AdaptiveMultiplePrecisionConfig::use_evaluation_error_bounds)
 					.def_readwrite("coefficient_bound", &AdaptiveMultiplePrecisionConfig::coefficient_bound)
 					;
 				